@@ -8,20 +8,33 @@ layout(location = 0) out vec3 fragWorlPos;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragUV;
 
-layout(set = 0, binding = 0) uniform UboTransform {
-    mat4 mvp;
-    mat4 invTransform;
-} uboTransform;
+layout(set = 0, binding = 0) uniform UboCamera {
+    mat4 viewProj;
+} uboCamera;
 
-layout(set = 0, binding = 1) uniform UboNode {
-    mat4 matrix;
-} uboNode;
+// Entity world matrix relative to the camera times node matrix, one per instance of each draw
+struct Instance {
+    mat4 model;
+    mat4 invModel;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Instances {
+    Instance instances[];
+};
+
+// Added to gl_InstanceIndex. Zero when the draws carry the instance base in firstInstance, devices without
+// drawIndirectFirstInstance get it here with firstInstance 0. Placed after the fragment stage material block.
+layout(push_constant) uniform Draw {
+    layout(offset = 32) uint instanceBase;
+} draw;
 
 
 void main() {
-    vec4 locPos = uboTransform.mvp * uboNode.matrix * vec4(position, 1.0);
+    Instance instance = instances[draw.instanceBase + gl_InstanceIndex];
+
+    vec4 locPos = uboCamera.viewProj * instance.model * vec4(position, 1.0);
     gl_Position = locPos;
     fragWorlPos = locPos.xyz / locPos.w;
-    fragNormal = mat3(transpose(uboTransform.invTransform)) * normal;
+    fragNormal = mat3(transpose(instance.invModel)) * normal;
     fragUV = uv;
 }
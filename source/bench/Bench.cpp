@@ -0,0 +1,101 @@
+#include "Bench.hpp"
+
+#include "fmt/format.h"
+
+#include "engine/external/Json.hpp"
+#include "engine/files/File.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+#include "engine/math/Simd.hpp"
+
+
+namespace re::bench {
+
+    /**
+     *
+     * @param filter Only benchmarks whose name starts with it are run, empty runs all
+     * @param minTime Minimum duration of a sample in seconds
+     */
+    Runner::Runner(std::string filter, double minTime) : filter(std::move(filter)), minTime(minTime) {
+        jobs::JobSystem::singleton = new jobs::JobSystem();
+
+        fmt::print("{:<56} {:>12} {:>14} {:>12}\n", "Benchmark", "ns/item", "items/s", "iterations");
+    }
+
+    Runner::~Runner() {
+        delete jobs::JobSystem::singleton;
+        jobs::JobSystem::singleton = nullptr;
+    }
+
+    /**
+     * @brief Record a correctness check. Checks always run, a failed one makes the bench exit with an error.
+     */
+    void Runner::check(const std::string& name, bool passed, const std::string& detail) {
+        checks.push_back({name, passed, detail});
+
+        if (!passed) fmt::print("FAILED {}: {}\n", name, detail);
+    }
+
+    bool Runner::enabled(const std::string& name) const {
+        return name.starts_with(filter);
+    }
+
+    /**
+     *
+     * @param group Name prefix shared by several benchmarks, used to skip their setup
+     * @return True if any benchmark of the group can match the filter
+     */
+    bool Runner::enabledGroup(const std::string& group) const {
+        return group.starts_with(filter) || filter.starts_with(group);
+    }
+
+    bool Runner::failed() const {
+        return std::any_of(checks.begin(), checks.end(), [](const Check& check) { return !check.passed; });
+    }
+
+    /**
+     * @brief Write results and checks as JSON, meant to be stored per commit and compared between runs
+     */
+    void Runner::writeJson(const std::filesystem::path& file) const {
+        json output;
+
+#if defined(RE_SIMD_FMA)
+        output["simd"] = "AVX2";
+#elif defined(RE_SIMD_SSE4)
+        output["simd"] = "SSE4.1";
+#else
+        output["simd"] = "scalar";
+#endif
+        output["threads"] = jobs::JobSystem::getInstance()->getThreadCount() + 1;
+
+        auto& jsonResults = output["results"] = json::array();
+        for (auto& result : results) {
+            jsonResults.push_back({
+                {"name", result.name},
+                {"iterations", result.iterations},
+                {"items", result.items},
+                {"nsPerItem", result.nsPerItem},
+                {"itemsPerSecond", result.itemsPerSecond}
+            });
+        }
+
+        auto& jsonChecks = output["checks"] = json::array();
+        for (auto& check : checks) {
+            jsonChecks.push_back({
+                {"name", check.name},
+                {"passed", check.passed},
+                {"detail", check.detail}
+            });
+        }
+
+        File(file).write(output);
+    }
+
+    void Runner::addResult(const std::string& name, uint64_t iterations, uint64_t items, double seconds) {
+        double count = static_cast<double>(iterations) * static_cast<double>(items);
+        Result result{name, iterations, items, seconds * 1e9 / count, count / seconds};
+
+        fmt::print("{:<56} {:>12.2f} {:>14.0f} {:>12}\n", result.name, result.nsPerItem, result.itemsPerSecond, result.iterations);
+        results.push_back(std::move(result));
+    }
+
+} // namespace re::bench
@@ -0,0 +1,133 @@
+#ifndef RAVENENGINE_BENCH_HPP
+#define RAVENENGINE_BENCH_HPP
+
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+
+#include "engine/core/NonCopyable.hpp"
+
+
+namespace re::bench {
+
+    /**
+     * @brief Keep the compiler from removing the computation of value
+     */
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+        (void)*sink;
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        // Times the function was called per sample
+        uint64_t iterations;
+        // Items processed by each call, ns and throughput are per item
+        uint64_t items;
+        double nsPerItem;
+        double itemsPerSecond;
+    };
+
+    struct Check {
+        std::string name;
+        bool passed;
+        std::string detail;
+    };
+
+    /**
+     * @brief Microbenchmark runner. Each benchmark is calibrated until a sample takes at least the minimum time,
+     * then the median of several samples is reported. It owns the JobSystem used by the engine systems.
+     */
+    class Runner : NonCopyable {
+    public:
+        Runner(std::string filter, double minTime);
+
+        ~Runner() override;
+
+        template<typename Function>
+        void run(const std::string& name, uint64_t items, Function&& function);
+
+        void check(const std::string& name, bool passed, const std::string& detail = "");
+
+        [[nodiscard]] bool enabled(const std::string& name) const;
+
+        [[nodiscard]] bool enabledGroup(const std::string& group) const;
+
+        [[nodiscard]] bool failed() const;
+
+        void writeJson(const std::filesystem::path& file) const;
+
+    public:
+        static constexpr uint32_t SAMPLE_COUNT = 5;
+        static constexpr uint64_t MAX_ITERATIONS = 1ull << 30;
+
+    private:
+        template<typename Function>
+        static double measure(uint64_t iterations, Function& function);
+
+        void addResult(const std::string& name, uint64_t iterations, uint64_t items, double seconds);
+
+    private:
+        std::string filter;
+        double minTime;
+        std::vector<Result> results;
+        std::vector<Check> checks;
+    };
+
+    /**
+     *
+     * @param name Benchmark name, "group/case"
+     * @param items Items processed by one call of function
+     * @param function Benchmark body, called without arguments
+     */
+    template<typename Function>
+    void Runner::run(const std::string& name, uint64_t items, Function&& function) {
+        if (!enabled(name)) return;
+
+        // Warm up caches and grow the iterations until a sample is long enough to time
+        uint64_t iterations = 1;
+        double seconds = measure(iterations, function);
+        while (seconds < minTime && iterations < MAX_ITERATIONS) {
+            double scale = seconds > 0.0 ? std::clamp(1.2 * minTime / seconds, 2.0, 100.0) : 100.0;
+            iterations = std::min(static_cast<uint64_t>(static_cast<double>(iterations) * scale), MAX_ITERATIONS);
+            seconds = measure(iterations, function);
+        }
+
+        std::vector<double> samples(SAMPLE_COUNT);
+        for (auto& sample : samples)
+            sample = measure(iterations, function);
+
+        std::nth_element(samples.begin(), samples.begin() + SAMPLE_COUNT / 2, samples.end());
+        addResult(name, iterations, items, samples[SAMPLE_COUNT / 2]);
+    }
+
+    template<typename Function>
+    double Runner::measure(uint64_t iterations, Function& function) {
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint64_t i = 0; i < iterations; ++i)
+            function();
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void mathBenchmarks(Runner& runner);
+
+    void sceneBenchmarks(Runner& runner);
+
+    void renderBenchmarks(Runner& runner);
+
+    void recordBenchmarks(Runner& runner);
+
+} // namespace re::bench
+
+
+#endif //RAVENENGINE_BENCH_HPP
@@ -0,0 +1,695 @@
+#include "Bench.hpp"
+
+#include <random>
+#include <cmath>
+
+#include "fmt/format.h"
+#include "entt/entt.hpp"
+
+#include "engine/math/Matrix4.hpp"
+#include "engine/math/Basis.hpp"
+#include "engine/math/Quaternion.hpp"
+#include "engine/math/Frustum.hpp"
+#include "engine/math/Batch.hpp"
+#include "engine/math/FastMath.hpp"
+#include "engine/math/Math.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/scene/TransformSystem.hpp"
+
+
+namespace re::bench {
+
+    namespace {
+
+        // Inputs per call, small enough to stay in cache so the math is measured and not the memory
+        constexpr uint32_t BATCH_SIZE = 1024;
+
+        constexpr uint32_t TRANSFORM_ROOTS = 1000;
+        constexpr uint32_t TRANSFORM_CHILDREN = 9;
+
+        // Max absolute error allowed against the double precision reference
+        constexpr double TOLERANCE = 1e-4;
+        // Rotation pairs checked against the documented fastSlerp and nlerp errors
+        constexpr uint32_t SLERP_SAMPLES = 1 << 20;
+
+        // Orthographic projection of the box [-0.5, 0.5] x [-0.5, 0.5] x [-1, 1] the batch spheres are culled against
+        constexpr Matrix4 CULL_PROJECTION({2.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.5f, 0.0f}, {0.0f, 0.0f, 0.5f, 1.0f});
+
+        struct Inputs {
+            std::vector<Matrix4> matrices;
+            std::vector<Matrix4> others;
+            std::vector<Quaternion> rotations;
+            std::vector<Quaternion> targets;
+            std::vector<Vector3> angles;
+            std::vector<Vector3> scales;
+            std::vector<Vector4> vectors;
+            // compose(angles, rotations, scales)
+            std::vector<Matrix4> transforms;
+        };
+
+        Inputs makeInputs(uint32_t count) {
+            std::mt19937 generator(42);
+            std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+            std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+            auto randomMatrix = [&] {
+                Matrix4 m;
+                for (int j = 0; j < 4; ++j)
+                    for (int i = 0; i < 4; ++i)
+                        m[j][i] = value(generator);
+
+                // Dominant diagonal keeps the matrices well conditioned for the inverse checks
+                for (int i = 0; i < 4; ++i)
+                    m[i][i] += 4.0f;
+
+                return m;
+            };
+
+            auto randomRotation = [&] {
+                return Quaternion(value(generator), value(generator), value(generator), value(generator)).normalized();
+            };
+
+            Inputs inputs;
+            for (uint32_t i = 0; i < count; ++i) {
+                inputs.matrices.push_back(randomMatrix());
+                inputs.others.push_back(randomMatrix());
+                inputs.rotations.push_back(randomRotation());
+                inputs.targets.push_back(randomRotation());
+                inputs.angles.emplace_back(angle(generator), angle(generator), angle(generator));
+                inputs.scales.emplace_back(scale(generator), scale(generator), scale(generator));
+                inputs.vectors.emplace_back(value(generator), value(generator), value(generator), value(generator));
+                inputs.transforms.push_back(Matrix4::compose(inputs.angles[i], inputs.rotations[i], inputs.scales[i]));
+            }
+
+            return inputs;
+        }
+
+        double maxError(const Matrix4& m, const double reference[4][4]) {
+            double error = 0.0;
+            for (int j = 0; j < 4; ++j)
+                for (int i = 0; i < 4; ++i)
+                    error = std::max(error, std::abs(static_cast<double>(m[j][i]) - reference[j][i]));
+
+            return error;
+        }
+
+        /**
+         * @brief Compare the math types, SIMD or scalar depending on the build, with plain double precision loops
+         */
+        void checkMath(Runner& runner, const Inputs& inputs) {
+            double multiplyError = 0.0, inverseError = 0.0, transposeError = 0.0;
+            double vectorError = 0.0, pointError = 0.0, quaternionError = 0.0;
+
+            for (uint32_t n = 0; n < BATCH_SIZE; ++n) {
+                const Matrix4& a = inputs.matrices[n];
+                const Matrix4& b = inputs.others[n];
+                const Vector4& v = inputs.vectors[n];
+
+                // Columns are stored, so (a * b)[j][i] = sum(a[k][i] * b[j][k])
+                double product[4][4], identity[4][4], transpose[4][4];
+                Matrix4 inverse = a.inverted();
+                for (int j = 0; j < 4; ++j) {
+                    for (int i = 0; i < 4; ++i) {
+                        product[j][i] = identity[j][i] = 0.0;
+                        for (int k = 0; k < 4; ++k) {
+                            product[j][i] += static_cast<double>(a[k][i]) * b[j][k];
+                            identity[j][i] += static_cast<double>(a[k][i]) * inverse[j][k];
+                        }
+
+                        transpose[j][i] = a[i][j];
+                    }
+                }
+
+                Matrix4 copy = a;
+                multiplyError = std::max(multiplyError, maxError(a * b, product));
+                transposeError = std::max(transposeError, maxError(copy.transposed(), transpose));
+
+                // a * inverse(a) - identity compared with zero
+                for (int i = 0; i < 4; ++i) identity[i][i] -= 1.0;
+                inverseError = std::max(inverseError, maxError(Matrix4(0.0f), identity));
+
+                // Matrix4 * Vector4 is the dot product of each stored vector with v
+                Vector4 result = a * v;
+                Vector4 point = a.transformPoint({v.x, v.y, v.z});
+                for (int i = 0; i < 4; ++i) {
+                    double dot = 0.0, transformed = a[3][i];
+                    for (int k = 0; k < 4; ++k) dot += static_cast<double>(a[i][k]) * v[k];
+                    for (int k = 0; k < 3; ++k) transformed += static_cast<double>(a[k][i]) * v[k];
+
+                    vectorError = std::max(vectorError, std::abs(result[i] - dot));
+                    pointError = std::max(pointError, std::abs(point[i] - transformed));
+                }
+
+                const Quaternion& p = inputs.rotations[n];
+                const Quaternion& q = inputs.targets[n];
+                Quaternion r = p * q;
+                double w = static_cast<double>(p.w) * q.w - static_cast<double>(p.x) * q.x - static_cast<double>(p.y) * q.y - static_cast<double>(p.z) * q.z;
+                double x = static_cast<double>(p.w) * q.x + static_cast<double>(p.x) * q.w + static_cast<double>(p.y) * q.z - static_cast<double>(p.z) * q.y;
+                double y = static_cast<double>(p.w) * q.y - static_cast<double>(p.x) * q.z + static_cast<double>(p.y) * q.w + static_cast<double>(p.z) * q.x;
+                double z = static_cast<double>(p.w) * q.z + static_cast<double>(p.x) * q.y - static_cast<double>(p.y) * q.x + static_cast<double>(p.z) * q.w;
+                quaternionError = std::max({quaternionError, std::abs(r.w - w), std::abs(r.x - x), std::abs(r.y - y), std::abs(r.z - z)});
+            }
+
+            auto checkError = [&runner](const std::string& name, double error) {
+                runner.check(name, error < TOLERANCE, fmt::format("max error {:.3g}", error));
+            };
+
+            checkError("math/Matrix4::operator*(Matrix4)", multiplyError);
+            checkError("math/Matrix4::inverted", inverseError);
+            checkError("math/Matrix4::transposed", transposeError);
+            checkError("math/Matrix4::operator*(Vector4)", vectorError);
+            checkError("math/Matrix4::transformPoint", pointError);
+            checkError("math/Quaternion::operator*", quaternionError);
+
+            double slerpError = 0.0;
+            for (uint32_t n = 0; n < BATCH_SIZE; ++n) {
+                const Quaternion& from = inputs.rotations[n];
+                Quaternion to = inputs.targets[n];
+                if (from.dot(to) < 0.0f) to = -to;
+
+                Quaternion start = Quaternion::slerp(from, to, 0.0f);
+                Quaternion end = Quaternion::slerp(from, to, 1.0f);
+                Quaternion middle = Quaternion::slerp(from, to, 0.5f);
+                // Half way between two unit quaternions is their normalized sum
+                Quaternion half = (from + to).normalized();
+
+                slerpError = std::max({slerpError, static_cast<double>((start - from).length()), static_cast<double>((end - to).length()),
+                                       static_cast<double>((middle - half).length()), std::abs(middle.length() - 1.0)});
+            }
+
+            checkError("math/Quaternion::slerp", slerpError);
+
+            // The TRS paths against Basis and the general inverse
+            double composeError = 0.0, composeInverseError = 0.0, affineError = 0.0, normalError = 0.0;
+            for (uint32_t n = 0; n < BATCH_SIZE; ++n) {
+                const Matrix4& trs = inputs.transforms[n];
+                Basis basis(inputs.rotations[n], inputs.scales[n]);
+                Matrix4 inverse = trs.inverted();
+                Matrix4 normal = inverse.transposed();
+
+                double basisMatrix[4][4]{}, inverseMatrix[4][4], normalMatrix[4][4]{};
+                for (int j = 0; j < 4; ++j) {
+                    for (int i = 0; i < 4; ++i) {
+                        if (i < 3 && j < 3) {
+                            basisMatrix[j][i] = basis[i][j];
+                            normalMatrix[j][i] = normal[j][i];
+                        }
+
+                        inverseMatrix[j][i] = inverse[j][i];
+                    }
+                }
+
+                const Vector3& position = inputs.angles[n];
+                for (int i = 0; i < 3; ++i) basisMatrix[3][i] = position[i];
+                basisMatrix[3][3] = normalMatrix[3][3] = 1.0;
+
+                composeError = std::max(composeError, maxError(trs, basisMatrix));
+                composeInverseError = std::max(composeInverseError, maxError(Matrix4::composeInverse(position, inputs.rotations[n], inputs.scales[n]), inverseMatrix));
+                affineError = std::max(affineError, maxError(trs.affineInverted(), inverseMatrix));
+                normalError = std::max(normalError, maxError(trs.normalMatrix(), normalMatrix));
+            }
+
+            checkError("math/Matrix4::compose", composeError);
+            checkError("math/Matrix4::composeInverse", composeInverseError);
+            checkError("math/Matrix4::affineInverted", affineError);
+            checkError("math/Matrix4::normalMatrix", normalError);
+        }
+
+        /**
+         * @brief The Inputs values as structure of arrays for the batch kernels
+         */
+        struct BatchInputs {
+            std::vector<float> x, y, z;
+            std::vector<float> positionX, positionY, positionZ;
+            std::vector<float> rotationW, rotationX, rotationY, rotationZ;
+            std::vector<float> scaleX, scaleY, scaleZ;
+            std::vector<float> radius;
+            // Orthographic frustum over the middle of the [-1, 1] cube where the points are
+            Frustum frustum;
+
+            explicit BatchInputs(const Inputs& inputs) {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                    x.push_back(inputs.vectors[i].x);
+                    y.push_back(inputs.vectors[i].y);
+                    z.push_back(inputs.vectors[i].z);
+                    positionX.push_back(inputs.angles[i].x);
+                    positionY.push_back(inputs.angles[i].y);
+                    positionZ.push_back(inputs.angles[i].z);
+                    rotationW.push_back(inputs.rotations[i].w);
+                    rotationX.push_back(inputs.rotations[i].x);
+                    rotationY.push_back(inputs.rotations[i].y);
+                    rotationZ.push_back(inputs.rotations[i].z);
+                    scaleX.push_back(inputs.scales[i].x);
+                    scaleY.push_back(inputs.scales[i].y);
+                    scaleZ.push_back(inputs.scales[i].z);
+                    radius.push_back(0.1f * std::abs(inputs.vectors[i].w));
+                }
+
+                frustum = Frustum(CULL_PROJECTION);
+            }
+
+            [[nodiscard]] math::PointArrays points() const { return {x.data(), y.data(), z.data()}; }
+
+            [[nodiscard]] math::TransformArrays transforms() const {
+                return {positionX.data(), positionY.data(), positionZ.data(), rotationW.data(), rotationX.data(),
+                        rotationY.data(), rotationZ.data(), scaleX.data(), scaleY.data(), scaleZ.data()};
+            }
+
+            [[nodiscard]] math::SphereArrays spheres() const { return {x.data(), y.data(), z.data(), radius.data()}; }
+
+            [[nodiscard]] Sphere sphere(uint32_t i) const { return {{x[i], y[i], z[i]}, radius[i]}; }
+        };
+
+        double maxError(const Matrix4& a, const Matrix4& b) {
+            double error = 0.0;
+            for (int j = 0; j < 4; ++j)
+                for (int i = 0; i < 4; ++i)
+                    error = std::max(error, static_cast<double>(std::abs(a[j][i] - b[j][i])));
+
+            return error;
+        }
+
+        /**
+         * @brief Batch kernels against the Matrix4 and Frustum functions they replace, with a count that leaves a
+         * partial group at the end
+         */
+        void checkBatch(Runner& runner, const Inputs& inputs, const BatchInputs& batch) {
+            constexpr uint32_t count = BATCH_SIZE - 3;
+
+            std::vector<float> clipX(count), clipY(count), clipZ(count), clipW(count);
+            math::transformPoints(inputs.matrices[0], batch.points(), count, {clipX.data(), clipY.data(), clipZ.data(), clipW.data()});
+
+            std::vector<Matrix4> products(count), matrices(count), inverses(count);
+            math::multiply(inputs.others[0], inputs.matrices.data(), count, products.data());
+            math::compose(batch.transforms(), count, matrices.data());
+            math::composeInverse(batch.transforms(), count, inverses.data());
+
+            std::vector<uint32_t> visible(count);
+            visible.resize(math::cullSpheres(batch.frustum, batch.spheres(), count, visible.data()));
+
+            double pointError = 0.0, multiplyError = 0.0, composeError = 0.0, inverseError = 0.0;
+            std::vector<uint32_t> expectedVisible;
+            for (uint32_t i = 0; i < count; ++i) {
+                Vector4 point = inputs.matrices[0].transformPoint({batch.x[i], batch.y[i], batch.z[i]});
+                pointError = std::max({pointError, static_cast<double>(std::abs(point.x - clipX[i])), static_cast<double>(std::abs(point.y - clipY[i])),
+                                       static_cast<double>(std::abs(point.z - clipZ[i])), static_cast<double>(std::abs(point.w - clipW[i]))});
+
+                multiplyError = std::max(multiplyError, maxError(inputs.others[0] * inputs.matrices[i], products[i]));
+                composeError = std::max(composeError, maxError(inputs.transforms[i], matrices[i]));
+                inverseError = std::max(inverseError, maxError(Matrix4::composeInverse(inputs.angles[i], inputs.rotations[i], inputs.scales[i]), inverses[i]));
+
+                if (batch.frustum.intersects(batch.sphere(i))) expectedVisible.push_back(i);
+            }
+
+            auto checkError = [&runner](const std::string& name, double error) {
+                runner.check(name, error < TOLERANCE, fmt::format("max error {:.3g}", error));
+            };
+
+            checkError("batch/math::transformPoints", pointError);
+            checkError("batch/math::multiply", multiplyError);
+            checkError("batch/math::compose", composeError);
+            checkError("batch/math::composeInverse", inverseError);
+            runner.check("batch/math::cullSpheres", visible == expectedVisible,
+                         fmt::format("{} visible, {} expected", visible.size(), expectedVisible.size()));
+        }
+
+        /**
+         * @brief Batch kernels next to the loops over the single value functions they replace
+         */
+        void batchBenchmarks(Runner& runner, const Inputs& inputs) {
+            if (!runner.enabledGroup("batch/")) return;
+
+            BatchInputs batch(inputs);
+            checkBatch(runner, inputs, batch);
+
+            std::vector<Matrix4> matrices(BATCH_SIZE);
+            std::vector<Vector4> points(BATCH_SIZE);
+            std::vector<float> clipX(BATCH_SIZE), clipY(BATCH_SIZE), clipZ(BATCH_SIZE), clipW(BATCH_SIZE);
+            std::vector<uint32_t> visible(BATCH_SIZE);
+            const Matrix4& viewProj = inputs.others[0];
+
+            runner.run("batch/Matrix4::transformPoint", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    points[i] = viewProj.transformPoint({batch.x[i], batch.y[i], batch.z[i]});
+
+                doNotOptimize(points.data());
+            });
+
+            runner.run("batch/math::transformPoints", BATCH_SIZE, [&] {
+                math::transformPoints(viewProj, batch.points(), BATCH_SIZE, {clipX.data(), clipY.data(), clipZ.data(), clipW.data()});
+                doNotOptimize(clipW.data());
+            });
+
+            runner.run("batch/Matrix4::operator*(Matrix4)", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    matrices[i] = viewProj * inputs.matrices[i];
+
+                doNotOptimize(matrices.data());
+            });
+
+            runner.run("batch/math::multiply", BATCH_SIZE, [&] {
+                math::multiply(viewProj, inputs.matrices.data(), BATCH_SIZE, matrices.data());
+                doNotOptimize(matrices.data());
+            });
+
+            runner.run("batch/Matrix4::compose", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    matrices[i] = Matrix4::compose(inputs.angles[i], inputs.rotations[i], inputs.scales[i]);
+
+                doNotOptimize(matrices.data());
+            });
+
+            runner.run("batch/math::compose", BATCH_SIZE, [&] {
+                math::compose(batch.transforms(), BATCH_SIZE, matrices.data());
+                doNotOptimize(matrices.data());
+            });
+
+            runner.run("batch/math::composeInverse", BATCH_SIZE, [&] {
+                math::composeInverse(batch.transforms(), BATCH_SIZE, matrices.data());
+                doNotOptimize(matrices.data());
+            });
+
+            runner.run("batch/Frustum::intersects(Sphere)", BATCH_SIZE, [&] {
+                uint32_t count = 0;
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                    if (batch.frustum.intersects(batch.sphere(i))) visible[count++] = i;
+                }
+
+                doNotOptimize(count);
+            });
+
+            runner.run("batch/math::cullSpheres", BATCH_SIZE, [&] {
+                doNotOptimize(math::cullSpheres(batch.frustum, batch.spheres(), BATCH_SIZE, visible.data()));
+            });
+        }
+
+        /**
+         * @brief Double precision slerp along the shortest arc, the reference of the fast interpolations
+         */
+        void referenceSlerp(const Quaternion& from, const Quaternion& to, double t, double (&result)[4]) {
+            double cosTheta = 0.0;
+            for (int i = 0; i < 4; ++i) cosTheta += static_cast<double>(from[i]) * to[i];
+
+            const double sign = cosTheta < 0.0 ? -1.0 : 1.0;
+            const double theta = std::acos(std::min(1.0, cosTheta * sign));
+            const double sinTheta = std::sin(theta);
+            const double fromWeight = sinTheta > 1e-9 ? std::sin((1.0 - t) * theta) / sinTheta : 1.0 - t;
+            const double toWeight = sinTheta > 1e-9 ? std::sin(t * theta) / sinTheta : t;
+
+            for (int i = 0; i < 4; ++i) result[i] = fromWeight * from[i] + sign * toWeight * to[i];
+        }
+
+        double maxError(const Quaternion& q, const double (&reference)[4]) {
+            double error = 0.0;
+            for (int i = 0; i < 4; ++i)
+                error = std::max(error, std::abs(q[i] - reference[i]));
+
+            return error;
+        }
+
+        /**
+         * @brief Fast math functions against double precision, each against the max error documented in FastMath.hpp
+         */
+        void checkFast(Runner& runner, const Inputs& inputs) {
+            // Angles over the whole documented range plus the usual ones, scalar and batch
+            constexpr uint32_t samples = 1 << 20;
+            constexpr uint32_t half = samples / 2;
+            std::vector<float> angles(samples);
+            for (uint32_t i = 0; i < samples; ++i)
+                angles[i] = i < half ? math::SINCOS_RANGE * (2.0f * i / half - 1.0f) : 8.0f * (i - half) / half - 4.0f;
+
+            std::vector<float> sines(samples), cosines(samples);
+            math::sincos(angles.data(), samples - 3, sines.data(), cosines.data());
+
+            double sincosError = 0.0, batchError = 0.0;
+            for (uint32_t i = 0; i < samples - 3; ++i) {
+                float s, c;
+                math::sincos(angles[i], s, c);
+                const double sine = std::sin(static_cast<double>(angles[i])), cosine = std::cos(static_cast<double>(angles[i]));
+                sincosError = std::max({sincosError, std::abs(s - sine), std::abs(c - cosine)});
+                batchError = std::max({batchError, std::abs(sines[i] - sine), std::abs(cosines[i] - cosine)});
+            }
+
+            auto checkError = [&runner](const std::string& name, double error, double maxError) {
+                runner.check(name, error <= maxError, fmt::format("max error {:.3g}, documented {:.3g}", error, maxError));
+            };
+
+            checkError("fast/math::sincos", sincosError, math::SINCOS_MAX_ERROR);
+            checkError("fast/math::sincos batch", batchError, math::SINCOS_MAX_ERROR);
+
+            // Random pairs at random t, a third of them close pairs for the linear fallback and a third near 90 degrees,
+            // where nlerp is the furthest, or near the fallback threshold, where fastSlerp is
+            std::mt19937 generator(23);
+            std::normal_distribution<float> normal;
+            std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+            auto randomRotation = [&] {
+                return Quaternion(normal(generator), normal(generator), normal(generator), normal(generator)).normalized();
+            };
+
+            double slerpError = 0.0, nlerpError = 0.0;
+            for (uint32_t n = 0; n < SLERP_SAMPLES; ++n) {
+                const Quaternion from = randomRotation();
+                Quaternion to = randomRotation();
+
+                if (n % 3 == 1) {
+                    to = (from + to * std::pow(10.0f, -1.0f - 4.0f * uniform(generator))).normalized();
+                } else if (n % 3 == 2) {
+                    const float theta = uniform(generator) < 0.5f ? 0.5f * Math::PI * (1.0f - 1e-3f * (0.01f + uniform(generator)))
+                                                                  : std::acos(1.0f - 1e-4f) * (0.5f + 1.5f * uniform(generator));
+                    const Quaternion orthogonal = (to - from * from.dot(to)).normalized();
+                    to = (from * std::cos(theta) + orthogonal * std::sin(theta)) * (uniform(generator) < 0.5f ? 1.0f : -1.0f);
+                }
+
+                // Both arcs are valid for orthogonal quaternions, float and double can pick different ones
+                if (std::abs(from.dot(to)) < 1e-5f) continue;
+
+                const float t = uniform(generator);
+                double reference[4];
+                referenceSlerp(from, to, t, reference);
+                slerpError = std::max(slerpError, maxError(math::fastSlerp(from, to, t), reference));
+                nlerpError = std::max(nlerpError, maxError(math::nlerp(from, to, t), reference));
+            }
+
+            checkError("fast/math::fastSlerp", slerpError, math::SLERP_MAX_ERROR);
+            checkError("fast/math::nlerp", nlerpError, math::NLERP_MAX_ERROR);
+
+            constexpr uint32_t count = BATCH_SIZE - 3;
+            std::vector<Quaternion> rotations(count);
+            math::eulerToQuaternions(inputs.angles.data(), count, rotations.data());
+
+            double eulerError = 0.0;
+            for (uint32_t i = 0; i < count; ++i) {
+                Quaternion expected(inputs.angles[i]);
+                for (int k = 0; k < 4; ++k)
+                    eulerError = std::max(eulerError, static_cast<double>(std::abs(rotations[i][k] - expected[k])));
+            }
+
+            checkError("fast/math::eulerToQuaternions", eulerError, TOLERANCE);
+        }
+
+        /**
+         * @brief Fast math functions next to the libm based functions they replace
+         */
+        void fastBenchmarks(Runner& runner, const Inputs& inputs) {
+            if (!runner.enabledGroup("fast/")) return;
+
+            checkFast(runner, inputs);
+
+            std::vector<float> angles(BATCH_SIZE), sines(BATCH_SIZE), cosines(BATCH_SIZE);
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i) angles[i] = inputs.angles[i][i % 3];
+
+            std::vector<Quaternion> rotations(BATCH_SIZE);
+
+            runner.run("fast/Math::sin + Math::cos", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                    sines[i] = Math::sin(angles[i]);
+                    cosines[i] = Math::cos(angles[i]);
+                }
+
+                doNotOptimize(sines.data());
+                doNotOptimize(cosines.data());
+            });
+
+            runner.run("fast/math::sincos", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    math::sincos(angles[i], sines[i], cosines[i]);
+
+                doNotOptimize(sines.data());
+                doNotOptimize(cosines.data());
+            });
+
+            runner.run("fast/math::sincos batch", BATCH_SIZE, [&] {
+                math::sincos(angles.data(), BATCH_SIZE, sines.data(), cosines.data());
+                doNotOptimize(sines.data());
+                doNotOptimize(cosines.data());
+            });
+
+            runner.run("fast/Quaternion::slerp", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    rotations[i] = Quaternion::slerp(inputs.rotations[i], inputs.targets[i], 0.3f);
+
+                doNotOptimize(rotations.data());
+            });
+
+            runner.run("fast/math::fastSlerp", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    rotations[i] = math::fastSlerp(inputs.rotations[i], inputs.targets[i], 0.3f);
+
+                doNotOptimize(rotations.data());
+            });
+
+            runner.run("fast/math::nlerp", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    rotations[i] = math::nlerp(inputs.rotations[i], inputs.targets[i], 0.3f);
+
+                doNotOptimize(rotations.data());
+            });
+
+            runner.run("fast/Quaternion(euler)", BATCH_SIZE, [&] {
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                    rotations[i] = Quaternion(inputs.angles[i]);
+
+                doNotOptimize(rotations.data());
+            });
+
+            runner.run("fast/math::eulerToQuaternions", BATCH_SIZE, [&] {
+                math::eulerToQuaternions(inputs.angles.data(), BATCH_SIZE, rotations.data());
+                doNotOptimize(rotations.data());
+            });
+        }
+
+    } // namespace
+
+    void mathBenchmarks(Runner& runner) {
+        Inputs inputs = makeInputs(BATCH_SIZE);
+        checkMath(runner, inputs);
+
+        std::vector<Matrix4> matrices(BATCH_SIZE);
+        std::vector<Basis> bases(BATCH_SIZE);
+        std::vector<Quaternion> rotations(BATCH_SIZE);
+
+        runner.run("math/Matrix4::operator*(Matrix4)", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.matrices[i] * inputs.others[i];
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::inverted", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.matrices[i].inverted();
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::inverted affine", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.transforms[i].inverted();
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::affineInverted", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.transforms[i].affineInverted();
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::inverted().transposed()", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.transforms[i].inverted().transposed();
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::normalMatrix", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = inputs.transforms[i].normalMatrix();
+
+            doNotOptimize(matrices.data());
+        });
+
+        // The Transform local matrix before Matrix4::compose
+        runner.run("math/Basis to Matrix4", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                Basis basis(inputs.rotations[i], inputs.scales[i]);
+                const Vector3& position = inputs.angles[i];
+                matrices[i] = {
+                    { basis[0][0], basis[1][0], basis[2][0], 0.0f },
+                    { basis[0][1], basis[1][1], basis[2][1], 0.0f },
+                    { basis[0][2], basis[1][2], basis[2][2], 0.0f },
+                    { position.x, position.y, position.z, 1.0f }
+                };
+            }
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::compose", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = Matrix4::compose(inputs.angles[i], inputs.rotations[i], inputs.scales[i]);
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Matrix4::composeInverse", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                matrices[i] = Matrix4::composeInverse(inputs.angles[i], inputs.rotations[i], inputs.scales[i]);
+
+            doNotOptimize(matrices.data());
+        });
+
+        runner.run("math/Basis(Quaternion, scale)", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                bases[i] = Basis(inputs.rotations[i], inputs.scales[i]);
+
+            doNotOptimize(bases.data());
+        });
+
+        runner.run("math/Quaternion(euler)", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                rotations[i] = Quaternion(inputs.angles[i]);
+
+            doNotOptimize(rotations.data());
+        });
+
+        runner.run("math/Quaternion::slerp", BATCH_SIZE, [&] {
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i)
+                rotations[i] = Quaternion::slerp(inputs.rotations[i], inputs.targets[i], 0.3f);
+
+            doNotOptimize(rotations.data());
+        });
+
+        batchBenchmarks(runner, inputs);
+        fastBenchmarks(runner, inputs);
+
+        if (runner.enabledGroup("transform/")) {
+            // Roots with one level of children, every frame all the roots move
+            entt::registry registry;
+            std::vector<id_t> roots;
+            for (uint32_t i = 0; i < TRANSFORM_ROOTS; ++i) {
+                EntityHandle root(&registry, registry.create());
+                root.addComponent<Transform>(inputs.angles[i], inputs.scales[i], inputs.angles[i]);
+                roots.push_back(root.getId());
+
+                for (uint32_t j = 0; j < TRANSFORM_CHILDREN; ++j) {
+                    uint32_t index = (i * TRANSFORM_CHILDREN + j) % BATCH_SIZE;
+                    EntityHandle child(&registry, registry.create());
+                    child.addComponent<Transform>(inputs.angles[index], inputs.scales[index], inputs.rotations[index]);
+                    child.setParent(root);
+                }
+            }
+
+            TransformSystem transformSystem;
+            uint32_t count = TRANSFORM_ROOTS * (TRANSFORM_CHILDREN + 1);
+            runner.run(fmt::format("transform/{}/TransformSystem world matrices", count), count, [&] {
+                for (auto root : roots) registry.get<Transform>(root).markDirty();
+                transformSystem.update(registry);
+            });
+        }
+    }
+
+} // namespace re::bench
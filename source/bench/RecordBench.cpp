@@ -0,0 +1,465 @@
+#include "Bench.hpp"
+
+#include <array>
+#include <memory>
+
+#include "fmt/format.h"
+
+#include "entt/entt.hpp"
+#include "tiny_gltf.h"
+
+#include "engine/core/Utils.hpp"
+#include "engine/math/Vector4.hpp"
+#include "engine/assets/Model.hpp"
+#include "engine/files/FilesManager.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/scene/TransformSystem.hpp"
+#include "engine/render/Instance.hpp"
+#include "engine/render/Device.hpp"
+#include "engine/render/CommandRecorder.hpp"
+#include "engine/render/RenderPackets.hpp"
+#include "engine/render/buffers/Buffer.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+
+
+namespace re::bench {
+
+    namespace {
+
+        constexpr uint32_t RECORD_DRAWS = 20'000;
+        // Draws are sorted by material like the render queue, each material binds a descriptor set and pushes constants
+        constexpr uint32_t RECORD_MATERIALS = 512;
+        constexpr uint32_t RECORD_THREADS[] = {1, 2, 4, 8, 16};
+        constexpr uint32_t PUSH_CONSTANTS_SIZE = sizeof(Vector4) * 2;
+        constexpr uint32_t INSTANCING_COPIES = 10'000;
+        // Side of the grid the copies are placed on
+        constexpr uint32_t INSTANCING_GRID = 100;
+
+        // Vertex shader with an empty main, assembled by hand. With rasterizer discard it makes a complete
+        // pipeline, so the draws are valid without shader files.
+        constexpr uint32_t EMPTY_VERTEX_SHADER[] = {
+                0x07230203, 0x00010000, 0, 5, 0,
+                0x00020011, 1,                            // OpCapability Shader
+                0x0003000E, 0, 1,                         // OpMemoryModel Logical GLSL450
+                0x0005000F, 0, 3, 0x6E69616D, 0,          // OpEntryPoint Vertex %3 "main"
+                0x00020013, 1,                            // %1 = OpTypeVoid
+                0x00030021, 2, 1,                         // %2 = OpTypeFunction %1
+                0x00050036, 1, 3, 0, 2,                   // %3 = OpFunction %1 None %2
+                0x000200F8, 4,                            // %4 = OpLabel
+                0x000100FD,                               // OpReturn
+                0x00010038                                // OpFunctionEnd
+        };
+
+        /**
+         * @brief Vulkan objects the recorded draws use: a render pass, a pipeline with the set and push constant
+         * layout of the model pipeline, and one buffer as index, indirect and storage buffer. Nothing is ever
+         * submitted, only the CPU cost of recording is measured.
+         */
+        class RecordScene : NonCopyable {
+        public:
+            explicit RecordScene(std::shared_ptr<Device> device);
+
+            ~RecordScene() override;
+
+            void record(VkCommandBuffer commandBuffer, uint32_t first, uint32_t last, uint32_t drawCount, uint32_t materialCount) const;
+
+            [[nodiscard]] VkRenderPass getRenderPass() const;
+
+        private:
+            void createRenderPass();
+
+            void createPipeline();
+
+            void createDescriptorSets();
+
+        private:
+            std::shared_ptr<Device> device;
+            VkRenderPass renderPass{};
+            VkDescriptorSetLayout setLayout{};
+            VkPipelineLayout layout{};
+            VkPipeline pipeline{};
+            VkDescriptorPool descriptorPool{};
+            // Set 0 and one set 1 per material
+            std::vector<VkDescriptorSet> sets;
+            std::unique_ptr<Buffer> buffer;
+        };
+
+        RecordScene::RecordScene(std::shared_ptr<Device> device) : device(std::move(device)) {
+            buffer = std::make_unique<Buffer>(this->device->getAllocator(), sizeof(VkDrawIndexedIndirectCommand) * RECORD_DRAWS,
+                                              VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                              VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+            createRenderPass();
+            createPipeline();
+            createDescriptorSets();
+        }
+
+        RecordScene::~RecordScene() {
+            VkDevice logicalDevice = device->getDevice();
+
+            vkDestroyDescriptorPool(logicalDevice, descriptorPool, nullptr);
+            vkDestroyPipeline(logicalDevice, pipeline, nullptr);
+            vkDestroyPipelineLayout(logicalDevice, layout, nullptr);
+            vkDestroyDescriptorSetLayout(logicalDevice, setLayout, nullptr);
+            vkDestroyRenderPass(logicalDevice, renderPass, nullptr);
+        }
+
+        /**
+         * @brief Record draws [first, last) the way RenderSystem records a slice on devices without
+         * multiDrawIndirect: bind the state a secondary command buffer doesn't inherit, then per material the
+         * descriptor set and push constants, and one vkCmdDrawIndexedIndirect per command.
+         * @param drawCount Draws of the whole frame, up to RECORD_DRAWS
+         * @param materialCount Materials the draws of the frame are spread over, up to RECORD_MATERIALS
+         */
+        void RecordScene::record(VkCommandBuffer commandBuffer, uint32_t first, uint32_t last, uint32_t drawCount, uint32_t materialCount) const {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdBindIndexBuffer(commandBuffer, buffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &sets[0], 0, nullptr);
+
+            constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+            uint32_t material = UINT32_MAX;
+
+            for (uint32_t i = first; i < last; ++i) {
+                uint32_t drawMaterial = static_cast<uint32_t>(static_cast<uint64_t>(i) * materialCount / drawCount);
+                if (drawMaterial != material) {
+                    material = drawMaterial;
+
+                    std::array<Vector4, 2> constants = {Vector4(static_cast<float>(material)), Vector4(0.0f)};
+                    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &sets[1 + material], 0, nullptr);
+                    vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, PUSH_CONSTANTS_SIZE, constants.data());
+                }
+
+                vkCmdDrawIndexedIndirect(commandBuffer, buffer->getBuffer(), static_cast<VkDeviceSize>(i) * stride, 1, stride);
+            }
+        }
+
+        VkRenderPass RecordScene::getRenderPass() const {
+            return renderPass;
+        }
+
+        void RecordScene::createRenderPass() {
+            VkAttachmentDescription attachment{};
+            attachment.format = VK_FORMAT_R8G8B8A8_UNORM;
+            attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+            VkAttachmentReference colorReference{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+
+            VkSubpassDescription subpass{};
+            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount = 1;
+            subpass.pColorAttachments = &colorReference;
+
+            VkRenderPassCreateInfo createInfo{VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+            createInfo.attachmentCount = 1;
+            createInfo.pAttachments = &attachment;
+            createInfo.subpassCount = 1;
+            createInfo.pSubpasses = &subpass;
+
+            checkResult(vkCreateRenderPass(device->getDevice(), &createInfo, nullptr, &renderPass),
+                        "Failed to create render pass!");
+        }
+
+        void RecordScene::createPipeline() {
+            VkDevice logicalDevice = device->getDevice();
+
+            VkDescriptorSetLayoutBinding binding{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
+            VkDescriptorSetLayoutCreateInfo setLayoutInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+            setLayoutInfo.bindingCount = 1;
+            setLayoutInfo.pBindings = &binding;
+            checkResult(vkCreateDescriptorSetLayout(logicalDevice, &setLayoutInfo, nullptr, &setLayout),
+                        "Failed to create descriptor set layout!");
+
+            std::array<VkDescriptorSetLayout, 2> setLayouts = {setLayout, setLayout};
+            VkPushConstantRange pushConstantRange{VK_SHADER_STAGE_VERTEX_BIT, 0, PUSH_CONSTANTS_SIZE};
+            VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+            layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+            layoutInfo.pSetLayouts = setLayouts.data();
+            layoutInfo.pushConstantRangeCount = 1;
+            layoutInfo.pPushConstantRanges = &pushConstantRange;
+            checkResult(vkCreatePipelineLayout(logicalDevice, &layoutInfo, nullptr, &layout),
+                        "Failed to create pipeline layout!");
+
+            VkShaderModuleCreateInfo moduleInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+            moduleInfo.codeSize = sizeof(EMPTY_VERTEX_SHADER);
+            moduleInfo.pCode = EMPTY_VERTEX_SHADER;
+            VkShaderModule module;
+            checkResult(vkCreateShaderModule(logicalDevice, &moduleInfo, nullptr, &module),
+                        "Failed to create shader module!");
+
+            VkPipelineShaderStageCreateInfo stage{VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
+            stage.stage = VK_SHADER_STAGE_VERTEX_BIT;
+            stage.module = module;
+            stage.pName = "main";
+
+            VkPipelineVertexInputStateCreateInfo vertexInput{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
+            VkPipelineInputAssemblyStateCreateInfo inputAssembly{VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
+            inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+            // Without rasterization the viewport, multisample, depth and blend states aren't needed
+            VkPipelineRasterizationStateCreateInfo rasterization{VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO};
+            rasterization.rasterizerDiscardEnable = VK_TRUE;
+            rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+            rasterization.lineWidth = 1.0f;
+
+            VkGraphicsPipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+            pipelineInfo.stageCount = 1;
+            pipelineInfo.pStages = &stage;
+            pipelineInfo.pVertexInputState = &vertexInput;
+            pipelineInfo.pInputAssemblyState = &inputAssembly;
+            pipelineInfo.pRasterizationState = &rasterization;
+            pipelineInfo.layout = layout;
+            pipelineInfo.renderPass = renderPass;
+            pipelineInfo.subpass = 0;
+
+            VkResult result = vkCreateGraphicsPipelines(logicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+            vkDestroyShaderModule(logicalDevice, module, nullptr);
+            checkResult(result, "Failed to create graphics pipeline!");
+        }
+
+        void RecordScene::createDescriptorSets() {
+            VkDevice logicalDevice = device->getDevice();
+            const uint32_t setCount = 1 + RECORD_MATERIALS;
+
+            VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, setCount};
+            VkDescriptorPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+            poolInfo.maxSets = setCount;
+            poolInfo.poolSizeCount = 1;
+            poolInfo.pPoolSizes = &poolSize;
+            checkResult(vkCreateDescriptorPool(logicalDevice, &poolInfo, nullptr, &descriptorPool),
+                        "Failed to create descriptor pool!");
+
+            std::vector<VkDescriptorSetLayout> setLayouts(setCount, setLayout);
+            VkDescriptorSetAllocateInfo allocInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+            allocInfo.descriptorPool = descriptorPool;
+            allocInfo.descriptorSetCount = setCount;
+            allocInfo.pSetLayouts = setLayouts.data();
+
+            sets.resize(setCount);
+            checkResult(vkAllocateDescriptorSets(logicalDevice, &allocInfo, sets.data()),
+                        "Failed to allocate descriptor sets!");
+
+            VkDescriptorBufferInfo bufferInfo = buffer->descriptorInfo();
+            std::vector<VkWriteDescriptorSet> writes(setCount);
+            for (uint32_t i = 0; i < setCount; ++i) {
+                writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+                writes[i].dstSet = sets[i];
+                writes[i].dstBinding = 0;
+                writes[i].descriptorCount = 1;
+                writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[i].pBufferInfo = &bufferInfo;
+            }
+
+            vkUpdateDescriptorSets(logicalDevice, setCount, writes.data(), 0, nullptr);
+        }
+
+        /**
+         * @brief Record the same draws split in one secondary command buffer per thread, for each thread count
+         * the JobSystem can run at once
+         */
+        void threadBenchmarks(Runner& runner, const std::shared_ptr<Device>& device) {
+            RecordScene scene(device);
+
+            CommandRecorder recorder(device, jobs::JobSystem::getInstance()->getThreadCount() + 1, 1);
+            recorder.setTarget(scene.getRenderPass(), 0, VK_NULL_HANDLE, {1280, 720});
+
+            std::vector<VkCommandBuffer> commandBuffers;
+            auto recordFrame = [&](uint32_t threads) {
+                recorder.beginFrame(0);
+
+                commandBuffers.assign(threads, VK_NULL_HANDLE);
+                jobs::parallelFor(threads, 1, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t slice = begin; slice < end; ++slice) {
+                        VkCommandBuffer commandBuffer = recorder.begin();
+                        scene.record(commandBuffer, RECORD_DRAWS * slice / threads, RECORD_DRAWS * (slice + 1) / threads,
+                                     RECORD_DRAWS, RECORD_MATERIALS);
+                        recorder.end(commandBuffer);
+                        commandBuffers[slice] = commandBuffer;
+                    }
+                });
+
+                for (auto commandBuffer : commandBuffers)
+                    recorder.submit(commandBuffer);
+            };
+
+            for (auto threads : RECORD_THREADS) {
+                if (threads > recorder.getThreadCount()) break;
+
+                std::string name = fmt::format("record/{} threads/CommandRecorder", threads);
+                runner.run(name, RECORD_DRAWS, [&] {
+                    recordFrame(threads);
+                    doNotOptimize(commandBuffers.data());
+                });
+
+                recordFrame(threads);
+                runner.check(name + " records every slice", std::none_of(commandBuffers.begin(), commandBuffers.end(), [](VkCommandBuffer commandBuffer) {
+                    return commandBuffer == VK_NULL_HANDLE;
+                }));
+            }
+        }
+
+        /**
+         * @brief Box.gltf flattened the way the glTF loader of Model does it, one draw per primitive with the
+         * node matrices including their parents. Meshes and materials stay null, the draws only need the index
+         * ranges and sort keys.
+         */
+        std::unique_ptr<Model> loadBox() {
+            File file = files::getFile("models/Box.gltf");
+            tinygltf::Model gltfModel;
+            tinygltf::TinyGLTF gltfContext;
+            if (!gltfContext.LoadASCIIFromFile(&gltfModel, nullptr, nullptr, file.getPath()))
+                throwEx(fmt::format("Failed to load {}", file.getPath()));
+
+            std::vector<Model::Node> nodes(gltfModel.nodes.size());
+            for (uint32_t i = 0; i < nodes.size(); ++i) {
+                const tinygltf::Node& node = gltfModel.nodes[i];
+                nodes[i].index = i;
+
+                if (node.translation.size() == 3)
+                    nodes[i].translation = Vector3(node.translation.data());
+
+                // glTF stores rotations as x, y, z, w
+                if (node.rotation.size() == 4)
+                    nodes[i].rotation = Quaternion(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]),
+                                                   static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2]));
+
+                if (node.scale.size() == 3)
+                    nodes[i].scale = Vector3(node.scale.data());
+
+                for (int child : node.children)
+                    nodes[child].parent = static_cast<int32_t>(i);
+            }
+
+            std::vector<Matrix4> nodeMatrices(nodes.size());
+            std::vector<Model::Draw> draws;
+            for (uint32_t i = 0; i < nodes.size(); ++i) {
+                nodeMatrices[i] = nodes[i].getLocalMatrix();
+                for (int32_t parent = nodes[i].parent; parent > -1; parent = nodes[parent].parent)
+                    nodeMatrices[i] = nodes[parent].getLocalMatrix() * nodeMatrices[i];
+
+                int mesh = gltfModel.nodes[i].mesh;
+                if (mesh < 0) continue;
+
+                auto& primitives = gltfModel.meshes[mesh].primitives;
+                uint32_t firstIndex = 0;
+                for (uint32_t p = 0; p < primitives.size(); ++p) {
+                    if (primitives[p].indices < 0) continue;
+
+                    auto indexCount = static_cast<uint32_t>(gltfModel.accessors[primitives[p].indices].count);
+                    auto material = static_cast<uint32_t>(std::max(primitives[p].material, 0));
+                    draws.push_back({i, nullptr, nullptr, firstIndex, indexCount, 0,
+                                     RenderPacket::makeSortKey(RenderPacket::MODEL_PIPELINE, material, static_cast<uint32_t>(mesh), p)});
+                    firstIndex += indexCount;
+                }
+            }
+
+            return std::make_unique<Model>("Box", std::move(nodeMatrices), std::move(draws), AABB{});
+        }
+
+        /**
+         * @brief 10k copies of Box.gltf through extraction and submit: batched merges the runs of packets
+         * RenderSystem draws as instances into one indirect command, unbatched records one command per packet
+         * like before instancing. Each frame builds the commands from the packets and records them.
+         */
+        void instancingBenchmarks(Runner& runner, const std::shared_ptr<Device>& device) {
+            std::unique_ptr<Model> box;
+            try {
+                files::FilesManager::setRootPath();
+                files::addPath("assets");
+                box = loadBox();
+            } catch (const std::exception& e) {
+                fmt::print("render/instancing: skipped, Box.gltf not found ({})\n", e.what());
+                return;
+            }
+
+            entt::registry registry;
+            for (uint32_t i = 0; i < INSTANCING_COPIES; ++i) {
+                EntityHandle entity(&registry, registry.create());
+                Vector3d position(static_cast<double>(i % INSTANCING_GRID) * 2.0, 0.0, static_cast<double>(i / INSTANCING_GRID) * 2.0);
+                entity.addComponent<Transform>(position, Vector3(1.0f), Vector3(0.0f));
+            }
+
+            TransformSystem transformSystem;
+            transformSystem.update(registry);
+
+            std::vector<RenderPackets::Object> objects;
+            for (auto id : registry.view<Transform>())
+                objects.push_back({&registry.get<Transform>(id), box.get()});
+
+            RenderPackets packets;
+            packets.extract(objects, Vector3d(INSTANCING_GRID, 1.7, INSTANCING_GRID));
+            if (packets.size() > RECORD_DRAWS) throwEx("render/instancing: more packets than recorded draws");
+
+            RecordScene scene(device);
+            CommandRecorder recorder(device, 1, 1);
+            recorder.setTarget(scene.getRenderPass(), 0, VK_NULL_HANDLE, {1280, 720});
+
+            std::vector<VkDrawIndexedIndirectCommand> commands;
+            auto buildCommands = [&](bool batched) {
+                commands.clear();
+                for (uint32_t first = 0; first < packets.size();) {
+                    const RenderPacket& packet = packets[first];
+                    uint32_t count = batched ? packets.runLength(first) : 1;
+                    commands.push_back({packet.indexCount, count, packet.firstIndex, packet.vertexOffset, first});
+                    first += count;
+                }
+            };
+
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            auto recordFrame = [&](bool batched) {
+                recorder.beginFrame(0);
+                buildCommands(batched);
+
+                auto drawCount = static_cast<uint32_t>(commands.size());
+                commandBuffer = recorder.begin();
+                scene.record(commandBuffer, 0, drawCount, drawCount, 1);
+                recorder.end(commandBuffer);
+                recorder.submit(commandBuffer);
+            };
+
+            for (bool batched : {true, false}) {
+                std::string name = fmt::format("render/instancing/{} Box.gltf/{}", INSTANCING_COPIES, batched ? "batched" : "unbatched");
+                runner.run(name, INSTANCING_COPIES, [&] {
+                    recordFrame(batched);
+                    doNotOptimize(commandBuffer);
+                });
+
+                recordFrame(batched);
+                size_t expected = batched ? box->getDraws().size() : packets.size();
+                runner.check(name + " draw commands", commands.size() == expected,
+                             fmt::format("{} draw commands for {} packets", commands.size(), packets.size()));
+            }
+        }
+
+    } // namespace
+
+    /**
+     * @brief Secondary command buffer recording against thread count, and instanced against per packet draws,
+     * on a headless device, lavapipe is enough for it. Skipped when no Vulkan device can be created.
+     */
+    void recordBenchmarks(Runner& runner) {
+        bool threads = runner.enabledGroup("record/");
+        bool instancing = runner.enabledGroup("render/instancing/");
+        if (!threads && !instancing) return;
+
+        std::shared_ptr<Device> device;
+        try {
+            auto instance = std::make_shared<Instance>("RavenEngineBench", std::vector<const char*>{});
+            device = std::make_shared<Device>(instance, std::vector<const char*>{}, VkPhysicalDeviceFeatures{});
+        } catch (const std::exception& e) {
+            fmt::print("record: skipped, no Vulkan device ({})\n", e.what());
+            return;
+        }
+
+        fmt::print("record: {}\n", device->getProperties().deviceName);
+        if (threads) threadBenchmarks(runner, device);
+        if (instancing) instancingBenchmarks(runner, device);
+    }
+
+} // namespace re::bench
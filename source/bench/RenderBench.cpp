@@ -0,0 +1,172 @@
+#include "Bench.hpp"
+
+#include <random>
+#include <memory>
+#include <algorithm>
+
+#include "fmt/format.h"
+#include "entt/entt.hpp"
+
+#include "engine/math/Math.hpp"
+#include "engine/assets/Model.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/scene/TransformSystem.hpp"
+#include "engine/render/RenderPackets.hpp"
+
+
+namespace re::bench {
+
+    namespace {
+
+        constexpr uint32_t RENDER_OBJECTS[] = {10'000, 100'000};
+        constexpr uint32_t RENDER_MODELS = 32;
+        constexpr uint32_t RENDER_MATERIALS = 16;
+        // Side of the cube the objects are spread in, centered far from the world origin like an open world level
+        constexpr float RENDER_AREA = 2000.0f;
+        constexpr double RENDER_CENTER = 50'000.0;
+
+        /**
+         * @brief Models of one to three nodes with one or two primitives each. Meshes and materials are null,
+         * extraction only copies them, so no GPU is needed.
+         */
+        std::vector<std::unique_ptr<Model>> makeModels(std::mt19937& generator) {
+            std::uniform_int_distribution<uint32_t> nodeCount(1, 3);
+            std::uniform_int_distribution<uint32_t> primitiveCount(1, 2);
+            std::uniform_int_distribution<uint32_t> material(0, RENDER_MATERIALS - 1);
+            std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+            std::vector<std::unique_ptr<Model>> models;
+            for (uint32_t m = 0; m < RENDER_MODELS; ++m) {
+                std::vector<Matrix4> nodeMatrices;
+                std::vector<Model::Draw> draws;
+
+                for (uint32_t node = nodeCount(generator); node-- > 0;) {
+                    auto index = static_cast<uint32_t>(nodeMatrices.size());
+                    nodeMatrices.push_back(Matrix4::compose({offset(generator), offset(generator), offset(generator)},
+                                                            Quaternion(Vector3(offset(generator), offset(generator), 0.0f)), Vector3(1.0f)));
+
+                    for (uint32_t primitive = primitiveCount(generator); primitive-- > 0;) {
+                        draws.push_back({index, nullptr, nullptr, primitive * 300, 300, static_cast<int32_t>(m * 1000),
+                                         RenderPacket::makeSortKey(RenderPacket::MODEL_PIPELINE, material(generator), m * 4 + index, primitive)});
+                    }
+                }
+
+                models.push_back(std::make_unique<Model>(fmt::format("Model {}", m), std::move(nodeMatrices), std::move(draws), AABB{}));
+            }
+
+            return models;
+        }
+
+        /**
+         * @brief Radix sort of the render queue against std::sort on the same unsorted keys
+         * @param order Sorted items of an extraction, shuffled back to packet order here
+         */
+        void sortBenchmarks(Runner& runner, const std::string& group, const std::vector<RenderPackets::SortItem>& order) {
+            std::vector<RenderPackets::SortItem> unsorted(order.size());
+            for (auto& item : order)
+                unsorted[item.packet] = item;
+
+            std::vector<RenderPackets::SortItem> items;
+            std::vector<RenderPackets::SortItem> scratch;
+            auto less = [](const RenderPackets::SortItem& a, const RenderPackets::SortItem& b) {
+                return a.key < b.key || (a.key == b.key && a.packet < b.packet);
+            };
+
+            runner.run(group + "RenderPackets::sort", unsorted.size(), [&] {
+                items = unsorted;
+                RenderPackets::sort(items, scratch);
+                doNotOptimize(items.data());
+            });
+
+            runner.run(group + "std::sort", unsorted.size(), [&] {
+                items = unsorted;
+                std::sort(items.begin(), items.end(), less);
+                doNotOptimize(items.data());
+            });
+
+            std::vector<RenderPackets::SortItem> expected = unsorted;
+            std::sort(expected.begin(), expected.end(), less);
+            items = unsorted;
+            RenderPackets::sort(items, scratch);
+
+            runner.check(group + "radix sort matches std::sort", std::equal(items.begin(), items.end(), expected.begin(), expected.end(),
+                                                                            [](auto& a, auto& b) { return a.key == b.key && a.packet == b.packet; }));
+        }
+
+        void extractBenchmarks(Runner& runner, uint32_t count) {
+            std::string group = fmt::format("render/{}/", count);
+            if (!runner.enabledGroup(group)) return;
+
+            std::mt19937 generator(17);
+            std::uniform_real_distribution<float> position(-RENDER_AREA * 0.5f, RENDER_AREA * 0.5f);
+            std::uniform_real_distribution<float> angle(-Math::PI, Math::PI);
+            std::uniform_int_distribution<uint32_t> model(0, RENDER_MODELS - 1);
+
+            auto models = makeModels(generator);
+
+            entt::registry registry;
+            std::vector<RenderPackets::Object> objects;
+            for (uint32_t i = 0; i < count; ++i) {
+                EntityHandle entity(&registry, registry.create());
+                Vector3d center(RENDER_CENTER + position(generator), position(generator), RENDER_CENTER + position(generator));
+                entity.addComponent<Transform>(center, Vector3(1.0f), Vector3(0.0f, angle(generator), 0.0f));
+            }
+
+            TransformSystem transformSystem;
+            transformSystem.update(registry);
+
+            for (auto id : registry.view<Transform>())
+                objects.push_back({&registry.get<Transform>(id), models[model(generator)].get()});
+
+            const Vector3d origin(RENDER_CENTER, 1.7, RENDER_CENTER);
+            RenderPackets packets;
+            runner.run(group + "RenderPackets::extract", count, [&] {
+                packets.extract(objects, origin);
+                doNotOptimize(packets.getOrder().data());
+            });
+
+            // Packets are in object order, every one must match the matrices computed directly
+            packets.extract(objects, origin);
+            bool matches = true;
+            size_t packet = 0;
+            for (auto& object : objects) {
+                const Matrix4 world = object.transform->getRelativeWorldMatrix(origin);
+                for (auto& draw : object.model->getDraws()) {
+                    matches &= packet < packets.size() && RenderPacket::withDepth(packets.getPackets()[packet].sortKey, 0.0f) == draw.sortKey &&
+                               packets.getPackets()[packet].model == world * object.model->getNodeMatrix(draw.node);
+                    packet++;
+                }
+            }
+
+            bool sorted = std::is_sorted(packets.getOrder().begin(), packets.getOrder().end(), [](auto& a, auto& b) {
+                return a.key < b.key;
+            });
+
+            runner.check(group + "extract writes every draw", matches && packet == packets.size(),
+                         fmt::format("{} packets for {} draws", packets.size(), packet));
+            runner.check(group + "extract sorts by key", sorted);
+
+            // Material changes between consecutive packets, what the submitter binds before skipping equal state
+            auto materialChanges = [&](auto&& key) {
+                uint32_t changes = 0;
+                for (size_t i = 0; i < packets.size(); ++i)
+                    changes += i == 0 || (key(i) >> 40) != (key(i - 1) >> 40);
+                return changes;
+            };
+            uint32_t unsortedChanges = materialChanges([&](size_t i) { return packets.getPackets()[i].sortKey; });
+            uint32_t sortedChanges = materialChanges([&](size_t i) { return packets[i].sortKey; });
+            runner.check(group + "sorted packets bind each material once", sortedChanges <= RENDER_MATERIALS,
+                         fmt::format("{} material changes unsorted, {} sorted", unsortedChanges, sortedChanges));
+
+            sortBenchmarks(runner, group, packets.getOrder());
+        }
+
+    } // namespace
+
+    void renderBenchmarks(Runner& runner) {
+        for (auto count : RENDER_OBJECTS)
+            extractBenchmarks(runner, count);
+    }
+
+} // namespace re::bench
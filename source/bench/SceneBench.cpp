@@ -0,0 +1,510 @@
+#include "Bench.hpp"
+
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "entt/entt.hpp"
+
+#include "engine/math/Frustum.hpp"
+#include "engine/files/File.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "engine/entity/components/Name.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/scene/Scene.hpp"
+#include "engine/scene/EntityCommands.hpp"
+#include "engine/scene/DynamicTree.hpp"
+#include "engine/scene/NameIndex.hpp"
+#include "engine/scene/SceneFormat.hpp"
+
+
+namespace re::bench {
+
+    namespace {
+
+        constexpr uint32_t TREE_SIZES[] = {10'000, 100'000, 1'000'000};
+        // Average boxes per unit of volume, the world grows with the entity count
+        constexpr float TREE_DENSITY = 0.01f;
+        // Fraction of the entities moved each frame
+        constexpr uint32_t TREE_MOVED_DIVISOR = 10;
+        constexpr uint32_t TREE_QUERIES = 64;
+
+        constexpr uint32_t SCENE_ENTITIES = 100'000;
+        constexpr uint32_t SCENE_GROUPS = 1000;
+        constexpr uint32_t NAME_QUERIES = 1024;
+        constexpr uint32_t HIERARCHY_CHILDREN = 100'000;
+        constexpr uint32_t COMMAND_THREADS = 4;
+        constexpr uint32_t COMMAND_ELEMENTS = 1000;
+        constexpr uint32_t COMMAND_RUNS = 8;
+
+        void treeBenchmarks(Runner& runner, uint32_t count) {
+            if (!runner.enabledGroup(fmt::format("bvh/{}/", count))) return;
+
+            std::mt19937 generator(7);
+            float worldSize = std::cbrt(static_cast<float>(count) / TREE_DENSITY);
+            std::uniform_real_distribution<float> position(0.0f, worldSize);
+            std::uniform_real_distribution<float> size(0.5f, 2.0f);
+            std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+            std::vector<AABB> boxes(count);
+            for (auto& box : boxes) {
+                Vector3 min(position(generator), position(generator), position(generator));
+                box = {min, min + Vector3(size(generator), size(generator), size(generator))};
+            }
+
+            auto key = [](uint32_t i) { return static_cast<DynamicTree::Key>(i); };
+
+            DynamicTree tree;
+            runner.run(fmt::format("bvh/{}/insert", count), count, [&] {
+                tree.clear();
+                for (uint32_t i = 0; i < count; ++i)
+                    tree.insert(key(i), boxes[i]);
+            });
+
+            if (tree.size() != count) {
+                for (uint32_t i = 0; i < count; ++i)
+                    tree.insert(key(i), boxes[i]);
+            }
+
+            // Every call moves a different slice of the entities by up to one unit, further than the fat margin
+            uint32_t moved = count / TREE_MOVED_DIVISOR;
+            uint32_t first = 0;
+            runner.run(fmt::format("bvh/{}/update", count), moved, [&] {
+                for (uint32_t i = first; i < first + moved; ++i) {
+                    Vector3 delta(offset(generator), offset(generator), offset(generator));
+                    boxes[i] = {boxes[i].min + delta, boxes[i].max + delta};
+                    tree.update(key(i), boxes[i]);
+                }
+
+                first = (first + moved) % (count - moved + 1);
+            });
+
+            // Orthographic frustum over a tenth of the world width along x and y, with depth in [0, 1]
+            std::vector<Frustum> frustums;
+            std::vector<AABB> regions;
+            std::uniform_real_distribution<float> center(0.1f * worldSize, 0.9f * worldSize);
+            for (uint32_t i = 0; i < TREE_QUERIES; ++i) {
+                float halfSize = 0.05f * worldSize;
+                Vector3 c(center(generator), center(generator), 0.0f);
+
+                Matrix4 viewProj(
+                    {1.0f / halfSize, 0.0f, 0.0f, 0.0f},
+                    {0.0f, 1.0f / halfSize, 0.0f, 0.0f},
+                    {0.0f, 0.0f, 1.0f / worldSize, 0.0f},
+                    {-c.x / halfSize, -c.y / halfSize, 0.0f, 1.0f}
+                );
+                frustums.emplace_back(viewProj);
+                regions.emplace_back(Vector3(c.x - halfSize, c.y - halfSize, 0.0f), Vector3(c.x + halfSize, c.y + halfSize, worldSize));
+            }
+
+            uint32_t query = 0;
+            uint32_t hits = 0;
+            runner.run(fmt::format("bvh/{}/query frustum", count), 1, [&] {
+                tree.query(frustums[query++ % TREE_QUERIES], [&](DynamicTree::Key) { hits++; return true; });
+            });
+
+            runner.run(fmt::format("bvh/{}/query box", count), 1, [&] {
+                tree.query(regions[query++ % TREE_QUERIES], [&](DynamicTree::Key) { hits++; return true; });
+            });
+
+            // Baseline without the tree
+            runner.run(fmt::format("bvh/{}/linear frustum", count), 1, [&] {
+                const Frustum& frustum = frustums[query++ % TREE_QUERIES];
+                for (auto& box : boxes)
+                    hits += frustum.intersects(box);
+            });
+
+            doNotOptimize(hits);
+        }
+
+        /**
+         * @brief Groups of children under named roots, like a scene where prefabs repeat child names
+         */
+        std::vector<EntityHandle> makeScene(entt::registry& registry) {
+            std::mt19937 generator(11);
+            std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+
+            std::vector<EntityHandle> entities;
+            entities.reserve(SCENE_ENTITIES);
+
+            uint32_t childrenPerGroup = SCENE_ENTITIES / SCENE_GROUPS - 1;
+            for (uint32_t g = 0; g < SCENE_GROUPS; ++g) {
+                EntityHandle group(&registry, registry.create());
+                group.setName(fmt::format("Group {}", g));
+                group.addComponent<Transform>(Vector3(value(generator), 0.0f, value(generator)), Vector3(1.0f), Vector3(0.0f));
+                entities.push_back(group);
+
+                for (uint32_t c = 0; c < childrenPerGroup; ++c) {
+                    EntityHandle child(&registry, registry.create());
+                    child.setName(fmt::format("Child {}", c));
+                    child.addComponent<Transform>(Vector3(value(generator), value(generator), value(generator)), Vector3(1.0f), Vector3(0.0f, value(generator), 0.0f));
+                    child.setParent(group);
+                    entities.push_back(child);
+                }
+            }
+
+            return entities;
+        }
+
+        void nameBenchmarks(Runner& runner) {
+            if (!runner.enabledGroup("names/")) return;
+
+            entt::registry registry;
+            NameIndex index;
+            index.connect(registry);
+            std::vector<EntityHandle> entities = makeScene(registry);
+
+            std::mt19937 generator(13);
+            std::uniform_int_distribution<uint32_t> entity(0, static_cast<uint32_t>(entities.size() - 1));
+
+            std::vector<std::string> names;
+            std::vector<std::string> paths;
+            for (uint32_t i = 0; i < NAME_QUERIES; ++i) {
+                EntityHandle handle = entities[entity(generator)];
+                names.push_back(handle.getName());
+
+                EntityHandle parent = handle.getParent();
+                paths.push_back(parent ? parent.getName() + NameIndex::PATH_SEPARATOR + handle.getName() : handle.getName());
+            }
+
+            bool found = true;
+            runner.run(fmt::format("names/{}/NameIndex::find", entities.size()), NAME_QUERIES, [&] {
+                for (auto& name : names)
+                    found &= index.find(registry, name) != entt::null;
+            });
+
+            runner.run(fmt::format("names/{}/NameIndex::findPath", entities.size()), NAME_QUERIES, [&] {
+                for (auto& path : paths)
+                    found &= index.findPath(registry, path) != entt::null;
+            });
+
+            // Baseline, what Scene::getEntity did before the index
+            uint32_t query = 0;
+            runner.run(fmt::format("names/{}/linear find", entities.size()), 1, [&] {
+                const std::string& name = names[query++ % NAME_QUERIES];
+                auto view = registry.view<Name>();
+                found &= std::find_if(view.begin(), view.end(), [&](auto id) { return view.get<Name>(id).name == name; }) != view.end();
+            });
+
+            runner.check("names/NameIndex finds every name and path", found);
+        }
+
+        void saveJson(entt::registry& registry, const std::vector<EntityHandle>& entities, const std::filesystem::path& file) {
+            std::unordered_map<id_t, uint32_t> indices;
+            for (uint32_t i = 0; i < entities.size(); ++i)
+                indices[entities[i].getId()] = i;
+
+            json scene;
+            auto& sceneEntities = scene["entities"] = json::array();
+            for (auto& entity : entities) {
+                json entityJson = entity.serialize();
+
+                if (auto parent = entity.getParent(); parent && indices.contains(parent.getId()))
+                    entityJson["parent"] = indices[parent.getId()];
+
+                sceneEntities.push_back(entityJson);
+            }
+
+            File(file).write(scene);
+        }
+
+        std::vector<EntityHandle> loadJson(entt::registry& registry, const std::filesystem::path& file) {
+            json scene;
+            File(file).read(scene);
+
+            std::vector<EntityHandle> entities;
+            for (auto& entityJson : scene["entities"]) {
+                EntityHandle entity(&registry, registry.create());
+                entity.serialize(entityJson);
+                entities.push_back(entity);
+            }
+
+            for (size_t i = 0; i < entities.size(); ++i) {
+                auto& entityJson = scene["entities"][i];
+                if (entityJson.contains("parent"))
+                    entities[i].setParent(entities[entityJson["parent"].get<uint32_t>()]);
+            }
+
+            return entities;
+        }
+
+        /**
+         * @brief Same scene through the binary format and through the JSON format of Scene::save. Load times
+         * include creating and destroying the registry.
+         */
+        void sceneFormatBenchmarks(Runner& runner) {
+            if (!runner.enabledGroup("scene/")) return;
+
+            entt::registry registry;
+            std::vector<EntityHandle> entities = makeScene(registry);
+
+            std::filesystem::path directory = std::filesystem::temp_directory_path() / "RavenEngineBench";
+            std::filesystem::create_directories(directory);
+            std::filesystem::path binaryFile = directory / (std::string("scene") + SceneFormat::EXTENSION);
+            std::filesystem::path jsonFile = directory / "scene.json";
+
+            runner.run(fmt::format("scene/{}/binary save", entities.size()), entities.size(), [&] {
+                SceneFormat::write(registry, entities, binaryFile);
+            });
+
+            runner.run(fmt::format("scene/{}/json save", entities.size()), entities.size(), [&] {
+                saveJson(registry, entities, jsonFile);
+            });
+
+            if (!std::filesystem::exists(binaryFile)) SceneFormat::write(registry, entities, binaryFile);
+            if (!std::filesystem::exists(jsonFile)) saveJson(registry, entities, jsonFile);
+
+            std::string binaryLoad = fmt::format("scene/{}/binary load", entities.size());
+            runner.run(binaryLoad, entities.size(), [&] {
+                entt::registry loaded;
+                doNotOptimize(SceneFormat::read(loaded, binaryFile).size());
+            });
+
+            std::string jsonLoad = fmt::format("scene/{}/json load", entities.size());
+            runner.run(jsonLoad, entities.size(), [&] {
+                entt::registry loaded;
+                doNotOptimize(loadJson(loaded, jsonFile).size());
+            });
+
+            entt::registry loaded;
+            runner.check("scene/binary round trip", SceneFormat::read(loaded, binaryFile).size() == entities.size() &&
+                         loaded.view<Transform>().size() == entities.size());
+
+            // Header of five uint32_t, then the string lengths. Huge counts must be rejected before allocating.
+            auto rejectsPatch = [&](std::streamoff offset) {
+                std::filesystem::path patched = directory / (std::string("patched") + SceneFormat::EXTENSION);
+                std::filesystem::copy_file(binaryFile, patched, std::filesystem::copy_options::overwrite_existing);
+
+                std::fstream file(patched, std::ios::binary | std::ios::in | std::ios::out);
+                const uint32_t huge = 0xFFFFFF00;
+                file.seekp(offset);
+                file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+                file.close();
+
+                try {
+                    entt::registry malformed;
+                    SceneFormat::read(malformed, patched);
+                } catch (const std::runtime_error&) {
+                    return true;
+                }
+
+                return false;
+            };
+            runner.check("scene/binary rejects huge string counts and lengths", rejectsPatch(12) && rejectsPatch(20));
+
+            // A lone header, valid except for an entity count the empty file can't hold
+            auto rejectsHeader = [&] {
+                std::filesystem::path truncated = directory / (std::string("truncated") + SceneFormat::EXTENSION);
+                const uint32_t header[] = {SceneFormat::MAGIC, SceneFormat::VERSION, 0xFFFFFF00, 0, 0};
+                std::ofstream(truncated, std::ios::binary).write(reinterpret_cast<const char*>(header), sizeof(header));
+
+                try {
+                    entt::registry malformed;
+                    SceneFormat::read(malformed, truncated);
+                } catch (const std::runtime_error&) {
+                    return true;
+                }
+
+                return false;
+            };
+            runner.check("scene/binary rejects huge entity counts", rejectsPatch(8) && rejectsHeader());
+
+            fmt::print("scene/file sizes: binary {} bytes, json {} bytes\n", std::filesystem::file_size(binaryFile), std::filesystem::file_size(jsonFile));
+
+            std::filesystem::remove_all(directory);
+        }
+
+        /**
+         * @brief Every link of every Hierarchy points to a living entity that links back, and depths and child
+         * counts match the links
+         */
+        bool validHierarchies(entt::registry& registry) {
+            auto view = registry.view<Hierarchy>();
+            for (auto id : view) {
+                auto& node = view.get<Hierarchy>(id);
+                auto linked = [&](entt::entity other) { return other == entt::null || registry.all_of<Hierarchy>(other); };
+                if (!linked(node.parent) || !linked(node.firstChild) || !linked(node.nextSibling) || !linked(node.prevSibling))
+                    return false;
+
+                if (node.depth != (node.parent == entt::null ? 0 : registry.get<Hierarchy>(node.parent).depth + 1))
+                    return false;
+
+                uint32_t children = 0;
+                entt::entity prev = entt::null;
+                for (auto child = node.firstChild; child != entt::null; child = registry.get<Hierarchy>(child).nextSibling) {
+                    auto& childNode = registry.get<Hierarchy>(child);
+                    if (childNode.parent != id || childNode.prevSibling != prev) return false;
+
+                    prev = child;
+                    children++;
+                }
+
+                if (children != node.childCount || prev != node.lastChild) return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Children appended to a single root, like a flat scene file where every entity is under the root
+         */
+        void flatHierarchyBenchmark(Runner& runner) {
+            runner.run(fmt::format("hierarchy/{}/setParent under one root", HIERARCHY_CHILDREN), HIERARCHY_CHILDREN, [&] {
+                entt::registry registry;
+                EntityHandle root(&registry, registry.create());
+
+                for (uint32_t c = 0; c < HIERARCHY_CHILDREN; ++c)
+                    EntityHandle(&registry, registry.create()).setParent(root);
+
+                doNotOptimize(root.getComponent<Hierarchy>().childCount);
+            });
+        }
+
+        /**
+         * @brief Destroy a middle child and a parent with the command buffer, and a parent directly through the
+         * registry, then update the transforms, which walks the hierarchy from the dirty roots
+         */
+        void destroyChecks(Runner& runner) {
+            Scene scene;
+            auto& registry = scene.getRegistry();
+            auto addChild = [](const EntityHandle& parent, const std::string& name) {
+                EntityHandle child = parent.addChild(name);
+                child.addComponent<Transform>(Vector3(1.0f), Vector3(1.0f), Vector3(0.0f));
+                return child;
+            };
+
+            std::vector<EntityHandle> roots;
+            std::vector<std::vector<EntityHandle>> children;
+            std::vector<std::vector<EntityHandle>> grandchildren;
+            for (const char* name : {"Kept", "Destroyed", "Direct"}) {
+                EntityHandle root = scene.addEntity(name);
+                root.addComponent<Transform>(Vector3(0.0f), Vector3(1.0f), Vector3(0.0f));
+                roots.push_back(root);
+
+                auto& list = children.emplace_back();
+                auto& grandList = grandchildren.emplace_back();
+                for (uint32_t c = 0; c < 3; ++c) {
+                    list.push_back(addChild(root, fmt::format("Child {}", c)));
+                    grandList.push_back(addChild(list.back(), "Grandchild"));
+                }
+            }
+
+            scene.getCommands().destroy(children[0][1].getId());
+            scene.getCommands().destroy(roots[1].getId());
+            scene.playbackCommands();
+            registry.destroy(roots[2].getId());
+
+            roots[0].getComponent<Transform>().markDirty();
+            scene.updateTransforms();
+
+            bool middleUnlinked = roots[0].getChildren() == std::vector<EntityHandle>{children[0][0], children[0][2]} &&
+                                  !children[0][1] && !grandchildren[0][1];
+            bool subtreeDestroyed = !roots[1] && std::none_of(children[1].begin(), children[1].end(), [](auto& child) { return child.valid(); }) &&
+                                    std::none_of(grandchildren[1].begin(), grandchildren[1].end(), [](auto& child) { return child.valid(); });
+            bool orphansAreRoots = !roots[2] && std::all_of(children[2].begin(), children[2].end(), [](const EntityHandle& child) {
+                return child.valid() && !child.getParent() && child.getComponent<Hierarchy>().depth == 0;
+            }) && grandchildren[2][0].getComponent<Hierarchy>().depth == 1;
+
+            runner.check("hierarchy/destroy unlinks parents and children", validHierarchies(registry) && middleUnlinked &&
+                         subtreeDestroyed && orphansAreRoots, fmt::format("{} entities left", registry.view<Hierarchy>().size()));
+        }
+
+        void hierarchyBenchmarks(Runner& runner) {
+            if (!runner.enabledGroup("hierarchy/")) return;
+
+            flatHierarchyBenchmark(runner);
+            destroyChecks(runner);
+        }
+
+        /**
+         * @brief Record from several threads that take elements from a shared counter, with staggered starts,
+         * so which thread records each element and which buffer is created first change between runs. Every
+         * element creates a named entity and appends its index to the name of a log entity under its own sort
+         * key, so the entity ids and the log only match between runs if playback order is deterministic.
+         */
+        void commandChecks(Runner& runner) {
+            if (!runner.enabledGroup("commands/")) return;
+
+            std::string log;
+            auto recordRun = [&](uint32_t run) {
+                Scene scene;
+                id_t logId = scene.addEntity("").getId();
+                auto append = [logId](EntityCommandBuffer& buffer, const std::string& text) {
+                    buffer.patch<Name>(logId, [text](Name& name) { name.name += text; });
+                };
+
+                std::atomic<uint32_t> next{0};
+                std::vector<std::thread> threads;
+                for (uint32_t t = 0; t < COMMAND_THREADS; ++t) {
+                    threads.emplace_back([&, t] {
+                        std::this_thread::sleep_for(std::chrono::microseconds((t + run) % COMMAND_THREADS * 100));
+
+                        EntityCommandBuffer& buffer = scene.getCommands();
+                        for (uint32_t i; (i = next.fetch_add(1)) < COMMAND_ELEMENTS;) {
+                            EntityCommandBuffer::SortKey key(buffer, i + 1);
+                            auto entity = buffer.create();
+                            buffer.addComponent<Name>(entity, fmt::format("Element {}", i));
+                            append(buffer, fmt::format("{},", i));
+                        }
+                    });
+                }
+
+                for (auto& thread : threads)
+                    thread.join();
+
+                // The scope restores key 0, so the second command is applied before every element
+                EntityCommandBuffer& buffer = scene.getCommands();
+                {
+                    EntityCommandBuffer::SortKey key(buffer, COMMAND_ELEMENTS + 1);
+                    append(buffer, "last");
+                }
+                append(buffer, "first,");
+                scene.playbackCommands();
+
+                std::vector<std::pair<id_t, std::string>> state;
+                for (auto id : scene.getRegistry().view<Name>())
+                    state.emplace_back(id, scene.getRegistry().get<Name>(id).name);
+                std::sort(state.begin(), state.end());
+
+                log = scene.getRegistry().get<Name>(logId).name;
+                return state;
+            };
+
+            auto first = recordRun(0);
+            std::string expected = "first,";
+            for (uint32_t i = 0; i < COMMAND_ELEMENTS; ++i)
+                expected += fmt::format("{},", i);
+            expected += "last";
+            bool ordered = log == expected;
+
+            uint32_t different = 0;
+            for (uint32_t run = 1; run < COMMAND_RUNS; ++run) {
+                different += recordRun(run) != first;
+                ordered &= log == expected;
+            }
+
+            runner.check("commands/playback doesn't depend on the recording threads", different == 0,
+                         fmt::format("{} of {} runs differ from the first", different, COMMAND_RUNS - 1));
+            runner.check("commands/sort keys order playback and are restored after their scope", ordered);
+        }
+
+    } // namespace
+
+    void sceneBenchmarks(Runner& runner) {
+        for (auto count : TREE_SIZES)
+            treeBenchmarks(runner, count);
+
+        nameBenchmarks(runner);
+        sceneFormatBenchmarks(runner);
+        hierarchyBenchmarks(runner);
+        commandChecks(runner);
+    }
+
+} // namespace re::bench
@@ -0,0 +1,38 @@
+#include <iostream>
+
+#include "CLI/App.hpp"
+#include "CLI/Formatter.hpp"
+#include "CLI/Config.hpp"
+
+#include "Bench.hpp"
+
+
+int main(int argc, char** arg) {
+    CLI::App app("RavenEngine benchmarks");
+
+    std::string filter;
+    std::string jsonFile;
+    double minTime = 0.1;
+    app.add_option("--filter", filter, "Only run benchmarks whose name starts with this text");
+    app.add_option("--json", jsonFile, "Write the results to a JSON file");
+    app.add_option("--min-time", minTime, "Minimum duration of a sample in seconds");
+
+    CLI11_PARSE(app, argc, arg);
+
+    try {
+        re::bench::Runner runner(filter, minTime);
+
+        re::bench::mathBenchmarks(runner);
+        re::bench::sceneBenchmarks(runner);
+        re::bench::renderBenchmarks(runner);
+        re::bench::recordBenchmarks(runner);
+
+        if (!jsonFile.empty()) runner.writeJson(jsonFile);
+
+        return runner.failed() ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    return 1;
+}
@@ -1,6 +1,8 @@
 #include "Editor.hpp"
 
-#include "engine/entity/Entity.hpp"
+#include <algorithm>
+
+#include "engine/entity/EntityHandle.hpp"
 #include "engine/render/ui/ImElements.hpp"
 
 
@@ -8,9 +10,10 @@ namespace re {
 
     Editor::Editor() : Application("Raven Engine Editor") {
         std::shared_ptr<Scene> scene = std::make_shared<Scene>();
-        camera = std::make_shared<Entity>("Camera", scene->getRegistry().create(), scene.get());
-        camera->addComponent<Transform>(Vector3{}, Vector3{1.0f}, Vector3{});
-        camera->addComponent<Camera>(Math::deg2rad(45.0f), 0.01f, 100.0f, cameraTarget);
+        // The editor camera has no Name, so it isn't listed in the inspector nor saved with the scene
+        camera = EntityHandle(&scene->getRegistry(), scene->getRegistry().create());
+        camera.addComponent<Transform>(Vector3{}, Vector3{1.0f}, Vector3{});
+        camera.addComponent<Camera>(Math::deg2rad(45.0f), 0.01f, 100.0f, cameraTarget);
         scene->setMainCamera(camera);
         engine->setScene(scene);
 
@@ -19,7 +22,6 @@ namespace re {
     }
 
     void Editor::setup() {
-        AssetsManager::getInstance()->setupDescriptorsPool(engine->getRenderer().getImageCount());
         std::unique_ptr<RenderSystem> renderSystem = std::make_unique<RenderSystem>(engine->getRenderer().getDevice(), engine->getRenderer().getRenderPass(), "model");
         engine->setRenderSystem(std::move(renderSystem));
 
@@ -101,6 +103,54 @@ namespace re {
     void Editor::miscPanel() {
         miscWindow.draw([&, this]{
             scenePanelSize.y = ImGui::GetWindowPos().y;
+
+            if (auto* renderSystem = engine->getRenderSystem()) {
+                auto& stats = renderSystem->getStats();
+                ImGui::Text("Draw calls: %u Command buffers: %u", stats.drawCalls, stats.commandBuffers);
+                ImGui::Text("Packets: %u", stats.packets);
+                ImGui::Text("Instances: %u", stats.instances);
+                ImGui::Text("Visible: %u Culled: %u Occluded: %u", stats.visible, stats.culled, stats.occluded);
+                ImGui::Text("Occluder triangles: %u", stats.occluderTriangles);
+                ImGui::Text("State changes: %u (unsorted %u)", stats.stateChanges.total(), stats.unsortedStateChanges.total());
+                ImGui::Text("Descriptor sets: %u (unsorted %u) Push constants: %u (unsorted %u)",
+                            stats.stateChanges.descriptorSets, stats.unsortedStateChanges.descriptorSets,
+                            stats.stateChanges.pushConstants, stats.unsortedStateChanges.pushConstants);
+                ImGui::Text("Cull time: %.3f ms", stats.cullTime);
+                ImGui::Text("Extract time: %.3f ms", stats.extractTime);
+                ImGui::Text("Record time: %.3f ms", stats.recordTime);
+            }
+
+            systemsTrace();
         });
     }
+
+    /**
+     * @brief Timeline of the systems run in the last frame, one row per system with its dependency level
+     */
+    void Editor::systemsTrace() {
+        auto& scheduler = engine->getScheduler();
+        float frameTime = std::max(scheduler.getFrameTime(), 0.001f);
+
+        ImGui::Separator();
+        ImGui::Text("Systems: %.3f ms, %u levels", scheduler.getFrameTime(), scheduler.getLevelCount());
+
+        const float labelWidth = 220.0f;
+        float barWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+        float rowHeight = ImGui::GetTextLineHeight();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        for (auto& trace : scheduler.getTrace()) {
+            ImGui::Text("L%u %s%s", trace.level, trace.name.c_str(), trace.mainThread ? " (main)" : "");
+            ImGui::SameLine(labelWidth);
+
+            ImVec2 position = ImGui::GetCursorScreenPos();
+            float begin = position.x + barWidth * trace.start / frameTime;
+            float end = std::max(begin + 1.0f, position.x + barWidth * (trace.start + trace.duration) / frameTime);
+            drawList->AddRectFilled({begin, position.y}, {end, position.y + rowHeight}, IM_COL32(90, 160, 230, 255));
+
+            ImGui::Dummy({barWidth, rowHeight});
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s: %.3f ms, %u dependencies", trace.name.c_str(), trace.duration, trace.dependencies);
+        }
+    }
 }
@@ -29,7 +29,9 @@ namespace re {
 
         void miscPanel();
 
-        std::shared_ptr<Entity> camera;
+        void systemsTrace();
+
+        EntityHandle camera;
         std::unique_ptr<SceneInspector> sceneInspector;
         std::unique_ptr<ElementInspector> elementInspector;
         float mainMenuHeight{22.0f};
@@ -1,9 +1,11 @@
 #include "ElementInspector.hpp"
 
+#include <array>
+
 #include "nameof.hpp"
 
-#include "engine/entity/Entity.hpp"
-#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "engine/entity/ComponentRegistry.hpp"
 #include "engine/render/ui/ImElements.hpp"
 
 
@@ -12,31 +14,70 @@ namespace re {
     // TODO: Change for use T element instead hardcode the type
     ElementInspector::ElementInspector() = default;
 
-    void ElementInspector::setEntity(std::shared_ptr<Entity> newEntity) {
-        element = std::move(newEntity);
+    void ElementInspector::setEntity(EntityHandle newEntity) {
+        element = newEntity;
     }
 
     void ElementInspector::showEntityData() {
         if (element) {
-            ui::imText("ID {}", element->getId());
-            element->setName(ui::imInputText("Name", element->getName()));
+            ui::imText("ID {}", entt::to_integral(element.getId()));
+            element.setName(ui::imInputText("Name", element.getName()));
             componentsInfo();
         }
     }
 
-    void ElementInspector::componentsInfo() {
-        ui::imCollapsingHeader(NAMEOF_SHORT_TYPE(Transform).data(), [&, this]{
-            auto& transform = element->getComponent<Transform>();
+    namespace {
 
-            ui::imInputVec3("Position", transform.position);
+        void inspectComponent(Transform& transform) {
+            vec3d position = transform.getPosition();
+            if (ui::imInputVec3("Position", position)) transform.setPosition(position);
 
-            vec3 rotate = transform.rotation.getAngles();
+            vec3 rotate = transform.getRotation().getAngles();
             vec3 angles = {rotate.z, rotate.x, rotate.y};
-            ui::imInputVec3("Rotation", angles);
-            transform.rotation = quat(Vector3{angles.y, angles.z, angles.x});
+            if (ui::imInputVec3("Rotation", angles)) transform.setRotation(quat(Vector3{angles.y, angles.z, angles.x}));
+
+            vec3 scale = transform.getScale();
+            if (ui::imInputVec3("Scale", scale)) transform.setScale(scale);
+        }
+
+        void inspectComponent(MeshRender& meshRender) {
+            ui::imText("Model {}", meshRender.model ? meshRender.model->getName() : "Loading");
+            ImGui::Checkbox("Occluder", &meshRender.occluder);
+        }
+
+        void inspectComponent(Camera& camera) {
+            float fov = Math::rad2deg(camera.fov);
+            if (ImGui::InputFloat("FOV", &fov)) camera.fov = Math::deg2rad(fov);
+
+            ImGui::InputFloat("Near", &camera.zNear);
+            ImGui::InputFloat("Far", &camera.zFar);
+            ui::imInputVec3("Target", camera.target);
+        }
+
+        void inspectComponent(Light& light) {
+            ImGui::ColorEdit3("Color", light.color.values);
+            ImGui::InputFloat("Ambient", &light.ambient);
+        }
+
+        using Inspector = void (*)(EntityHandle entity);
+
+        // One inspector per registered component, generated from the same list as the serializers
+        template<typename ...T>
+        std::array<Inspector, sizeof...(T)> makeInspectors(ComponentList<T...>) {
+            return {[](EntityHandle entity) {
+                if (auto* component = entity.tryGetComponent<T>()) {
+                    ui::imCollapsingHeader(std::string(NAMEOF_SHORT_TYPE(T)), [&]{ inspectComponent(*component); });
+                }
+            }...};
+        }
+
+    } // namespace
+
+    void ElementInspector::componentsInfo() {
+        static const auto inspectors = makeInspectors(SerializedComponents{});
 
-            ui::imInputVec3("Scale", transform.scale);
-        });
+        for (auto inspector : inspectors)
+            inspector(element);
     }
 
 } // namespace re
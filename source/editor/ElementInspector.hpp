@@ -2,18 +2,16 @@
 #define RAVENENGINE_ELEMENTINSPECTOR_HPP
 
 
-#include <memory>
+#include "engine/entity/EntityHandle.hpp"
 
 
 namespace re {
 
-    class Entity;
-
     class ElementInspector {
     public:
         ElementInspector();
 
-        void setEntity(std::shared_ptr<Entity> newEntity);
+        void setEntity(EntityHandle newEntity);
 
         void showEntityData();
 
@@ -22,7 +20,7 @@ namespace re {
 
         void componentsInfo();
 
-        std::shared_ptr<Entity> element;
+        EntityHandle element;
     };
 
 } // namespace re
@@ -1,7 +1,7 @@
 #include "SceneInspector.hpp"
 
 #include "engine/scene/Scene.hpp"
-#include "engine/entity/Entity.hpp"
+#include "engine/entity/EntityHandle.hpp"
 #include "engine/entity/components/Transform.hpp"
 #include "engine/render/ui/ImElements.hpp"
 
@@ -18,13 +18,14 @@ namespace re {
             popupContext();
         });
 
-        for (auto& entity : scene->getEntities()) {
-            showEntityTree(entity);
+        // Children are drawn by their parents
+        for (auto entity : scene->getEntities()) {
+            if (!entity.getParent()) showEntityTree(entity);
         }
     }
 
-    void SceneInspector::showEntityTree(const std::shared_ptr<Entity>& entity) {
-        bool nodeOpen = ui::imTreeNodeEx(entity->getName(), ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick);
+    void SceneInspector::showEntityTree(EntityHandle entity) {
+        bool nodeOpen = ui::imTreeNodeEx(entity.getName(), ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick);
 
         ui::imPopupContextItem([&, this]{
             popupContext(entity);
@@ -33,26 +34,26 @@ namespace re {
         if (ui::imIsClicked()) selectedEntity = entity;
 
         if (nodeOpen) {
-            for (auto& child : entity->getChildren()) {
+            for (auto child : entity.getChildren()) {
                 showEntityTree(child);
             }
             ImGui::TreePop();
         }
     }
 
-    std::shared_ptr<Entity> SceneInspector::getSelectedEntity() {
+    EntityHandle SceneInspector::getSelectedEntity() {
         return selectedEntity;
     }
 
-    void SceneInspector::popupContext(const std::shared_ptr<Entity> &entity) {
+    void SceneInspector::popupContext(EntityHandle entity) {
         ui::imSelectable("Add Entity", [&, this]{ addEntity(entity); });
     }
 
-    void SceneInspector::addEntity(const std::shared_ptr<Entity>& entity) {
+    void SceneInspector::addEntity(EntityHandle entity) {
         if (entity) {
-            entity->addChild("Entity")->addComponent<Transform>(vec3{}, vec3{}, vec3{});
+            entity.addChild("Entity").addComponent<Transform>(vec3{}, vec3{}, vec3{});
         } else {
-            scene->addEntity("Entity")->addComponent<Transform>(vec3{}, vec3{}, vec3{});
+            scene->addEntity("Entity").addComponent<Transform>(vec3{}, vec3{}, vec3{});
         }
     }
 
@@ -4,11 +4,12 @@
 
 #include <memory>
 
+#include "engine/entity/EntityHandle.hpp"
+
 
 namespace re {
 
     class Scene;
-    class Entity;
 
     class SceneInspector {
     public:
@@ -16,17 +17,17 @@ namespace re {
 
         void drawScene();
 
-        std::shared_ptr<Entity> getSelectedEntity();
+        EntityHandle getSelectedEntity();
 
     private:
-        void showEntityTree(const std::shared_ptr<Entity>& entity);
+        void showEntityTree(EntityHandle entity);
 
-        void popupContext(const std::shared_ptr<Entity>& entity = nullptr);
+        void popupContext(EntityHandle entity = {});
 
-        void addEntity(const std::shared_ptr<Entity>& entity = nullptr);
+        void addEntity(EntityHandle entity = {});
 
         std::shared_ptr<Scene> scene;
-        std::shared_ptr<Entity> selectedEntity;
+        EntityHandle selectedEntity;
     };
 
 } // namespace re
@@ -1,9 +1,18 @@
 #include "Asset.hpp"
 
+#include <atomic>
+
 
 namespace re {
 
-    Asset::Asset(std::string name, Type type) : name(std::move(name)), type(type) {
+    namespace {
+
+        // Next id of each asset type, indexed by Asset::Type. Assets can be loaded from jobs.
+        std::atomic<uint32_t> nextIds[Asset::MATERIAL + 1];
+
+    } // namespace
+
+    Asset::Asset(std::string name, Type type) : type(type), name(std::move(name)), id(nextIds[type]++) {
 
     }
 
@@ -11,5 +20,13 @@ namespace re {
         return name;
     }
 
+    /**
+     *
+     * @return Sequential id among the assets of the same type, small enough to be packed in render sort keys
+     */
+    uint32_t Asset::getId() const {
+        return id;
+    }
+
 } // namespace re
 
@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <cstdint>
 
 #include "engine/core/NonCopyable.hpp"
 
@@ -22,10 +23,15 @@ namespace re {
 
         [[nodiscard]] std::string getName() const;
 
+        [[nodiscard]] uint32_t getId() const;
+
         const Type type;
 
     protected:
         std::string name;
+
+    private:
+        uint32_t id;
     };
 
 } // namespace re
@@ -1,11 +1,13 @@
 #include "AssetsManager.hpp"
 
 #include "Model.hpp"
+#include "Mesh.hpp"
 #include "Texture.hpp"
 #include "Material.hpp"
 #include "engine/render/Device.hpp"
 #include "engine/core/Utils.hpp"
 #include "engine/render/buffers/Buffer.hpp"
+#include "engine/render/buffers/GeometryPool.hpp"
 #include "engine/scene/Skybox.hpp"
 
 
@@ -19,6 +21,7 @@ namespace re {
      * @param device Pointer to Device object
      */
     AssetsManager::AssetsManager(std::shared_ptr<Device> device) : device(std::move(device)) {
+        geometryPool = std::make_unique<GeometryPool>(this->device, sizeof(Mesh::Vertex), MAX_POOL_VERTICES, MAX_POOL_INDICES);
         add<Texture>("empty", this->device, "empty.png", Texture::Sampler{});
     }
 
@@ -59,4 +62,12 @@ namespace re {
         return device;
     }
 
+    /**
+     *
+     * @return Geometry pool shared by all meshes
+     */
+    GeometryPool& AssetsManager::getGeometryPool() {
+        return *geometryPool;
+    }
+
 } // namespace re
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace re {
     class Material;
     class Skybox;
     class Asset;
+    class GeometryPool;
 
     enum DescriptorSetType {
         UBO = 1,
@@ -51,6 +52,12 @@ namespace re {
 
         std::shared_ptr<Device> getDevice();
 
+        GeometryPool& getGeometryPool();
+
+    public:
+        static constexpr uint32_t MAX_POOL_VERTICES = 1 << 20;
+        static constexpr uint32_t MAX_POOL_INDICES = 1 << 22;
+
     private:
         AssetsManager() = default;
 
@@ -58,6 +65,7 @@ namespace re {
         static AssetsManager* singleton;
         VkDescriptorPool descriptorPool{};
         std::shared_ptr<Device> device;
+        std::unique_ptr<GeometryPool> geometryPool;
         std::unordered_map<DescriptorSetType, VkDescriptorSetLayout> layouts;
         std::unordered_map<uint32_t, Asset*> assets;
     };
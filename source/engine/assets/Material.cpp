@@ -39,4 +39,28 @@ namespace re {
 
     Material::~Material() = default;
 
+    /**
+     * @brief Bind material descriptor set(set 1) and pass material parameters as push constants
+     * @param commandBuffer Valid Command buffer in recording state
+     * @param layout Pipeline layout
+     */
+    void Material::bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout) const {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &descriptorSet, 0, nullptr);
+
+        PushConstantBlock pushConstBlock = getPushConstants();
+        vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, PUSH_CONSTANTS_SIZE, &pushConstBlock);
+    }
+
+    /**
+     *
+     * @return Material parameters as passed to the fragment shader, materials with equal blocks can share the push
+     */
+    Material::PushConstantBlock Material::getPushConstants() const {
+        PushConstantBlock pushConstBlock{};
+        auto texture = textures.find(BASE);
+        pushConstBlock.colorTextureSet = texture != textures.end() && texture->second ? texCoordSets.baseColor : -1;
+        pushConstBlock.baseColorFactor = baseColorFactor;
+        return pushConstBlock;
+    }
+
 } // namespace re
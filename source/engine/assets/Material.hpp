@@ -3,6 +3,7 @@
 
 
 #include <memory>
+#include <cstddef>
 
 #include "vulkan/vulkan.h"
 #include "tiny_gltf.h"
@@ -36,13 +37,22 @@ namespace re {
         struct PushConstantBlock {
             vec4 baseColorFactor;
             int colorTextureSet;
+
+            bool operator==(const PushConstantBlock& block) const = default;
         };
 
+        // Bytes of PushConstantBlock declared by model.frag, without the tail padding of the aligned vec4
+        static constexpr uint32_t PUSH_CONSTANTS_SIZE = offsetof(PushConstantBlock, colorTextureSet) + sizeof(int);
+
     public:
         Material(std::string name, const tinygltf::Model& model, const tinygltf::Material& material);
 
         ~Material() override;
 
+        void bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout) const;
+
+        [[nodiscard]] PushConstantBlock getPushConstants() const;
+
     public:
         vec4 baseColorFactor{1.0f};
         std::unordered_map<TextureType, Texture*> textures;
@@ -5,7 +5,6 @@
 #include "Material.hpp"
 #include "AssetsManager.hpp"
 #include "engine/render/Device.hpp"
-#include "engine/render/buffers/Buffer.hpp"
 
 
 namespace re {
@@ -43,43 +42,66 @@ namespace re {
         const tinygltf::Mesh& mesh = model.meshes[node.mesh];
         Mesh::Data data = Mesh::loadMesh(model, mesh);
 
-        createVertexBuffer(data.vertices);
-        createIndexBuffer(data.indices);
+        vertexCount = data.vertices.size();
+        indexCount = data.indices.size();
+
+        auto allocation = AssetsManager::getInstance()->getGeometryPool().upload(data.vertices.data(), vertexCount, data.indices.data(), indexCount);
+        vertexOffset = allocation.vertexOffset;
+
         primitives = std::move(data.primitives);
+        for (auto& primitive : primitives)
+            primitive.firstIndex += allocation.firstIndex;
+
+        positionX.reserve(data.vertices.size());
+        positionY.reserve(data.vertices.size());
+        positionZ.reserve(data.vertices.size());
+        for (auto& vertex : data.vertices) {
+            positionX.push_back(vertex.position.x);
+            positionY.push_back(vertex.position.y);
+            positionZ.push_back(vertex.position.z);
+            bounds.expand(vertex.position);
+        }
+
+        indices = std::move(data.indices);
+
+        if (!bounds.empty()) {
+            sphere.center = bounds.center();
+            for (auto& vertex : data.vertices)
+                sphere.radius = std::fmax(sphere.radius, (vertex.position - sphere.center).length());
+        }
     }
 
     Mesh::~Mesh() = default;
 
     /**
-     * @brief Prepare Mesh to be used in Draw
+     * @brief Prepare Mesh to be used in Draw. Binds the geometry pool buffers shared by all meshes.
      * @param commandBuffer Valid Command buffer in recording state
      */
     void Mesh::bind(VkCommandBuffer commandBuffer) const {
-        VkBuffer buffers[] = { vertexBuffer->getBuffer() };
-        VkDeviceSize offsets[] = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
-        vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+        AssetsManager::getInstance()->getGeometryPool().bind(commandBuffer);
     }
 
     /**
      * @brief Draw Mesh
      * @param commandBuffer Valid Command buffer in recording state
+     * @param layout Pipeline layout used to bind material data
+     * @param instanceCount [Optional] Number of instances to draw
+     * @param firstInstance [Optional] Instance index of the first instance, used by the shader to read instance data
+     * @return Number of draw calls recorded
      */
-    void Mesh::draw(VkCommandBuffer commandBuffer, VkPipelineLayout layout) const {
+    uint32_t Mesh::draw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t instanceCount, uint32_t firstInstance) const {
+        uint32_t drawCalls = 0;
+
         for (auto& primitive : primitives) {
             if (primitive.indexCount > 0) {
-                Material& material = *primitive.material;
-                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &material.descriptorSet, 0, nullptr);
+                primitive.material->bind(commandBuffer, layout);
 
-                // Pass material parameters as push constants
-                Material::PushConstantBlock pushConstBlockMaterial{};
-                pushConstBlockMaterial.colorTextureSet = material.textures[Material::BASE] ? material.texCoordSets.baseColor : -1;
-                pushConstBlockMaterial.baseColorFactor = material.baseColorFactor;
-                vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstBlockMaterial), &pushConstBlockMaterial);
-
-                vkCmdDrawIndexed(commandBuffer, primitive.indexCount, 1, primitive.firstIndex, 0, 0);
+                vkCmdDrawIndexed(commandBuffer, primitive.indexCount, instanceCount, primitive.firstIndex, vertexOffset, firstInstance);
+                drawCalls++;
             }
         }
+
+        return drawCalls;
     }
 
     /**
@@ -98,6 +120,54 @@ namespace re {
         return indexCount;
     }
 
+    /**
+     *
+     * @return Primitives of the Mesh. First index is absolute inside the geometry pool.
+     */
+    const std::vector<Mesh::Primitive>& Mesh::getPrimitives() const {
+        return primitives;
+    }
+
+    /**
+     *
+     * @return Offset of the Mesh first vertex inside the geometry pool
+     */
+    int32_t Mesh::getVertexOffset() const {
+        return vertexOffset;
+    }
+
+    /**
+     *
+     * @return Bounding box of the Mesh vertices in Mesh space
+     */
+    const AABB& Mesh::getBounds() const {
+        return bounds;
+    }
+
+    /**
+     *
+     * @return Bounding sphere of the Mesh vertices in Mesh space, centered in the bounding box
+     */
+    const Sphere& Mesh::getSphere() const {
+        return sphere;
+    }
+
+    /**
+     *
+     * @return Vertex positions in Mesh space, getVertexCount values per array
+     */
+    math::PointArrays Mesh::getPositions() const {
+        return {positionX.data(), positionY.data(), positionZ.data()};
+    }
+
+    /**
+     *
+     * @return Triangle list indices, relative to the first vertex of the Mesh
+     */
+    const std::vector<uint32_t>& Mesh::getIndices() const {
+        return indices;
+    }
+
     // TODO: Disable some GLTF vertex attributes(Not used for now)
     /**
      * @brief Load Mesh Data from GLTF2 file
@@ -205,31 +275,4 @@ namespace re {
         return Data{vertices, indices, primitives};
     }
 
-    void Mesh::createVertexBuffer(const std::vector<Vertex> &vertices) {
-        vertexCount = vertices.size();
-        VkDeviceSize size = sizeof(vertices[0]) * vertexCount;
-
-        Buffer stagingBuffer(device->getAllocator(), size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-        stagingBuffer.map();
-        stagingBuffer.writeTo((void*)vertices.data());
-
-        vertexBuffer = std::make_unique<Buffer>(device->getAllocator(), size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
-
-        device->copyBuffer(stagingBuffer, *vertexBuffer, size);
-    }
-
-    void Mesh::createIndexBuffer(const std::vector<uint32_t>& indices) {
-        indexCount = indices.size();
-
-        VkDeviceSize size = sizeof(indices[0]) * indexCount;
-
-        Buffer stagingBuffer(device->getAllocator(), size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-        stagingBuffer.map();
-        stagingBuffer.writeTo((void*)indices.data());
-
-        indexBuffer = std::make_unique<Buffer>(device->getAllocator(), size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
-
-        device->copyBuffer(stagingBuffer, *indexBuffer, size);
-    }
-
 } // namespace lv
\ No newline at end of file
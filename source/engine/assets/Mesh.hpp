@@ -12,12 +12,13 @@
 #include "engine/math/Vector2.hpp"
 #include "engine/math/Vector3.hpp"
 #include "engine/math/Vector4.hpp"
+#include "engine/math/Bounds.hpp"
+#include "engine/math/Batch.hpp"
 
 
 namespace re {
 
     class Device;
-    class Buffer;
     class Material;
 
     class Mesh : public Asset {
@@ -54,26 +55,40 @@ namespace re {
 
         void bind(VkCommandBuffer commandBuffer) const;
 
-        void draw(VkCommandBuffer commandBuffer, VkPipelineLayout layout) const;
+        uint32_t draw(VkCommandBuffer commandBuffer, VkPipelineLayout layout, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
 
         [[nodiscard]] uint32_t getVertexCount() const;
 
         [[nodiscard]] uint32_t getIndexCount() const;
 
-        static Data loadMesh(const tinygltf::Model& input, const tinygltf::Mesh& mesh);
+        [[nodiscard]] const std::vector<Primitive>& getPrimitives() const;
 
-    private:
-        void createVertexBuffer(const std::vector<Vertex>& vertices);
+        [[nodiscard]] int32_t getVertexOffset() const;
+
+        [[nodiscard]] const AABB& getBounds() const;
+
+        [[nodiscard]] const Sphere& getSphere() const;
 
-        void createIndexBuffer(const std::vector<uint32_t>& indices);
+        [[nodiscard]] math::PointArrays getPositions() const;
+
+        [[nodiscard]] const std::vector<uint32_t>& getIndices() const;
+
+        static Data loadMesh(const tinygltf::Model& input, const tinygltf::Mesh& mesh);
 
     private:
         std::shared_ptr<Device> device;
-        std::unique_ptr<Buffer> vertexBuffer;
-        std::unique_ptr<Buffer> indexBuffer;
         std::vector<Primitive> primitives;
+        int32_t vertexOffset{};
         uint32_t vertexCount{};
         uint32_t indexCount{};
+        AABB bounds;
+        Sphere sphere;
+        // CPU copy of the geometry used by the occlusion culler, indices are relative to the Mesh first vertex.
+        // Positions are kept as structure of arrays for math::transformPoints.
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<uint32_t> indices;
     };
 
 } // namespace re
@@ -3,7 +3,7 @@
 #include "AssetsManager.hpp"
 #include "Texture.hpp"
 #include "Material.hpp"
-#include "engine/math/Basis.hpp"
+#include "engine/render/RenderPackets.hpp"
 #include "engine/core/Utils.hpp"
 #include "engine/files/FilesManager.hpp"
 #include "engine/logs/Logs.hpp"
@@ -16,13 +16,7 @@ namespace re {
      * @return Matrix4 of Node local space.
      */
     Matrix4 Model::Node::getLocalMatrix() const {
-        Basis rotationMatrix = Basis(rotation, scale);
-        return {
-                { rotationMatrix[0][0], rotationMatrix[1][0], rotationMatrix[2][0], 0.0f },
-                { rotationMatrix[0][1], rotationMatrix[1][1], rotationMatrix[2][1], 0.0f },
-                { rotationMatrix[0][2], rotationMatrix[1][2], rotationMatrix[2][2], 0.0f },
-                { translation.x, translation.y, translation.z, 1.0f }
-        };
+        return Matrix4::compose(translation, rotation, scale);
     }
 
     /**
@@ -53,16 +47,72 @@ namespace re {
                 const tinygltf::Node node = gltfModel.nodes[index];
                 loadNode(gltfModel, -1, node, index);
             }
+
+            // Node transforms are static, so their matrices are calculated once
+            nodeMatrices.resize(nodes.size());
+            invNodeMatrices.resize(nodes.size());
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                nodeMatrices[i] = calculateNodeMatrix(i);
+                invNodeMatrices[i] = nodeMatrices[i].affineInverted();
+            }
+
+            for (auto& node : nodes) {
+                if (!node.mesh) continue;
+
+                bounds.merge(node.mesh->getBounds().transformed(getNodeMatrix(node.index)));
+
+                auto& primitives = node.mesh->getPrimitives();
+                for (uint32_t i = 0; i < primitives.size(); ++i) {
+                    if (primitives[i].indexCount == 0) continue;
+
+                    draws.push_back({node.index, node.mesh, primitives[i].material, primitives[i].firstIndex,
+                                     primitives[i].indexCount, node.mesh->getVertexOffset(),
+                                     RenderPacket::makeSortKey(RenderPacket::MODEL_PIPELINE, primitives[i].material->getId(), node.mesh->getId(), i)});
+                }
+            }
         }
     }
 
+    /**
+     * @brief Model of geometry that is already loaded, without glTF nodes. Used by generated content and by the
+     * benchmarks of the render extraction, where the meshes and materials can be null.
+     * @param name Model name
+     * @param nodeMatrices Matrix of each node in Model space
+     * @param draws Draws grouped by node, sort keys included
+     * @param bounds Bounding box in Model space
+     */
+    Model::Model(std::string name, std::vector<Matrix4> nodeMatrices, std::vector<Draw> draws, const AABB& bounds)
+            : Asset(std::move(name), Type::MODEL), nodeMatrices(std::move(nodeMatrices)), draws(std::move(draws)), bounds(bounds) {
+        invNodeMatrices.resize(this->nodeMatrices.size());
+        for (size_t i = 0; i < this->nodeMatrices.size(); ++i)
+            invNodeMatrices[i] = this->nodeMatrices[i].affineInverted();
+    }
+
     Model::~Model() = default;
 
+    /**
+     *
+     * @param index Node index
+     * @return Node matrix in Model space, including its parents
+     */
+    const Matrix4& Model::getNodeMatrix(size_t index) const {
+        return nodeMatrices[index];
+    }
+
+    /**
+     *
+     * @param index Node index
+     * @return Inverse of the Node matrix in Model space
+     */
+    const Matrix4& Model::getNodeInverseMatrix(size_t index) const {
+        return invNodeMatrices[index];
+    }
+
     /**
      * @brief Calculate a Node matrix in Local Space with the parent matrix
      * @param index Node index
      */
-    Matrix4 Model::getNodeMatrix(size_t index) const {
+    Matrix4 Model::calculateNodeMatrix(size_t index) const {
         const Node& node = nodes[index];
         Matrix4 nodeMatrix = node.getLocalMatrix();
         int32_t parentIndex = node.parent;
@@ -80,16 +130,26 @@ namespace re {
      * @brief Prepare and use all necessary stuff to render Model
      * @param commandBuffer Valid Command Buffer in recording state
      * @param layout Valid Vulkan pipeline layout to send data to Shader
-     * @param ubo Model Ubo(Uniform Buffer Object) to save all Node data
+     * @param bindNode Called with the node matrix before each node is drawn. It must bind the node data and
+     * return false to stop rendering the remaining nodes.
+     * @param instanceCount [Optional] Number of instances to draw
+     * @param firstInstance [Optional] Instance index of the first instance
+     * @return Number of draw calls recorded
      */
-    void Model::render(VkCommandBuffer commandBuffer, VkPipelineLayout layout, Ubo& ubo) {
+    uint32_t Model::render(VkCommandBuffer commandBuffer, VkPipelineLayout layout, const std::function<bool(const Matrix4&)>& bindNode,
+                           uint32_t instanceCount, uint32_t firstInstance) {
+        uint32_t drawCalls = 0;
+
         for (auto& node : nodes) {
             if (node.mesh) {
-                ubo.nodeMatrix = getNodeMatrix(node.index);
+                if (!bindNode(getNodeMatrix(node.index))) break;
+
                 node.mesh->bind(commandBuffer);
-                node.mesh->draw(commandBuffer, layout);
+                drawCalls += node.mesh->draw(commandBuffer, layout, instanceCount, firstInstance);
             }
         }
+
+        return drawCalls;
     }
 
     /**
@@ -101,6 +161,30 @@ namespace re {
         return nodes[index];
     }
 
+    /**
+     *
+     * @return All nodes of the Model
+     */
+    const std::vector<Model::Node>& Model::getNodes() const {
+        return nodes;
+    }
+
+    /**
+     *
+     * @return Primitives of all the nodes with a mesh, grouped by node
+     */
+    const std::vector<Model::Draw>& Model::getDraws() const {
+        return draws;
+    }
+
+    /**
+     *
+     * @return Bounding box of all the Model meshes in Model space
+     */
+    const AABB& Model::getBounds() const {
+        return bounds;
+    }
+
     void Model::loadNode(const tinygltf::Model &model, int32_t parentIndex, const tinygltf::Node &node, uint32_t nodeIndex) {
         Node newNode{};
         newNode.index = nodeIndex;
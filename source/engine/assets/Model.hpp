@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <functional>
 
 #include "tiny_gltf.h"
 #include "vulkan/vulkan.h"
@@ -13,12 +14,14 @@
 #include "engine/math/Matrix4.hpp"
 #include "engine/math/Vector3.hpp"
 #include "engine/math/Quaternion.hpp"
+#include "engine/math/Bounds.hpp"
 
 
 namespace re {
 
     class Device;
     class Mesh;
+    class Material;
     class AssetsManager;
 
     class Model : public Asset {
@@ -36,26 +39,50 @@ namespace re {
             [[nodiscard]] Matrix4 getLocalMatrix() const;
         };
 
-        struct Ubo {
-            mat4 nodeMatrix{1.0f};
+        // One primitive of a node mesh, flattened at load so render extraction doesn't walk nodes and meshes
+        struct Draw {
+            uint32_t node;
+            const Mesh* mesh;
+            const Material* material;
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            int32_t vertexOffset;
+            uint64_t sortKey;
         };
 
     public:
         Model(std::string name, const std::string& fileName);
 
+        Model(std::string name, std::vector<Matrix4> nodeMatrices, std::vector<Draw> draws, const AABB& bounds);
+
         ~Model() override;
 
-        [[nodiscard]] Matrix4 getNodeMatrix(size_t index) const;
+        [[nodiscard]] const Matrix4& getNodeMatrix(size_t index) const;
+
+        [[nodiscard]] const Matrix4& getNodeInverseMatrix(size_t index) const;
 
-        void render(VkCommandBuffer commandBuffer, VkPipelineLayout layout, Ubo& ubo);
+        uint32_t render(VkCommandBuffer commandBuffer, VkPipelineLayout layout, const std::function<bool(const Matrix4&)>& bindNode,
+                        uint32_t instanceCount = 1, uint32_t firstInstance = 0);
 
         Node& getNode(uint32_t index);
 
+        [[nodiscard]] const std::vector<Node>& getNodes() const;
+
+        [[nodiscard]] const std::vector<Draw>& getDraws() const;
+
+        [[nodiscard]] const AABB& getBounds() const;
+
     private:
         void loadNode(const tinygltf::Model& model, int32_t parentIndex, const tinygltf::Node& node, uint32_t nodeIndex);
 
+        [[nodiscard]] Matrix4 calculateNodeMatrix(size_t index) const;
+
     private:
         std::vector<Node> nodes;
+        std::vector<Matrix4> nodeMatrices;
+        std::vector<Matrix4> invNodeMatrices;
+        std::vector<Draw> draws;
+        AABB bounds;
     };
 
 } // namespace re
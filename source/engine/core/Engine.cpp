@@ -1,6 +1,7 @@
 #include "Engine.hpp"
 
 #include "Application.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
 
 
 namespace re {
@@ -15,6 +16,7 @@ namespace re {
         files::addPath("shaders");
         files::addPath("data");
         files::addPath("tools");
+        files::addPath("cache", true);
 
         // TODO: Set more logs files
         log::LogsManager::cleanLogsFiles();
@@ -42,9 +44,16 @@ namespace re {
         jobs::JobSystem::singleton = new jobs::JobSystem();
         renderer = std::make_unique<Renderer>("", config);
         DescriptorsManager::singleton = new Descriptors::Manager(renderer->getDevice()->getDevice());
+        DescriptorsManager::singleton->createPool({
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 100},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 100},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 100},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000}
+        });
         AssetsManager::singleton = new AssetsManager(renderer->getDevice());
 
         app.setup();
+        addEngineSystems();
     }
 
     void Engine::loadScene() {
@@ -74,12 +83,7 @@ namespace re {
     }
 
     void Engine::update() {
-        Time::getInstance()->update();
-
-        if (renderSystem) renderSystem->update(renderer->getAspectRatio());
-
-        scene->update();
-        app.update();
+        scheduler.run();
     }
 
     void Engine::render() {
@@ -88,12 +92,12 @@ namespace re {
 
         // TODO: Change this
         if (scene->loaded() && renderSystem) {
-            renderSystem->renderScene(commandBuffer, scene);
+            renderSystem->renderScene(renderer->getCommandRecorder(), scene, renderer->getFrameIndex());
         }
 
         renderer->newImGuiFrame();
         app.drawImGui();
-        renderer->renderImGui(commandBuffer);
+        renderer->renderImGui();
 
         renderer->endSwapChainRenderPass(commandBuffer);
         renderer->endFrame();
@@ -115,4 +119,44 @@ namespace re {
         renderSystem = std::move(newRenderSystem);
     }
 
+    RenderSystem* Engine::getRenderSystem() {
+        return renderSystem.get();
+    }
+
+    SystemScheduler &Engine::getScheduler() {
+        return scheduler;
+    }
+
+    /**
+     * @brief Register the engine per frame systems. Applications can add their own systems to the scheduler in
+     * their setup, those run before the engine ones when they conflict.
+     */
+    void Engine::addEngineSystems() {
+        scheduler.addSystem("Time", [] {
+            Time::getInstance()->update();
+        }, SystemAccess().writes<Time>());
+
+        scheduler.addSystem("Camera projection", [this] {
+            if (renderSystem) renderSystem->update(renderer->getAspectRatio());
+        }, SystemAccess().writes<Camera>());
+
+        scheduler.addSystem("Camera view", [this] {
+            scene->update();
+        }, SystemAccess().reads<Transform>().writes<Camera>());
+
+        // The application accesses are unknown
+        scheduler.addSystem("Application", [this] {
+            app.update();
+        }, SystemAccess().exclusive().mainThread());
+
+        // Sync point, structural changes recorded by the previous systems and by jobs are applied here
+        scheduler.addSystem("Entity commands", [this] {
+            scene->playbackCommands();
+        }, SystemAccess().exclusive().mainThread());
+
+        scheduler.addSystem("Transforms", [this] {
+            scene->updateTransforms();
+        }, SystemAccess().reads<Hierarchy>().writes<Transform>());
+    }
+
 } // namespace re
@@ -5,6 +5,7 @@
 
 #include "NonCopyable.hpp"
 #include "Utils.hpp"
+#include "SystemScheduler.hpp"
 #include "engine/config/Config.hpp"
 #include "engine/time/Time.hpp"
 #include "engine/input/Input.hpp"
@@ -50,12 +51,20 @@ namespace re {
 
         void setRenderSystem(std::unique_ptr<RenderSystem> newRenderSystem);
 
+        RenderSystem* getRenderSystem();
+
+        SystemScheduler& getScheduler();
+
+    private:
+        void addEngineSystems();
+
     private:
         Application& app;
         Config& config;
         std::unique_ptr<Renderer> renderer;
         std::unique_ptr<RenderSystem> renderSystem;
         std::shared_ptr<Scene> scene;
+        SystemScheduler scheduler;
     };
 
 } // namespace re
@@ -0,0 +1,156 @@
+#include "SystemScheduler.hpp"
+
+#include <algorithm>
+
+#include "engine/jobSystem/JobSystem.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief The system conflicts with every other system, use it when the accesses aren't known
+     */
+    SystemAccess& SystemAccess::exclusive() {
+        isExclusive = true;
+        return *this;
+    }
+
+    /**
+     * @brief The system always runs on the thread that calls SystemScheduler::run
+     */
+    SystemAccess& SystemAccess::mainThread() {
+        onMainThread = true;
+        return *this;
+    }
+
+    /**
+     *
+     * @return True if both systems can't run at the same time
+     */
+    bool SystemAccess::conflicts(const SystemAccess& other) const {
+        if (isExclusive || other.isExclusive) return true;
+
+        for (auto type : writeTypes) {
+            if (contains(other.readTypes, type) || contains(other.writeTypes, type)) return true;
+        }
+
+        for (auto type : other.writeTypes) {
+            if (contains(readTypes, type)) return true;
+        }
+
+        return false;
+    }
+
+    bool SystemAccess::isMainThread() const {
+        return onMainThread;
+    }
+
+    bool SystemAccess::contains(const std::vector<entt::id_type>& types, entt::id_type type) {
+        return std::find(types.begin(), types.end(), type) != types.end();
+    }
+
+    SystemScheduler::SystemScheduler() = default;
+
+    SystemScheduler::~SystemScheduler() = default;
+
+    /**
+     *
+     * @param name Name shown in the schedule trace
+     * @param function Called once per frame
+     * @param access Types read and written by the system. Conflicting systems run in registration order.
+     */
+    void SystemScheduler::addSystem(const std::string& name, SystemFunction function, SystemAccess access) {
+        systems.push_back({name, std::move(function), std::move(access)});
+    }
+
+    /**
+     * @brief Run every system once. Levels run in order, the systems of a level run in parallel and the main
+     * thread systems of the level run on the calling thread after them.
+     */
+    void SystemScheduler::run() {
+        frameStart = std::chrono::high_resolution_clock::now();
+        mainThreadId = std::this_thread::get_id();
+
+        buildGraph();
+
+        for (auto& level : levels) {
+            parallelSystems.clear();
+            for (auto index : level) {
+                if (!systems[index].access.isMainThread()) parallelSystems.push_back(index);
+            }
+
+            jobs::parallelFor(static_cast<uint32_t>(parallelSystems.size()), 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                    execute(parallelSystems[i]);
+            });
+
+            for (auto index : level) {
+                if (systems[index].access.isMainThread()) execute(index);
+            }
+        }
+
+        frameTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count();
+    }
+
+    /**
+     *
+     * @return Per system timings of the last frame, in registration order
+     */
+    const std::vector<SystemScheduler::Trace>& SystemScheduler::getTrace() const {
+        return trace;
+    }
+
+    uint32_t SystemScheduler::getLevelCount() const {
+        return static_cast<uint32_t>(levels.size());
+    }
+
+    /**
+     *
+     * @return Milliseconds spent in the last run
+     */
+    float SystemScheduler::getFrameTime() const {
+        return frameTime;
+    }
+
+    /**
+     * @brief A system depends on every previously registered system it conflicts with, and its level is one
+     * more than the deepest of them
+     */
+    void SystemScheduler::buildGraph() {
+        trace.resize(systems.size());
+        for (auto& level : levels) level.clear();
+
+        uint32_t levelCount = 0;
+        for (uint32_t i = 0; i < systems.size(); ++i) {
+            Trace& node = trace[i];
+            node.name = systems[i].name;
+            node.level = 0;
+            node.dependencies = 0;
+
+            for (uint32_t j = 0; j < i; ++j) {
+                if (!systems[i].access.conflicts(systems[j].access)) continue;
+
+                node.level = std::max(node.level, trace[j].level + 1);
+                node.dependencies++;
+            }
+
+            if (node.level >= levels.size()) levels.resize(node.level + 1);
+            levels[node.level].push_back(i);
+            levelCount = std::max(levelCount, node.level + 1);
+        }
+
+        levels.resize(levelCount);
+    }
+
+    void SystemScheduler::execute(uint32_t index) {
+        auto start = std::chrono::high_resolution_clock::now();
+        systems[index].function();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        Trace& node = trace[index];
+        node.start = std::chrono::duration<float, std::milli>(start - frameStart).count();
+        node.duration = std::chrono::duration<float, std::milli>(end - start).count();
+        node.mainThread = std::this_thread::get_id() == mainThreadId;
+    }
+
+} // namespace re
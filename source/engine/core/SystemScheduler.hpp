@@ -0,0 +1,118 @@
+#ifndef RAVENENGINE_SYSTEMSCHEDULER_HPP
+#define RAVENENGINE_SYSTEMSCHEDULER_HPP
+
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <thread>
+
+#include "entt/entt.hpp"
+
+#include "NonCopyable.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Components, or any other shared type like singletons, that a system reads and writes. Two systems
+     * conflict if one writes a type the other reads or writes. Exclusive systems conflict with every system.
+     */
+    class SystemAccess {
+    public:
+        template<typename ...T>
+        SystemAccess& reads();
+
+        template<typename ...T>
+        SystemAccess& writes();
+
+        SystemAccess& exclusive();
+
+        SystemAccess& mainThread();
+
+        [[nodiscard]] bool conflicts(const SystemAccess& other) const;
+
+        [[nodiscard]] bool isMainThread() const;
+
+    private:
+        static bool contains(const std::vector<entt::id_type>& types, entt::id_type type);
+
+    private:
+        std::vector<entt::id_type> readTypes;
+        std::vector<entt::id_type> writeTypes;
+        bool isExclusive{};
+        bool onMainThread{};
+    };
+
+    template<typename ...T>
+    SystemAccess& SystemAccess::reads() {
+        (readTypes.push_back(entt::type_hash<T>::value()), ...);
+        return *this;
+    }
+
+    template<typename ...T>
+    SystemAccess& SystemAccess::writes() {
+        (writeTypes.push_back(entt::type_hash<T>::value()), ...);
+        return *this;
+    }
+
+    /**
+     * @brief Run the per frame systems. Each frame a dependency graph is built from the declared accesses,
+     * keeping the registration order between conflicting systems, and systems are grouped in levels. The
+     * systems of a level don't conflict between them and run in parallel on the JobSystem.
+     */
+    class SystemScheduler : NonCopyable {
+    public:
+        using SystemFunction = std::function<void()>;
+
+        struct Trace {
+            std::string name;
+            uint32_t level;
+            uint32_t dependencies;
+            // Milliseconds since the start of the frame
+            float start;
+            float duration;
+            bool mainThread;
+        };
+
+    public:
+        SystemScheduler();
+
+        ~SystemScheduler() override;
+
+        void addSystem(const std::string& name, SystemFunction function, SystemAccess access = {});
+
+        void run();
+
+        [[nodiscard]] const std::vector<Trace>& getTrace() const;
+
+        [[nodiscard]] uint32_t getLevelCount() const;
+
+        [[nodiscard]] float getFrameTime() const;
+
+    private:
+        struct System {
+            std::string name;
+            SystemFunction function;
+            SystemAccess access;
+        };
+
+        void buildGraph();
+
+        void execute(uint32_t index);
+
+    private:
+        std::vector<System> systems;
+        std::vector<std::vector<uint32_t>> levels;
+        std::vector<uint32_t> parallelSystems;
+        std::vector<Trace> trace;
+        std::chrono::high_resolution_clock::time_point frameStart;
+        std::thread::id mainThreadId;
+        float frameTime{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_SYSTEMSCHEDULER_HPP
@@ -0,0 +1,91 @@
+#include "ComponentRegistry.hpp"
+
+#include <unordered_map>
+
+
+namespace re {
+
+    namespace {
+
+        template<typename T>
+        ComponentInfo makeComponentInfo() {
+            return {
+                NAMEOF_SHORT_TYPE(T),
+                entt::type_hash<T>::value(),
+                [](const entt::registry& registry, id_t id) { return registry.all_of<T>(id); },
+                [](entt::registry& registry, id_t id) { return registry.get<T>(id).serialize(); },
+                [](EntityHandle entity, json& component) { entity.addComponent<T>(component); }
+            };
+        }
+
+        template<typename ...T>
+        std::array<ComponentInfo, sizeof...(T)> makeComponentTable(ComponentList<T...>) {
+            return {makeComponentInfo<T>()...};
+        }
+
+    } // namespace
+
+    /**
+     *
+     * @return Info of every component in SerializedComponents, indexed by ComponentRegistry::indexOf
+     */
+    const std::array<ComponentInfo, ComponentRegistry::COUNT>& ComponentRegistry::getComponents() {
+        static const auto components = makeComponentTable(SerializedComponents{});
+        return components;
+    }
+
+    /**
+     *
+     * @param name Serialized name of the component
+     * @return Registered component or nullptr
+     */
+    const ComponentInfo* ComponentRegistry::find(std::string_view name) {
+        static const auto names = [] {
+            std::unordered_map<std::string_view, const ComponentInfo*> table;
+            for (auto& component : getComponents())
+                table[component.name] = &component;
+
+            return table;
+        }();
+
+        auto it = names.find(name);
+        return it == names.end() ? nullptr : it->second;
+    }
+
+    /**
+     *
+     * @return JSON object with one key per registered component of the entity
+     */
+    json ComponentRegistry::serialize(EntityHandle entity) {
+        json data = json::object();
+
+        for (auto& component : getComponents()) {
+            if (component.has(*entity.getRegistry(), entity.getId()))
+                data[std::string(component.name)] = component.serialize(*entity.getRegistry(), entity.getId());
+        }
+
+        return data;
+    }
+
+    /**
+     * @brief Add the registered components found in the data. Each key is looked up once in the name table and
+     * components are constructed in SerializedComponents order, so later components can use earlier ones.
+     * @param entity Entity without the components
+     * @param data Serialized entity, unknown keys are ignored
+     */
+    void ComponentRegistry::deserialize(EntityHandle entity, json& data) {
+        std::array<json*, COUNT> found{};
+
+        for (auto& [key, value] : data.items()) {
+            if (value.is_null()) continue;
+
+            if (auto* component = find(key))
+                found[component - getComponents().data()] = &value;
+        }
+
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (found[i]) getComponents()[i].deserialize(entity, *found[i]);
+        }
+    }
+
+} // namespace re
@@ -0,0 +1,84 @@
+#ifndef RAVENENGINE_COMPONENTREGISTRY_HPP
+#define RAVENENGINE_COMPONENTREGISTRY_HPP
+
+
+#include <array>
+#include <string_view>
+
+#include "entt/entt.hpp"
+#include "nameof.hpp"
+
+#include "engine/external/Json.hpp"
+#include "EntityHandle.hpp"
+#include "components/Transform.hpp"
+#include "components/MeshRender.hpp"
+#include "components/Camera.hpp"
+#include "components/Light.hpp"
+
+
+namespace re {
+
+    template<typename ...T>
+    struct ComponentList {
+        static constexpr size_t size = sizeof...(T);
+    };
+
+    // Components saved with the entity, in construction order. A component needs json serialize() and a
+    // T(json&, EntityHandle) constructor to be listed here.
+    using SerializedComponents = ComponentList<Transform, MeshRender, Camera, Light>;
+
+    /**
+     * @brief Type erased operations of a registered component
+     */
+    struct ComponentInfo {
+        // Key of the component in the serialized entity
+        std::string_view name;
+        entt::id_type type;
+        bool (*has)(const entt::registry& registry, id_t id);
+        json (*serialize)(entt::registry& registry, id_t id);
+        void (*deserialize)(EntityHandle entity, json& component);
+    };
+
+    /**
+     * @brief Dispatch tables generated from SerializedComponents. Adding a component to the list is enough to
+     * save and load it, the tables are built once and looked up by index or by name hash.
+     */
+    class ComponentRegistry {
+    public:
+        static constexpr size_t COUNT = SerializedComponents::size;
+
+        [[nodiscard]] static const std::array<ComponentInfo, COUNT>& getComponents();
+
+        [[nodiscard]] static const ComponentInfo* find(std::string_view name);
+
+        static json serialize(EntityHandle entity);
+
+        static void deserialize(EntityHandle entity, json& data);
+
+        template<typename T>
+        [[nodiscard]] static constexpr size_t indexOf();
+
+    private:
+        template<typename T, typename U, typename ...Rest>
+        static constexpr size_t indexOf(ComponentList<U, Rest...>);
+    };
+
+    template<typename T>
+    constexpr size_t ComponentRegistry::indexOf() {
+        return indexOf<T>(SerializedComponents{});
+    }
+
+    template<typename T, typename U, typename ...Rest>
+    constexpr size_t ComponentRegistry::indexOf(ComponentList<U, Rest...>) {
+        if constexpr (std::is_same_v<T, U>) {
+            return 0;
+        } else {
+            static_assert(sizeof...(Rest) > 0, "Component is not in SerializedComponents");
+            return 1 + indexOf<T>(ComponentList<Rest...>{});
+        }
+    }
+
+} // namespace re
+
+
+#endif //RAVENENGINE_COMPONENTREGISTRY_HPP
@@ -0,0 +1,237 @@
+#include "EntityHandle.hpp"
+
+#include "ComponentRegistry.hpp"
+#include "engine/entity/components/Name.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/logs/Logs.hpp"
+
+
+namespace re {
+
+    /**
+     *
+     * @param registry Registry that owns the entity
+     * @param id Valid EnTT id
+     */
+    EntityHandle::EntityHandle(entt::registry *registry, id_t id) : registry(registry), id(id) {
+
+    }
+
+    /**
+     *
+     * @return EnTT id
+     */
+    id_t EntityHandle::getId() const {
+        return id;
+    }
+
+    /**
+     *
+     * @return Registry that owns the entity
+     */
+    entt::registry *EntityHandle::getRegistry() const {
+        return registry;
+    }
+
+    /**
+     *
+     * @return True if the handle points to an alive entity
+     */
+    bool EntityHandle::valid() const {
+        return registry && registry->valid(id);
+    }
+
+    EntityHandle::operator bool() const {
+        return valid();
+    }
+
+    /**
+     *
+     * @return Entity name. Entities without Name component have an empty name.
+     */
+    const std::string &EntityHandle::getName() const {
+        static const std::string empty;
+
+        auto* name = tryGetComponent<Name>();
+        return name ? name->name : empty;
+    }
+
+    /**
+     * @brief Set the name through the registry, so listeners like the Scene name index are notified
+     * @param name New name to set to Entity
+     */
+    void EntityHandle::setName(const std::string &name) const {
+        auto* current = tryGetComponent<Name>();
+
+        if (!current)
+            registry->emplace<Name>(id, name, *this);
+        else if (current->name != name)
+            registry->patch<Name>(id, [&](Name& component) { component.name = name; });
+    }
+
+    /**
+     *
+     * @return JSON object with Entity serialized data. The parent is written by the Scene.
+     */
+    json EntityHandle::serialize() const {
+        json entity = ComponentRegistry::serialize(*this);
+        entity["name"] = getName();
+
+        return entity;
+    }
+
+    /**
+     *
+     * @param entity JSON Serialized data to set Entity
+     */
+    void EntityHandle::serialize(json &entity) const {
+        setName(entity["name"]);
+        ComponentRegistry::deserialize(*this, entity);
+    }
+
+    /**
+     *
+     * @param childName Name of the new Entity
+     * @return New Entity, child of this Entity
+     */
+    EntityHandle EntityHandle::addChild(const std::string &childName) const {
+        EntityHandle child(registry, registry->create());
+        child.setName(childName);
+        child.setParent(*this);
+        return child;
+    }
+
+    /**
+     * @brief Depth first search of a descendant by name. Use Scene::getEntityByPath for indexed lookups.
+     * @param childName Name of the descendant
+     * @return First descendant with that name or a null handle
+     */
+    EntityHandle EntityHandle::getChild(const std::string &childName) const {
+        for (auto child = getFirstChild(); child; child = child.getNextSibling()) {
+            if (child.getName() == childName) return child;
+
+            if (auto descendant = child.getChild(childName)) return descendant;
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Move the entity, with its children, under a new parent. The local Transform is kept, so the world
+     * position changes with the parent.
+     * @param newParent New parent, a null handle makes this entity a root
+     */
+    void EntityHandle::setParent(EntityHandle newParent) const {
+        id_t parent = newParent ? newParent.id : entt::null;
+
+        // Emplace first, adding components can invalidate references to others of the same type
+        registry->get_or_emplace<Hierarchy>(id, *this);
+        if (parent != entt::null) registry->get_or_emplace<Hierarchy>(parent, newParent);
+
+        auto& node = registry->get<Hierarchy>(id);
+        if (node.parent == parent) return;
+
+        for (id_t ancestor = parent; ancestor != entt::null; ancestor = registry->get<Hierarchy>(ancestor).parent) {
+            if (ancestor == id) {
+                log::warn(fmt::format("Can't set {} as parent of {}, it's one of its children", newParent.getName(), getName()));
+                return;
+            }
+        }
+
+        if (node.parent != entt::null) {
+            auto& oldParent = registry->get<Hierarchy>(node.parent);
+
+            if (node.prevSibling != entt::null)
+                registry->get<Hierarchy>(node.prevSibling).nextSibling = node.nextSibling;
+            else
+                oldParent.firstChild = node.nextSibling;
+
+            if (node.nextSibling != entt::null)
+                registry->get<Hierarchy>(node.nextSibling).prevSibling = node.prevSibling;
+            else
+                oldParent.lastChild = node.prevSibling;
+
+            oldParent.childCount--;
+        }
+
+        node.parent = parent;
+        node.prevSibling = entt::null;
+        node.nextSibling = entt::null;
+
+        if (parent != entt::null) {
+            auto& parentNode = registry->get<Hierarchy>(parent);
+
+            // Append, so children keep their creation order
+            if (parentNode.lastChild == entt::null) {
+                parentNode.firstChild = id;
+            } else {
+                registry->get<Hierarchy>(parentNode.lastChild).nextSibling = id;
+                node.prevSibling = parentNode.lastChild;
+            }
+            parentNode.lastChild = id;
+
+            parentNode.childCount++;
+        }
+
+        setDepth(parent == entt::null ? 0 : registry->get<Hierarchy>(parent).depth + 1);
+
+        if (auto* transform = tryGetComponent<Transform>()) transform->markDirty();
+    }
+
+    /**
+     *
+     * @return Parent Entity or a null handle for roots
+     */
+    EntityHandle EntityHandle::getParent() const {
+        auto* hierarchy = tryGetComponent<Hierarchy>();
+        if (!hierarchy || hierarchy->parent == entt::null) return {};
+
+        return {registry, hierarchy->parent};
+    }
+
+    /**
+     *
+     * @return Children in creation order. Use getFirstChild and getNextSibling to iterate without allocating.
+     */
+    std::vector<EntityHandle> EntityHandle::getChildren() const {
+        std::vector<EntityHandle> children;
+        if (auto* hierarchy = tryGetComponent<Hierarchy>()) children.reserve(hierarchy->childCount);
+
+        for (auto child = getFirstChild(); child; child = child.getNextSibling())
+            children.push_back(child);
+
+        return children;
+    }
+
+    /**
+     *
+     * @return First child or a null handle
+     */
+    EntityHandle EntityHandle::getFirstChild() const {
+        auto* hierarchy = tryGetComponent<Hierarchy>();
+        if (!hierarchy || hierarchy->firstChild == entt::null) return {};
+
+        return {registry, hierarchy->firstChild};
+    }
+
+    /**
+     *
+     * @return Next child of the same parent or a null handle
+     */
+    EntityHandle EntityHandle::getNextSibling() const {
+        auto* hierarchy = tryGetComponent<Hierarchy>();
+        if (!hierarchy || hierarchy->nextSibling == entt::null) return {};
+
+        return {registry, hierarchy->nextSibling};
+    }
+
+    void EntityHandle::setDepth(uint32_t depth) const {
+        auto& node = getComponent<Hierarchy>();
+        node.depth = depth;
+
+        for (auto child = getFirstChild(); child; child = child.getNextSibling())
+            child.setDepth(depth + 1);
+    }
+
+} // namespace re
@@ -0,0 +1,102 @@
+#ifndef RAVENENGINE_ENTITYHANDLE_HPP
+#define RAVENENGINE_ENTITYHANDLE_HPP
+
+
+#include <string>
+#include <vector>
+
+#include "entt/entt.hpp"
+
+#include "engine/external/Json.hpp"
+
+
+namespace re {
+
+    using id_t = entt::entity;
+
+    /**
+     * @brief Value type reference to an entity: the registry that owns it and its id. It's cheap to copy and
+     * all its data, including name and hierarchy, lives in components. A default constructed handle is null.
+     */
+    class EntityHandle {
+    public:
+        EntityHandle() = default;
+
+        EntityHandle(entt::registry* registry, id_t id);
+
+        template<typename T, typename ...Args>
+        inline T& addComponent(Args&& ...args) const;
+
+        template<typename T>
+        inline T& getComponent() const;
+
+        template<typename T>
+        inline T* tryGetComponent() const;
+
+        template<typename T>
+        inline bool hasComponent() const;
+
+        [[nodiscard]] id_t getId() const;
+
+        [[nodiscard]] entt::registry* getRegistry() const;
+
+        [[nodiscard]] bool valid() const;
+
+        explicit operator bool() const;
+
+        bool operator==(const EntityHandle& other) const = default;
+
+        [[nodiscard]] const std::string& getName() const;
+
+        void setName(const std::string& name) const;
+
+        [[nodiscard]] json serialize() const;
+
+        void serialize(json& entity) const;
+
+        [[nodiscard]] EntityHandle addChild(const std::string& childName) const;
+
+        [[nodiscard]] EntityHandle getChild(const std::string& childName) const;
+
+        void setParent(EntityHandle newParent) const;
+
+        [[nodiscard]] EntityHandle getParent() const;
+
+        [[nodiscard]] std::vector<EntityHandle> getChildren() const;
+
+        [[nodiscard]] EntityHandle getFirstChild() const;
+
+        [[nodiscard]] EntityHandle getNextSibling() const;
+
+    private:
+        void setDepth(uint32_t depth) const;
+
+    private:
+        entt::registry* registry{};
+        id_t id{entt::null};
+    };
+
+    template<typename T, typename ...Args>
+    T &EntityHandle::addComponent(Args&& ...args) const {
+        return registry->emplace<T>(id, std::forward<Args>(args)..., *this);
+    }
+
+    template<typename T>
+    T &EntityHandle::getComponent() const {
+        return registry->get<T>(id);
+    }
+
+    template<typename T>
+    T *EntityHandle::tryGetComponent() const {
+        return registry->try_get<T>(id);
+    }
+
+    template<typename T>
+    bool EntityHandle::hasComponent() const {
+        return registry->all_of<T>(id);
+    }
+
+} // namespace re
+
+
+#endif //RAVENENGINE_ENTITYHANDLE_HPP
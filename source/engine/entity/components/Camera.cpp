@@ -6,7 +6,7 @@
 
 #include "Transform.hpp"
 #include "engine/math/Basis.hpp"
-#include "engine/entity/Entity.hpp"
+#include "engine/entity/EntityHandle.hpp"
 
 
 namespace re {
@@ -17,14 +17,14 @@ namespace re {
      * @param zNear Near plane distance
      * @param zFar Far plane distance
      * @param target Camera target
-     * @param owner Valid Entity pointer
+     * @param owner Owner Entity
      */
-    Camera::Camera(float fov, float zNear, float zFar, const Vector3& target, Entity* owner)
+    Camera::Camera(float fov, float zNear, float zFar, const Vector3d& target, EntityHandle owner)
             : Component(owner), fov(fov), zNear(zNear), zFar(zFar), target(target) {
 
     }
 
-    Camera::Camera(json &component, Entity *owner) : Component(owner) {
+    Camera::Camera(json &component, EntityHandle owner) : Component(owner) {
         serialize(component);
     }
 
@@ -65,26 +65,32 @@ namespace re {
      * @param up [Optional] Up world vector, By default is (0, 1, 0).
      * @note The function not require the eye and center as a parameters. Eye vector is the target attribute of Camera
      * component, and Center is position attribute in Transform component
+     * @note The direction and the translation of view are computed in double. relativeView has no translation and
+     * origin is set to the camera position, so objects near a camera far from the world origin keep their precision.
      */
     void Camera::lookAt(const Vector3& up) {
-        vec3 position = owner->getComponent<Transform>().position;
-        const vec3 f((target - position).normalized());
+        const Vector3d& position = owner.getComponent<Transform>().getPosition();
+        const vec3 f((target - position).toVector3().normalized());
         const vec3 s(f.cross(up).normalized());
         const vec3 u(s.cross(f));
 
-        view.setIdentity();
-        view[0][0] = s.x;
-        view[1][0] = s.y;
-        view[2][0] = s.z;
-        view[0][1] = u.x;
-        view[1][1] = -u.y;
-        view[2][1] = u.z;
-        view[0][2] = f.x;
-        view[1][2] = f.y;
-        view[2][2] = f.z;
-        view[3][0] = -s.dot(position);
-        view[3][1] = -u.dot(position);
-        view[3][2] = -f.dot(position);
+        relativeView.setIdentity();
+        relativeView[0][0] = s.x;
+        relativeView[1][0] = s.y;
+        relativeView[2][0] = s.z;
+        relativeView[0][1] = u.x;
+        relativeView[1][1] = -u.y;
+        relativeView[2][1] = u.z;
+        relativeView[0][2] = f.x;
+        relativeView[1][2] = f.y;
+        relativeView[2][2] = f.z;
+
+        view = relativeView;
+        view[3][0] = static_cast<float>(-Vector3d(s).dot(position));
+        view[3][1] = static_cast<float>(-Vector3d(u).dot(position));
+        view[3][2] = static_cast<float>(-Vector3d(f).dot(position));
+
+        origin = position;
     }
 
     void Camera::update() {
@@ -96,7 +102,7 @@ namespace re {
             {std::string(NAMEOF(fov)), fov},
             {std::string(NAMEOF(zNear)), zNear},
             {std::string(NAMEOF(zFar)), zFar},
-            {std::string(NAMEOF(target)), target.values},
+            {std::string(NAMEOF(target)), {target.x, target.y, target.z}},
         };
     }
 
@@ -104,7 +110,7 @@ namespace re {
         fov = component[std::string(NAMEOF(fov))].get<float>();
         zNear = component[std::string(NAMEOF(zNear))].get<float>();
         zFar = component[std::string(NAMEOF(zFar))].get<float>();
-        target = Vector3(component[std::string(NAMEOF(target))].get<std::array<float, 3>>().data());
+        target = Vector3d(component[std::string(NAMEOF(target))].get<std::array<double, 3>>().data());
     }
 
 } // namespace re
@@ -5,6 +5,7 @@
 #include "Component.hpp"
 #include "engine/math/Math.hpp"
 #include "engine/math/Vector3.hpp"
+#include "engine/math/Vector3d.hpp"
 #include "engine/math/Matrix4.hpp"
 #include "engine/math/Quaternion.hpp"
 
@@ -13,9 +14,9 @@ namespace re {
 
     class Camera : public Component {
     public:
-        explicit Camera(float fov, float zNear, float zFar, const Vector3& target, Entity* owner);
+        explicit Camera(float fov, float zNear, float zFar, const Vector3d& target, EntityHandle owner);
 
-        Camera(json& component, Entity* owner);
+        Camera(json& component, EntityHandle owner);
 
         void setOrthographic(float left, float right, float top, float bottom);
 
@@ -32,9 +33,13 @@ namespace re {
     public:
         float fov{Math::deg2rad(45.0f)};
         float zNear{0.1f}, zFar{100};
-        Vector3 target;
+        Vector3d target;
         Matrix4 projection{1.0f};
+        // World to view, loses precision far from the world origin. Used for culling against world bounds.
         Matrix4 view{1.0f};
+        // View with the camera at the origin, the rendered matrices are relative to origin
+        Matrix4 relativeView{1.0f};
+        Vector3d origin;
     };
 
 
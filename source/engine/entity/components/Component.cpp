@@ -3,7 +3,7 @@
 
 namespace re {
 
-    Component::Component(Entity *owner) : owner(owner) {
+    Component::Component(EntityHandle owner) : owner(owner) {
 
     }
 
@@ -3,25 +3,22 @@
 
 
 #include "engine/external/Json.hpp"
+#include "engine/entity/EntityHandle.hpp"
 
 
 namespace re {
 
-    class Entity;
-
     // TODO: Implement Constructor form serialized
     class Component {
-        friend Entity;
-
     public:
-        explicit Component(Entity* owner);
+        explicit Component(EntityHandle owner);
 
         virtual json serialize();
 
         virtual void serialize(json& component);
 
     protected:
-        Entity* owner;
+        EntityHandle owner;
     };
 
 } // namespace re
@@ -0,0 +1,14 @@
+#include "Hierarchy.hpp"
+
+
+namespace re {
+
+    /**
+     *
+     * @param owner Owner Entity
+     */
+    Hierarchy::Hierarchy(EntityHandle owner) : Component(owner) {
+
+    }
+
+} // namespace re
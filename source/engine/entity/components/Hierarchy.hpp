@@ -0,0 +1,35 @@
+#ifndef RAVENENGINE_HIERARCHY_HPP
+#define RAVENENGINE_HIERARCHY_HPP
+
+
+#include "entt/entt.hpp"
+
+#include "Component.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Parent and children links of an Entity, stored as entity ids. Children form a doubly linked list
+     * through their sibling links, so reparenting never allocates. Use EntityHandle::setParent to modify it.
+     */
+    class Hierarchy : public Component {
+    public:
+        explicit Hierarchy(EntityHandle owner);
+
+    public:
+        entt::entity parent{entt::null};
+        entt::entity firstChild{entt::null};
+        // Kept so appending a child doesn't walk the siblings
+        entt::entity lastChild{entt::null};
+        entt::entity nextSibling{entt::null};
+        entt::entity prevSibling{entt::null};
+        uint32_t childCount{};
+        // Number of ancestors, 0 for roots
+        uint32_t depth{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_HIERARCHY_HPP
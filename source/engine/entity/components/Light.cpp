@@ -9,9 +9,9 @@ namespace re {
      *
      * @param color Light color (RGB)
      * @param ambient Ambient intensity
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    Light::Light(const vec3 &color, float ambient, Entity *owner)
+    Light::Light(const vec3 &color, float ambient, EntityHandle owner)
             : Component(owner), color(color), ambient(ambient) {
 
     }
@@ -19,9 +19,9 @@ namespace re {
     /**
      *
      * @param component Component data serialized in JSON
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    Light::Light(json &component, Entity *owner) : Component(owner) {
+    Light::Light(json &component, EntityHandle owner) : Component(owner) {
         serialize(component);
     }
 
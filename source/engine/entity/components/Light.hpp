@@ -17,9 +17,9 @@ namespace re {
             alignas(16) vec3 viewPosition{};
         };
 
-        Light(const vec3& color, float ambient, Entity* owner);
+        Light(const vec3& color, float ambient, EntityHandle owner);
 
-        Light(json& component, Entity* owner);
+        Light(json& component, EntityHandle owner);
 
         ~Light();
 
@@ -2,6 +2,9 @@
 
 #include "engine/assets/AssetsManager.hpp"
 #include "engine/jobSystem/JobSystem.hpp"
+#include "engine/scene/EntityCommands.hpp"
+#include "engine/core/Utils.hpp"
+#include "engine/logs/Logs.hpp"
 
 
 namespace re {
@@ -9,35 +12,60 @@ namespace re {
     /**
      *
      * @param name Valid Model name
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    MeshRender::MeshRender(const std::string& name, Entity* owner) : Component(owner) {
+    MeshRender::MeshRender(const std::string& name, EntityHandle owner) : Component(owner) {
         setModel(name);
     }
 
     /**
      *
      * @param component JSON component data
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    MeshRender::MeshRender(json &component, Entity *owner) : Component(owner) {
+    MeshRender::MeshRender(json &component, EntityHandle owner) : Component(owner) {
         serialize(component);
     }
 
     json MeshRender::serialize() {
         return {
-            {"name", model->getName()}
+            {"name", model->getName()},
+            {"occluder", occluder}
         };
     }
 
     void MeshRender::serialize(json &component) {
+        occluder = component.value("occluder", false);
         setModel(component["name"]);
     }
 
+    /**
+     * @brief Load the model in a job. The component is updated through the command buffers of the scene, so
+     * the registry is not modified from the job thread. The job shares the ownership of the queue, so it can
+     * finish after the Scene is destroyed. The command is keyed by the entity, so playback applies the loads
+     * in the same order whichever worker finished first. If the model fails to load the component stays
+     * disabled.
+     * @param name Valid Model name
+     */
     void MeshRender::setModel(const std::string& name) {
-        jobs::submit([=, this](){
-            model = AssetsManager::getInstance()->add<Model>(name, name);
-            enable = true;
+        auto commands = EntityCommandQueue::find(*owner.getRegistry());
+        if (!commands) throwEx("MeshRender: the registry has no EntityCommandQueue");
+
+        jobs::submit([name, commands, id = owner.getId()](){
+            Model* loaded;
+            try {
+                loaded = AssetsManager::getInstance()->add<Model>(name, name);
+            } catch (const std::exception& e) {
+                log::error(fmt::format("MeshRender: failed to load {}: {}", name, e.what()));
+                return;
+            }
+
+            EntityCommandBuffer& buffer = commands->getBuffer();
+            EntityCommandBuffer::SortKey key(buffer, entt::to_integral(id));
+            buffer.patch<MeshRender>(id, [loaded](MeshRender& meshRender) {
+                meshRender.model = loaded;
+                meshRender.enable = true;
+            });
         });
     }
 
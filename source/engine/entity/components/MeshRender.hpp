@@ -12,9 +12,9 @@ namespace re {
 
     class MeshRender : public Component {
     public:
-        MeshRender(const std::string& name, Entity* owner);
+        MeshRender(const std::string& name, EntityHandle owner);
 
-        MeshRender(json& component, Entity* owner);
+        MeshRender(json& component, EntityHandle owner);
 
         json serialize() override;
 
@@ -25,6 +25,8 @@ namespace re {
     public:
         Model* model{};
         bool enable{};
+        // Rasterized into the occlusion depth buffer to hide the entities behind it
+        bool occluder{};
     };
 
 } // namespace re
@@ -0,0 +1,29 @@
+#include "Name.hpp"
+
+#include <functional>
+
+
+namespace re {
+
+    /**
+     *
+     * @param owner Valid Entity
+     */
+    Name::Name(EntityHandle owner) : Component(owner) {
+
+    }
+
+    /**
+     *
+     * @param name Entity name
+     * @param owner Valid Entity
+     */
+    Name::Name(std::string name, EntityHandle owner) : Component(owner), name(std::move(name)) {
+
+    }
+
+    size_t Name::hash(std::string_view name) {
+        return std::hash<std::string_view>{}(name);
+    }
+
+} // namespace re
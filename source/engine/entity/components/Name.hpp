@@ -0,0 +1,33 @@
+#ifndef RAVENENGINE_NAME_HPP
+#define RAVENENGINE_NAME_HPP
+
+
+#include <string>
+#include <string_view>
+
+#include "Component.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Entity name. Modify it with EntityHandle::setName so the Scene name index is updated.
+     */
+    class Name : public Component {
+    public:
+        explicit Name(EntityHandle owner);
+
+        Name(std::string name, EntityHandle owner);
+
+        [[nodiscard]] static size_t hash(std::string_view name);
+
+    public:
+        std::string name;
+        // Hash the entity is stored with in the NameIndex
+        size_t indexedHash{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_NAME_HPP
@@ -1,8 +1,9 @@
 #include "Transform.hpp"
 
-#include "nameof.hpp"
+#include <cmath>
+#include <limits>
 
-#include "engine/math/Basis.hpp"
+#include "nameof.hpp"
 
 
 namespace re {
@@ -12,9 +13,9 @@ namespace re {
      * @param position (X-Y-Z)
      * @param scale By default are 1-1-1
      * @param angles Euler angles
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    Transform::Transform(const vec3 &position, const vec3 &scale, const vec3 &angles, Entity *owner)
+    Transform::Transform(const vec3d &position, const vec3 &scale, const vec3 &angles, EntityHandle owner)
             : Component(owner), position(position), scale(scale) {
         rotation = Quaternion(angles);
     }
@@ -24,29 +25,81 @@ namespace re {
      * @param position (X-Y-Z)
      * @param scale By default are 1-1-1
      * @param rotation Quaternion with direction
-     * @param owner Valid pointer to Entity
+     * @param owner Owner Entity
      */
-    Transform::Transform(const vec3 &position, const vec3 &scale, const quat &rotation, Entity *owner)
+    Transform::Transform(const vec3d &position, const vec3 &scale, const quat &rotation, EntityHandle owner)
             : Component(owner), position(position), scale(scale), rotation(rotation) {
 
     }
 
-    Transform::Transform(json &component, Entity *owner) : Component(owner) {
+    Transform::Transform(json &component, EntityHandle owner) : Component(owner) {
         serialize(component);
     }
 
     /**
      *
-     * @return Transform world matrix
+     * @return Cached local matrix
      */
-    Matrix4 Transform::worldMatrix() const {
-        Basis rotationMatrix = Basis(rotation, scale);
-        return {
-            { rotationMatrix[0][0], rotationMatrix[1][0], rotationMatrix[2][0], 0.0f },
-            { rotationMatrix[0][1], rotationMatrix[1][1], rotationMatrix[2][1], 0.0f },
-            { rotationMatrix[0][2], rotationMatrix[1][2], rotationMatrix[2][2], 0.0f },
-            { position.x, position.y, position.z, 1.0f }
-        };
+    const Matrix4& Transform::getLocalMatrix() const {
+        return localMatrix;
+    }
+
+    /**
+     *
+     * @return Cached world matrix (parent world * local). Updated by TransformSystem.
+     */
+    const Matrix4& Transform::getWorldMatrix() const {
+        return worldMatrix;
+    }
+
+    /**
+     *
+     * @return Cached inverse of the world matrix. Updated by TransformSystem.
+     */
+    const Matrix4& Transform::getInverseWorldMatrix() const {
+        return invWorldMatrix;
+    }
+
+    /**
+     *
+     * @return World translation in double precision. Updated by TransformSystem.
+     */
+    const Vector3d& Transform::getWorldPosition() const {
+        return worldPosition;
+    }
+
+    /**
+     * @brief World matrix with the translation relative to origin, subtracted in double before rounding to float
+     * @param origin Usually the camera position
+     */
+    Matrix4 Transform::getRelativeWorldMatrix(const Vector3d& origin) const {
+        const Vector3 translation = (worldPosition - origin).toVector3();
+
+        Matrix4 matrix = worldMatrix;
+        matrix[3] = Vector4(translation.x, translation.y, translation.z, 1.0f);
+        return matrix;
+    }
+
+    /**
+     * @brief Inverse of getRelativeWorldMatrix. The inverse translation is -A^-1 * t, with A^-1 the upper 3x3 of
+     * the cached inverse, so the large world translation never goes through a float.
+     * @param origin Usually the camera position
+     */
+    Matrix4 Transform::getRelativeInverseWorldMatrix(const Vector3d& origin) const {
+        const Vector3 translation = (worldPosition - origin).toVector3();
+
+        Matrix4 inverse = invWorldMatrix;
+        inverse[3] = -(inverse[0] * translation.x + inverse[1] * translation.y + inverse[2] * translation.z);
+        inverse[3][3] = 1.0f;
+        return inverse;
+    }
+
+    /**
+     *
+     * @return Counter incremented every time the world matrix is recalculated. Used by caches derived from it.
+     */
+    uint32_t Transform::getVersion() const {
+        return version;
     }
 
     json Transform::serialize() {
@@ -71,9 +124,37 @@ namespace re {
     }
 
     void Transform::serialize(json &component) {
-        position = vec3(component[std::string(NAMEOF(position))].get<std::array<float, 3>>().data());
+        position = vec3d(component[std::string(NAMEOF(position))].get<std::array<double, 3>>().data());
         rotation = quat(component[std::string(NAMEOF(rotation))].get<std::array<float, 4>>().data());
         scale = vec3(component[std::string(NAMEOF(scale))].get<std::array<float, 3>>().data());
+        dirty = true;
+    }
+
+    const Vector3d& Transform::getPosition() const {
+        return position;
+    }
+
+    void Transform::setPosition(const Vector3d& position_) {
+        position = position_;
+        dirty = true;
+    }
+
+    const Vector3& Transform::getScale() const {
+        return scale;
+    }
+
+    void Transform::setScale(const Vector3& scale_) {
+        scale = scale_;
+        dirty = true;
+    }
+
+    const Quaternion& Transform::getRotation() const {
+        return rotation;
+    }
+
+    void Transform::setRotation(const Quaternion& rotation_) {
+        rotation = rotation_;
+        dirty = true;
     }
 
     /**
@@ -90,6 +171,66 @@ namespace re {
      */
     void Transform::setEulerAngles(const vec3 &angles) {
         rotation = Quaternion(angles);
+        dirty = true;
+    }
+
+    /**
+     *
+     * @return True if the local values changed since the last TransformSystem update
+     */
+    bool Transform::isDirty() const {
+        return dirty;
+    }
+
+    /**
+     * @brief Force the world matrix of this Transform and its children to be recalculated, e.g. after reparenting
+     */
+    void Transform::markDirty() {
+        dirty = true;
+    }
+
+    /**
+     * @brief Rebuild the local matrix and its inverse directly from position, rotation and scale. The inverse
+     * transposes the rotation and inverts the scale, no general inverse is needed.
+     */
+    void Transform::updateLocal() {
+        localMatrix = Matrix4::compose(position.toVector3(), rotation, scale);
+
+        // Zero scale has no inverse, the inverse matrices are only used for normals
+        if (std::fabs(scale.x * scale.y * scale.z) > std::numeric_limits<float>::epsilon()) {
+            invLocalMatrix = Matrix4::composeInverse(position.toVector3(), rotation, scale);
+        } else {
+            invLocalMatrix = Matrix4(0.0f);
+            invLocalMatrix[3][3] = 1.0f;
+        }
+
+        dirty = false;
+    }
+
+    /**
+     * @brief Recalculate the world matrices from the parent ones. The world position adds the local position,
+     * rotated and scaled by the parent, to the parent world position in double. Only the small local offset goes
+     * through float math.
+     * @param parent Parent Transform already updated this frame, nullptr for roots
+     */
+    void Transform::updateWorld(const Transform* parent) {
+        if (dirty) updateLocal();
+
+        if (parent) {
+            const Vector3 local = position.toVector3();
+            const Matrix4& parentMatrix = parent->worldMatrix;
+            const Vector4 offset = parentMatrix[0] * local.x + parentMatrix[1] * local.y + parentMatrix[2] * local.z;
+
+            worldPosition = parent->worldPosition + Vector3d(offset.x, offset.y, offset.z);
+            worldMatrix = parent->worldMatrix * localMatrix;
+            invWorldMatrix = invLocalMatrix * parent->invWorldMatrix;
+        } else {
+            worldPosition = position;
+            worldMatrix = localMatrix;
+            invWorldMatrix = invLocalMatrix;
+        }
+
+        version++;
     }
 
 } // namespace re
@@ -6,40 +6,87 @@
 
 #include "engine/math/Matrix4.hpp"
 #include "engine/math/Vector3.hpp"
+#include "engine/math/Vector3d.hpp"
 #include "engine/math/Quaternion.hpp"
 
 
 namespace re {
 
+    /**
+     * @brief Local position, rotation and scale of an Entity. Local and world matrices are cached, setters mark
+     * the Transform dirty and TransformSystem recalculates the world matrices of the dirty subtrees.
+     * Positions are doubles and the world translation is also kept in double, renderers subtract the camera
+     * position from it to get float matrices that stay precise far from the origin.
+     */
     class Transform : public  Component {
-    public:
-        // TODO: Change this for a dynamic uniform object
-        struct Ubo {
-            mat4 mvp;
-            mat4 invTransform;
-        };
+        friend class TransformSystem;
 
     public:
-        Transform(const vec3& position, const vec3& scale, const vec3& angles, Entity* owner);
+        Transform(const vec3d& position, const vec3& scale, const vec3& angles, EntityHandle owner);
+
+        Transform(const vec3d& position, const vec3& scale, const quat& rotation, EntityHandle owner);
+
+        Transform(json& component, EntityHandle owner);
+
+        [[nodiscard]] const Matrix4& getLocalMatrix() const;
+
+        [[nodiscard]] const Matrix4& getWorldMatrix() const;
 
-        Transform(const vec3& position, const vec3& scale, const quat& rotation, Entity* owner);
+        [[nodiscard]] const Matrix4& getInverseWorldMatrix() const;
 
-        Transform(json& component, Entity* owner);
+        [[nodiscard]] const Vector3d& getWorldPosition() const;
 
-        [[nodiscard]] Matrix4 worldMatrix() const;
+        [[nodiscard]] Matrix4 getRelativeWorldMatrix(const Vector3d& origin) const;
+
+        [[nodiscard]] Matrix4 getRelativeInverseWorldMatrix(const Vector3d& origin) const;
+
+        [[nodiscard]] uint32_t getVersion() const;
 
         json serialize() override;
 
         void serialize(json &component) override;
 
+        [[nodiscard]] const Vector3d& getPosition() const;
+
+        void setPosition(const Vector3d& position_);
+
+        [[nodiscard]] const Vector3& getScale() const;
+
+        void setScale(const Vector3& scale_);
+
+        [[nodiscard]] const Quaternion& getRotation() const;
+
+        void setRotation(const Quaternion& rotation_);
+
         [[nodiscard]] Vector3 getEulerAngles() const;
 
         void setEulerAngles(const vec3& angles);
 
-    public:
-        Vector3 position;
+        [[nodiscard]] bool isDirty() const;
+
+        void markDirty();
+
+    private:
+        void updateLocal();
+
+        void updateWorld(const Transform* parent);
+
+    private:
+        Vector3d position;
         Vector3 scale;
         Quaternion rotation;
+        Matrix4 localMatrix{1.0f};
+        Matrix4 invLocalMatrix{1.0f};
+        Matrix4 worldMatrix{1.0f};
+        Matrix4 invWorldMatrix{1.0f};
+        // Translation of the world matrix without the float rounding
+        Vector3d worldPosition;
+        // Incremented each time the world matrix changes
+        uint32_t version{};
+        // Local values changed since the last update
+        bool dirty{true};
+        // Already scheduled in the current TransformSystem update
+        bool queued{};
     };
 
 } // namespace re
@@ -0,0 +1,36 @@
+#include "WorldBounds.hpp"
+
+#include "Transform.hpp"
+#include "engine/assets/Model.hpp"
+
+
+namespace re {
+
+    /**
+     *
+     * @param owner Owner Entity
+     */
+    WorldBounds::WorldBounds(EntityHandle owner) : Component(owner) {
+
+    }
+
+    /**
+     * @brief Recalculate the world bounds if the Transform world matrix or the Model changed since the last update
+     * @param transform Entity Transform
+     * @param model Entity Model
+     * @return True if the bounds were recalculated
+     */
+    bool WorldBounds::update(const Transform &transform, const Model &model) {
+        if (this->model == &model && transformVersion == transform.getVersion())
+            return false;
+
+        this->model = &model;
+        transformVersion = transform.getVersion();
+
+        box = model.getBounds().transformed(transform.getWorldMatrix());
+        sphere = box.empty() ? Sphere() : Sphere(box.center(), box.extents().length());
+
+        return true;
+    }
+
+} // namespace re
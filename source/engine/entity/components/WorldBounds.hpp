@@ -0,0 +1,36 @@
+#ifndef RAVENENGINE_WORLDBOUNDS_HPP
+#define RAVENENGINE_WORLDBOUNDS_HPP
+
+
+#include "Component.hpp"
+
+#include "engine/math/Bounds.hpp"
+
+
+namespace re {
+
+    class Transform;
+    class Model;
+
+    /**
+     * @brief World space bounds of an Entity Model. It's a runtime cache and it's not serialized.
+     */
+    class WorldBounds : public Component {
+    public:
+        explicit WorldBounds(EntityHandle owner);
+
+        bool update(const Transform& transform, const Model& model);
+
+    public:
+        AABB box;
+        Sphere sphere;
+
+    private:
+        const Model* model{};
+        uint32_t transformVersion{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_WORLDBOUNDS_HPP
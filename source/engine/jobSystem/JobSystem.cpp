@@ -1,10 +1,20 @@
 #include "JobSystem.hpp"
 
+#include <algorithm>
+#include <memory>
+
 
 namespace re::jobs {
 
     JobSystem* JobSystem::singleton;
 
+    namespace {
+
+        // 0 on any thread outside the pool, worker i is i + 1
+        thread_local uint32_t threadIndex = 0;
+
+    } // namespace
+
     /**
      * @brief Construct instance and setup threads
      */
@@ -13,7 +23,7 @@ namespace re::jobs {
 
         const unsigned threadCount = std::thread::hardware_concurrency() - 1;
         for (int i = 0; i < threadCount; ++i)
-            pool.emplace_back(&JobSystem::waitJob, this);
+            pool.emplace_back(&JobSystem::waitJob, this, static_cast<uint32_t>(i) + 1);
     }
 
     JobSystem::~JobSystem() {
@@ -42,6 +52,7 @@ namespace re::jobs {
      * @param job void function without parameters
      */
     void JobSystem::submit(Job job) {
+        pending.fetch_add(1, std::memory_order_relaxed);
         {
             std::unique_lock<std::mutex> lock(queueMutex);
             jobs.push(std::move(job));
@@ -56,7 +67,92 @@ namespace re::jobs {
         return jobs.empty();
     }
 
-    void JobSystem::waitJob() {
+    /**
+     * @brief Wait until every submitted job is done, including jobs submitted by them. The calling thread runs
+     * queued jobs meanwhile, so it also works without workers. Must not be called from a job, its own job
+     * would never finish.
+     */
+    void JobSystem::wait() {
+        while (pending.load(std::memory_order_acquire) > 0) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                if (!jobs.empty()) {
+                    job = std::move(jobs.front());
+                    jobs.pop();
+                }
+            }
+
+            if (job)
+                execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Split [0, count) in chunks and run them on the pool. The calling thread also runs chunks and the
+     * function returns when all of them are done, so it's safe to call from a job.
+     * @param count Number of elements
+     * @param chunkSize Number of elements per chunk
+     * @param function Called with the [begin, end) range of each chunk
+     */
+    void JobSystem::parallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function) {
+        if (count == 0) return;
+
+        chunkSize = std::max(chunkSize, 1u);
+        uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount == 1 || pool.empty()) {
+            function(0, count);
+            return;
+        }
+
+        struct State {
+            std::atomic<uint32_t> next{0};
+            std::atomic<uint32_t> done{0};
+        };
+
+        // Helpers that start after all chunks were taken only touch the shared state
+        auto state = std::make_shared<State>();
+        auto run = [state, chunkCount, chunkSize, count, &function] {
+            uint32_t chunk;
+            while ((chunk = state->next.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+                uint32_t begin = chunk * chunkSize;
+                function(begin, std::min(begin + chunkSize, count));
+                state->done.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        auto helpers = std::min(static_cast<uint32_t>(pool.size()), chunkCount - 1);
+        for (uint32_t i = 0; i < helpers; ++i)
+            submit(run);
+
+        run();
+
+        while (state->done.load(std::memory_order_acquire) < chunkCount)
+            std::this_thread::yield();
+    }
+
+    /**
+     *
+     * @return Number of worker threads
+     */
+    uint32_t JobSystem::getThreadCount() const {
+        return static_cast<uint32_t>(pool.size());
+    }
+
+    /**
+     * @brief Index of the calling thread, to give each thread its own resources, like command pools.
+     * Workers are 1 to getThreadCount(), the thread that created the JobSystem and any other thread is 0.
+     */
+    uint32_t JobSystem::getThreadIndex() {
+        return threadIndex;
+    }
+
+    void JobSystem::waitJob(uint32_t index) {
+        threadIndex = index;
+
         while (true) {
             Job job;
             {
@@ -68,8 +164,18 @@ namespace re::jobs {
                 job = std::move(jobs.front());
                 jobs.pop();
             }
-            job();
+            execute(job);
         }
     }
 
+    void JobSystem::execute(Job& job) {
+        // Counted as finished even if it throws, so wait() doesn't hang on it
+        struct Finish {
+            std::atomic<uint32_t>& pending;
+            ~Finish() { pending.fetch_sub(1, std::memory_order_release); }
+        } finish{pending};
+
+        job();
+    }
+
 } // namespace re::jobs
\ No newline at end of file
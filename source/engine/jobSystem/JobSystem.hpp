@@ -16,11 +16,16 @@ namespace re {
 
     class Engine;
 
+    namespace bench {
+        class Runner;
+    }
+
     namespace jobs {
         using Job = std::function<void()>;
 
         class JobSystem : NonCopyable {
             friend re::Engine;
+            friend re::bench::Runner;
 
             JobSystem();
 
@@ -34,14 +39,26 @@ namespace re {
 
             bool empty();
 
+            void wait();
+
+            void parallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function);
+
+            [[nodiscard]] uint32_t getThreadCount() const;
+
+            static uint32_t getThreadIndex();
+
         private:
-            void waitJob();
+            void waitJob(uint32_t index);
+
+            void execute(Job& job);
 
         private:
             static JobSystem* singleton;
             bool done;
             std::queue<Job> jobs;
             std::mutex queueMutex;
+            // Submitted jobs that didn't finish yet, queued or running
+            std::atomic<uint32_t> pending{0};
             std::vector<std::thread> pool;
             std::mutex poolMutex;
             std::condition_variable poolSignal;
@@ -55,6 +72,18 @@ namespace re {
             return JobSystem::getInstance()->empty();
         }
 
+        inline void wait() {
+            JobSystem::getInstance()->wait();
+        }
+
+        inline void parallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function) {
+            JobSystem::getInstance()->parallelFor(count, chunkSize, function);
+        }
+
+        inline uint32_t getThreadIndex() {
+            return JobSystem::getThreadIndex();
+        }
+
     } // namespace jobs
 
 } // namespace re
@@ -354,42 +354,4 @@ namespace re {
                  {0.0, 0.0, 1.0} };
     }
 
-    Basis Basis::operator*(const Basis &m) const {
-        float const SrcA00 = elements[0][0];
-        float const SrcA01 = elements[0][1];
-        float const SrcA02 = elements[0][2];
-        float const SrcA10 = elements[1][0];
-        float const SrcA11 = elements[1][1];
-        float const SrcA12 = elements[1][2];
-        float const SrcA20 = elements[2][0];
-        float const SrcA21 = elements[2][1];
-        float const SrcA22 = elements[2][2];
-
-        float const SrcB00 = m[0][0];
-        float const SrcB01 = m[0][1];
-        float const SrcB02 = m[0][2];
-        float const SrcB10 = m[1][0];
-        float const SrcB11 = m[1][1];
-        float const SrcB12 = m[1][2];
-        float const SrcB20 = m[2][0];
-        float const SrcB21 = m[2][1];
-        float const SrcB22 = m[2][2];
-
-        return {
-                {
-                        SrcA00 * SrcB00 + SrcA10 * SrcB01 + SrcA20 * SrcB02,
-                        SrcA01 * SrcB00 + SrcA11 * SrcB01 + SrcA21 * SrcB02,
-                        SrcA02 * SrcB00 + SrcA12 * SrcB01 + SrcA22 * SrcB02
-                }, {
-                        SrcA00 * SrcB10 + SrcA10 * SrcB11 + SrcA20 * SrcB12,
-                        SrcA01 * SrcB10 + SrcA11 * SrcB11 + SrcA21 * SrcB12,
-                        SrcA02 * SrcB10 + SrcA12 * SrcB11 + SrcA22 * SrcB12
-                }, {
-                        SrcA00 * SrcB20 + SrcA10 * SrcB21 + SrcA20 * SrcB22,
-                        SrcA01 * SrcB20 + SrcA11 * SrcB21 + SrcA21 * SrcB22,
-                        SrcA02 * SrcB20 + SrcA12 * SrcB21 + SrcA22 * SrcB22
-                }
-        };
-    }
-
 } // namespace re
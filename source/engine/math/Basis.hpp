@@ -10,11 +10,11 @@ namespace re {
 
     class Basis {
     public:
-        inline Basis() = default;
+        constexpr Basis() = default;
 
-        inline explicit Basis(float n);
+        constexpr explicit Basis(float n);
 
-        inline Basis(const Vector3& x, const Vector3& y, const Vector3& z);
+        constexpr Basis(const Vector3& x, const Vector3& y, const Vector3& z);
 
         inline explicit Basis(const Quaternion& q, const Vector3& s = {1.0f, 1.0f, 1.0f});
 
@@ -22,17 +22,17 @@ namespace re {
 
         inline explicit Basis(const Vector3& angles, const Vector3& s = {1.0f, 1.0f, 1.0f});
 
-        inline Basis(const Basis&) = default;
+        constexpr Basis(const Basis&) = default;
 
         void invert();
 
         Basis inverted();
 
-        inline void transpose();
+        constexpr void transpose();
 
-        inline Basis transposed();
+        [[nodiscard]] constexpr Basis transposed() const;
 
-        inline float determinant();
+        [[nodiscard]] constexpr float determinant() const;
 
         void rotate(const Quaternion& q, const Vector3& s = {1.0f, 1.0f, 1.0f});
 
@@ -46,9 +46,9 @@ namespace re {
 
         [[nodiscard]] Basis rotated(const Vector3& angles, const Vector3& s = {1.0f, 1.0f, 1.0f}) const;
 
-        inline void scale(const Vector3& s);
+        constexpr void scale(const Vector3& s);
 
-        inline Basis scaled(const Vector3& s);
+        [[nodiscard]] constexpr Basis scaled(const Vector3& s) const;
 
         void setQuaternion(const Quaternion& q, const Vector3& s = {1.0f, 1.0f, 1.0f});
 
@@ -62,11 +62,11 @@ namespace re {
 
         void getAxis(float& angle, Vector3& axis);
 
-        inline void setIdentity();
+        constexpr void setIdentity();
 
-        inline void setZero();
+        constexpr void setZero();
 
-        inline void setDiagonal(const Vector3& dig);
+        constexpr void setDiagonal(const Vector3& dig);
 
         [[nodiscard]] std::string str() const;
 
@@ -100,41 +100,41 @@ namespace re {
 
         static Basis rotationZ(float theta);
 
-        inline Basis& operator=(const Basis&) = default;
+        constexpr Basis& operator=(const Basis&) = default;
 
-        inline Basis& operator=(Basis&&) = default;
+        constexpr Basis& operator=(Basis&&) = default;
 
-        inline Vector3& operator[](size_t i);
+        constexpr Vector3& operator[](size_t i);
 
-        inline const Vector3& operator[](size_t i) const;
+        constexpr const Vector3& operator[](size_t i) const;
 
-        inline Basis operator-() const;
+        constexpr Basis operator-() const;
 
-        inline void operator+=(const Basis& m);
+        constexpr void operator+=(const Basis& m);
 
-        inline void operator-=(const Basis& m);
+        constexpr void operator-=(const Basis& m);
 
-        inline void operator*=(float n);
+        constexpr void operator*=(float n);
 
-        inline void operator*=(const Basis& m);
+        constexpr void operator*=(const Basis& m);
 
-        inline void operator/=(float n);
+        constexpr void operator/=(float n);
 
-        inline Basis operator+(const Basis& m) const;
+        constexpr Basis operator+(const Basis& m) const;
 
-        inline Basis operator-(const Basis& m) const;
+        constexpr Basis operator-(const Basis& m) const;
 
-        inline Basis operator*(float n) const;
+        constexpr Basis operator*(float n) const;
 
-        inline Vector3 operator*(const Vector3& v) const;
+        constexpr Vector3 operator*(const Vector3& v) const;
 
-        Basis operator*(const Basis& m) const;
+        constexpr Basis operator*(const Basis& m) const;
 
-        inline Basis operator/(float n) const;
+        constexpr Basis operator/(float n) const;
 
-        inline bool operator==(const Basis& m) const;
+        constexpr bool operator==(const Basis& m) const;
 
-        inline bool operator!=(const Basis& m) const;
+        constexpr bool operator!=(const Basis& m) const;
 
         Vector3 elements[3] = {
                 {1.0f, 0.0f, 0.0f},
@@ -143,19 +143,19 @@ namespace re {
         };
     };
 
-    Basis::Basis(float n) {
+    constexpr Basis::Basis(float n) {
         elements[0][0] = n;
         elements[0][1] = 0.0f;
         elements[0][2] = 0.0f;
         elements[1][0] = 0.0f;
-        elements[1][2] = n;
-        elements[1][3] = 0.0f;
+        elements[1][1] = n;
+        elements[1][2] = 0.0f;
         elements[2][0] = 0.0f;
         elements[2][1] = 0.0f;
         elements[2][2] = n;
     }
 
-    Basis::Basis(const Vector3 &x, const Vector3 &y, const Vector3 &z) {
+    constexpr Basis::Basis(const Vector3 &x, const Vector3 &y, const Vector3 &z) {
         elements[0] = x;
         elements[1] = y;
         elements[2] = z;
@@ -173,11 +173,11 @@ namespace re {
         setEuler(angles, s);
     }
 
-    void Basis::transpose() {
+    constexpr void Basis::transpose() {
         *this = transposed();
     }
 
-    Basis Basis::transposed() {
+    constexpr Basis Basis::transposed() const {
         return {
             {elements[0][0], elements[1][0], elements[2][0]},
             {elements[0][1], elements[1][1], elements[2][1]},
@@ -185,7 +185,7 @@ namespace re {
         };
     }
 
-    float Basis::determinant() {
+    constexpr float Basis::determinant() const {
         return (elements[0][0] * elements[1][1] * elements[2][2]) +
                (elements[0][1] * elements[1][2] * elements[2][0]) +
                (elements[0][2] * elements[1][0] * elements[2][1]) -
@@ -194,11 +194,11 @@ namespace re {
                (elements[0][1] * elements[1][0] * elements[2][2]);
     }
 
-    void Basis::scale(const Vector3 &s) {
+    constexpr void Basis::scale(const Vector3 &s) {
         *this = scaled(s);
     }
 
-    Basis Basis::scaled(const Vector3 &s) {
+    constexpr Basis Basis::scaled(const Vector3 &s) const {
         return {
             elements[0] * s.x,
             elements[1] * s.y,
@@ -215,7 +215,7 @@ namespace re {
         return matrix2EulerAnglesYXZ(*this);
     }
 
-    void Basis::setIdentity() {
+    constexpr void Basis::setIdentity() {
         elements[0][0] = 1.0f;
         elements[0][1] = 0.0f;
         elements[0][2] = 0.0f;
@@ -227,7 +227,7 @@ namespace re {
         elements[2][2] = 1.0f;
     }
 
-    void Basis::setZero() {
+    constexpr void Basis::setZero() {
         elements[0][0] = 0.0f;
         elements[0][1] = 0.0f;
         elements[0][2] = 0.0f;
@@ -239,7 +239,7 @@ namespace re {
         elements[2][2] = 0.0f;
     }
 
-    void Basis::setDiagonal(const Vector3 &dig) {
+    constexpr void Basis::setDiagonal(const Vector3 &dig) {
         elements[0][0] = dig.x;
         elements[0][1] = 0.0f;
         elements[0][2] = 0.0f;
@@ -251,72 +251,110 @@ namespace re {
         elements[2][2] = dig.z;
     }
 
-    Vector3 &Basis::operator[](size_t i) {
+    constexpr Vector3 &Basis::operator[](size_t i) {
         return elements[i];
     }
 
-    const Vector3 &Basis::operator[](size_t i) const {
+    constexpr const Vector3 &Basis::operator[](size_t i) const {
         return elements[i];
     }
 
-    Basis Basis::operator-() const {
+    constexpr Basis Basis::operator-() const {
         return {-elements[0], -elements[1], -elements[2]};
     }
 
-    void Basis::operator+=(const Basis &m) {
+    constexpr void Basis::operator+=(const Basis &m) {
         *this = *this + m;
     }
 
-    void Basis::operator-=(const Basis &m) {
+    constexpr void Basis::operator-=(const Basis &m) {
         *this = *this - m;
     }
 
-    void Basis::operator*=(float n) {
+    constexpr void Basis::operator*=(float n) {
         *this = *this * n;
     }
 
-    void Basis::operator*=(const Basis &m) {
+    constexpr void Basis::operator*=(const Basis &m) {
         *this = *this * m;
     }
 
-    void Basis::operator/=(float n) {
+    constexpr void Basis::operator/=(float n) {
         *this = *this / n;
     }
 
-    Basis Basis::operator+(const Basis &m) const {
+    constexpr Basis Basis::operator+(const Basis &m) const {
         return {elements[0] + m[0], elements[1] + m[1], elements[2] + m[2]};
     }
 
-    Basis Basis::operator-(const Basis &m) const {
+    constexpr Basis Basis::operator-(const Basis &m) const {
         return {elements[0] - m[0], elements[1] - m[1], elements[2] - m[2]};
     }
 
-    Basis Basis::operator*(float n) const {
+    constexpr Basis Basis::operator*(float n) const {
         return {elements[0] * n, elements[1] * n, elements[2] * n};
     }
 
-    Vector3 Basis::operator*(const Vector3 &v) const {
+    constexpr Vector3 Basis::operator*(const Vector3 &v) const {
         return {elements[0].dot(v), elements[1].dot(v), elements[2].dot(v)};
     }
 
-    Basis Basis::operator/(float n) const {
+    constexpr Basis Basis::operator*(const Basis &m) const {
+        float const SrcA00 = elements[0][0];
+        float const SrcA01 = elements[0][1];
+        float const SrcA02 = elements[0][2];
+        float const SrcA10 = elements[1][0];
+        float const SrcA11 = elements[1][1];
+        float const SrcA12 = elements[1][2];
+        float const SrcA20 = elements[2][0];
+        float const SrcA21 = elements[2][1];
+        float const SrcA22 = elements[2][2];
+
+        float const SrcB00 = m[0][0];
+        float const SrcB01 = m[0][1];
+        float const SrcB02 = m[0][2];
+        float const SrcB10 = m[1][0];
+        float const SrcB11 = m[1][1];
+        float const SrcB12 = m[1][2];
+        float const SrcB20 = m[2][0];
+        float const SrcB21 = m[2][1];
+        float const SrcB22 = m[2][2];
+
+        return {
+                {
+                        SrcA00 * SrcB00 + SrcA10 * SrcB01 + SrcA20 * SrcB02,
+                        SrcA01 * SrcB00 + SrcA11 * SrcB01 + SrcA21 * SrcB02,
+                        SrcA02 * SrcB00 + SrcA12 * SrcB01 + SrcA22 * SrcB02
+                }, {
+                        SrcA00 * SrcB10 + SrcA10 * SrcB11 + SrcA20 * SrcB12,
+                        SrcA01 * SrcB10 + SrcA11 * SrcB11 + SrcA21 * SrcB12,
+                        SrcA02 * SrcB10 + SrcA12 * SrcB11 + SrcA22 * SrcB12
+                }, {
+                        SrcA00 * SrcB20 + SrcA10 * SrcB21 + SrcA20 * SrcB22,
+                        SrcA01 * SrcB20 + SrcA11 * SrcB21 + SrcA21 * SrcB22,
+                        SrcA02 * SrcB20 + SrcA12 * SrcB21 + SrcA22 * SrcB22
+                }
+        };
+    }
+
+    constexpr Basis Basis::operator/(float n) const {
         return {elements[0] / n, elements[1] / n, elements[2] / n};
     }
 
-    inline Basis operator*(float s, const Basis& m) {
+    constexpr Basis operator*(float s, const Basis& m) {
         return m * s;
     }
 
-    inline Basis operator/(float s, const Basis& m) {
+    constexpr Basis operator/(float s, const Basis& m) {
         return m / s;
     }
 
-    bool Basis::operator==(const Basis &m) const {
+    constexpr bool Basis::operator==(const Basis &m) const {
         return elements[0] == m[0] && elements[1] == m[1] && elements[2] == m[2];
     }
 
-    bool Basis::operator!=(const Basis &m) const {
-        return elements[0] != m[0] && elements[1] != m[1] && elements[2] != m[2];
+    constexpr bool Basis::operator!=(const Basis &m) const {
+        return elements[0] != m[0] || elements[1] != m[1] || elements[2] != m[2];
     }
 
 } // namespace re
@@ -0,0 +1,251 @@
+#include "Batch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#include "Lanes.hpp"
+
+
+namespace re::math {
+
+    namespace {
+
+        using namespace lanes;
+
+        /**
+         *
+         * @param columns columns[j][i] is component i of column j of every matrix of the group
+         * @param n Matrices written, out is only accessed up to n
+         */
+        inline void storeMatrices(const Lane (&columns)[4][4], Matrix4* out, uint32_t n) {
+            if constexpr (BATCH_WIDTH > 1) {
+                if (n < BATCH_WIDTH) {
+                    Matrix4 group[BATCH_WIDTH];
+                    storeMatrices(columns, group, BATCH_WIDTH);
+                    std::copy_n(group, n, out);
+                    return;
+                }
+            }
+
+            for (int j = 0; j < 4; ++j)
+                storeColumn(out, j, columns[j][0], columns[j][1], columns[j][2], columns[j][3]);
+        }
+
+        /**
+         * @brief Rotation matrices of a group of quaternions, same terms as Matrix4::compose
+         * @param r r[j][i] is component i of column j
+         */
+        inline void rotationLanes(Lane w, Lane x, Lane y, Lane z, Lane (&r)[3][3]) {
+            Lane d = div(set(2.0f), madd(w, w, madd(x, x, madd(y, y, mul(z, z)))));
+            Lane xs = mul(x, d), ys = mul(y, d), zs = mul(z, d);
+            Lane wx = mul(w, xs), wy = mul(w, ys), wz = mul(w, zs);
+            Lane xx = mul(x, xs), xy = mul(x, ys), xz = mul(x, zs);
+            Lane yy = mul(y, ys), yz = mul(y, zs), zz = mul(z, zs);
+            Lane one = set(1.0f);
+
+            r[0][0] = sub(one, add(yy, zz));
+            r[0][1] = add(xy, wz);
+            r[0][2] = sub(xz, wy);
+            r[1][0] = sub(xy, wz);
+            r[1][1] = sub(one, add(xx, zz));
+            r[1][2] = add(yz, wx);
+            r[2][0] = add(xz, wy);
+            r[2][1] = sub(yz, wx);
+            r[2][2] = sub(one, add(xx, yy));
+        }
+
+    } // namespace
+
+    /**
+     * @brief Homogeneous transform of count points with w = 1, same result as Matrix4::transformPoint
+     * @param m Matrix applied to every point
+     * @param out Arrays with room for count values, can't alias points
+     */
+    void transformPoints(const Matrix4& m, const PointArrays& points, uint32_t count, const ClipArrays& out) {
+        const Lane m00 = set(m[0][0]), m01 = set(m[0][1]), m02 = set(m[0][2]), m03 = set(m[0][3]);
+        const Lane m10 = set(m[1][0]), m11 = set(m[1][1]), m12 = set(m[1][2]), m13 = set(m[1][3]);
+        const Lane m20 = set(m[2][0]), m21 = set(m[2][1]), m22 = set(m[2][2]), m23 = set(m[2][3]);
+        const Lane m30 = set(m[3][0]), m31 = set(m[3][1]), m32 = set(m[3][2]), m33 = set(m[3][3]);
+        const float* px = points.x;
+        const float* py = points.y;
+        const float* pz = points.z;
+        float* ox = out.x;
+        float* oy = out.y;
+        float* oz = out.z;
+        float* ow = out.w;
+
+        forEachGroup(count, [&](uint32_t first, uint32_t n) {
+            Lane x = load(px + first, n);
+            Lane y = load(py + first, n);
+            Lane z = load(pz + first, n);
+
+            store(ox + first, madd(m00, x, madd(m10, y, madd(m20, z, m30))), n);
+            store(oy + first, madd(m01, x, madd(m11, y, madd(m21, z, m31))), n);
+            store(oz + first, madd(m02, x, madd(m12, y, madd(m22, z, m32))), n);
+            store(ow + first, madd(m03, x, madd(m13, y, madd(m23, z, m33))), n);
+        });
+    }
+
+    /**
+     * @brief out[i] = viewProj * matrices[i]. With AVX2 two matrices share each register.
+     * @param out Room for count matrices, can be matrices
+     */
+    void multiply(const Matrix4& viewProj, const Matrix4* matrices, uint32_t count, Matrix4* out) {
+        uint32_t i = 0;
+
+#if defined(RE_SIMD_FMA)
+        __m256 a[4];
+        for (int k = 0; k < 4; ++k)
+            a[k] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(viewProj[k].values));
+
+        for (; i + 2 <= count; i += 2) {
+            __m256 columns[4];
+            for (int j = 0; j < 4; ++j)
+                columns[j] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(matrices[i][j].values)), _mm_load_ps(matrices[i + 1][j].values), 1);
+
+            for (int j = 0; j < 4; ++j) {
+                __m256 result = _mm256_mul_ps(a[0], _mm256_permute_ps(columns[j], 0x00));
+                result = _mm256_fmadd_ps(a[1], _mm256_permute_ps(columns[j], 0x55), result);
+                result = _mm256_fmadd_ps(a[2], _mm256_permute_ps(columns[j], 0xAA), result);
+                result = _mm256_fmadd_ps(a[3], _mm256_permute_ps(columns[j], 0xFF), result);
+
+                _mm_store_ps(out[i][j].values, _mm256_castps256_ps128(result));
+                _mm_store_ps(out[i + 1][j].values, _mm256_extractf128_ps(result, 1));
+            }
+        }
+#endif
+
+#if defined(RE_SIMD_SSE4)
+        __m128 a0 = _mm_load_ps(viewProj[0].values);
+        __m128 a1 = _mm_load_ps(viewProj[1].values);
+        __m128 a2 = _mm_load_ps(viewProj[2].values);
+        __m128 a3 = _mm_load_ps(viewProj[3].values);
+
+        for (; i < count; ++i) {
+            __m128 columns[4];
+            for (int j = 0; j < 4; ++j)
+                columns[j] = _mm_load_ps(matrices[i][j].values);
+
+            for (int j = 0; j < 4; ++j) {
+                __m128 result = _mm_mul_ps(a0, simd::splat<0>(columns[j]));
+                result = simd::madd(a1, simd::splat<1>(columns[j]), result);
+                result = simd::madd(a2, simd::splat<2>(columns[j]), result);
+                result = simd::madd(a3, simd::splat<3>(columns[j]), result);
+
+                _mm_store_ps(out[i][j].values, result);
+            }
+        }
+#else
+        for (; i < count; ++i)
+            out[i] = viewProj * matrices[i];
+#endif
+    }
+
+    /**
+     * @brief Matrix4::compose of count transforms
+     * @param out Room for count matrices
+     */
+    void compose(const TransformArrays& transforms, uint32_t count, Matrix4* out) {
+        const TransformArrays t = transforms;
+        const Lane zero = set(0.0f), one = set(1.0f);
+
+        forEachGroup(count, [&](uint32_t first, uint32_t n) {
+            Lane r[3][3];
+            rotationLanes(load(t.rotationW + first, n), load(t.rotationX + first, n),
+                          load(t.rotationY + first, n), load(t.rotationZ + first, n), r);
+
+            Lane sx = load(t.scaleX + first, n), sy = load(t.scaleY + first, n), sz = load(t.scaleZ + first, n);
+
+            const Lane columns[4][4] = {
+                {mul(r[0][0], sx), mul(r[0][1], sy), mul(r[0][2], sz), zero},
+                {mul(r[1][0], sx), mul(r[1][1], sy), mul(r[1][2], sz), zero},
+                {mul(r[2][0], sx), mul(r[2][1], sy), mul(r[2][2], sz), zero},
+                {load(t.positionX + first, n), load(t.positionY + first, n), load(t.positionZ + first, n), one}
+            };
+
+            storeMatrices(columns, out + first, n);
+        });
+    }
+
+    /**
+     * @brief Matrix4::composeInverse of count transforms. Transforms with zero scale have no inverse, they
+     * get a zero 3x3 part and no translation like Transform does.
+     * @param out Room for count matrices
+     */
+    void composeInverse(const TransformArrays& transforms, uint32_t count, Matrix4* out) {
+        const TransformArrays t = transforms;
+        const Lane zero = set(0.0f), one = set(1.0f), epsilon = set(std::numeric_limits<float>::epsilon());
+
+        forEachGroup(count, [&](uint32_t first, uint32_t n) {
+            Lane r[3][3];
+            rotationLanes(load(t.rotationW + first, n), load(t.rotationX + first, n),
+                          load(t.rotationY + first, n), load(t.rotationZ + first, n), r);
+
+            Lane sx = load(t.scaleX + first, n), sy = load(t.scaleY + first, n), sz = load(t.scaleZ + first, n);
+            Mask invertible = greater(abs(mul(mul(sx, sy), sz)), epsilon);
+            Lane ix = select(invertible, div(one, sx));
+            Lane iy = select(invertible, div(one, sy));
+            Lane iz = select(invertible, div(one, sz));
+
+            // Column j of the inverse is row j of the rotation divided by scale j
+            Lane c0[3] = {mul(r[0][0], ix), mul(r[1][0], ix), mul(r[2][0], ix)};
+            Lane c1[3] = {mul(r[0][1], iy), mul(r[1][1], iy), mul(r[2][1], iy)};
+            Lane c2[3] = {mul(r[0][2], iz), mul(r[1][2], iz), mul(r[2][2], iz)};
+
+            Lane px = load(t.positionX + first, n), py = load(t.positionY + first, n), pz = load(t.positionZ + first, n);
+            auto translation = [&](int i) { return sub(zero, madd(c0[i], px, madd(c1[i], py, mul(c2[i], pz)))); };
+
+            const Lane columns[4][4] = {
+                {c0[0], c0[1], c0[2], zero},
+                {c1[0], c1[1], c1[2], zero},
+                {c2[0], c2[1], c2[2], zero},
+                {translation(0), translation(1), translation(2), one}
+            };
+
+            storeMatrices(columns, out + first, n);
+        });
+    }
+
+    /**
+     * @brief Frustum::intersects(Sphere) for count spheres
+     * @param visible Receives the indices of the spheres inside or intersecting the frustum in increasing order,
+     * needs room for count indices
+     * @return Number of visible spheres
+     */
+    uint32_t cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint32_t count, uint32_t* visible) {
+        Lane planes[Frustum::PLANE_COUNT][4];
+        for (int p = 0; p < Frustum::PLANE_COUNT; ++p)
+            for (int i = 0; i < 4; ++i)
+                planes[p][i] = set(frustum.planes[p][i]);
+
+        const SphereArrays s = spheres;
+        const Lane zero = set(0.0f);
+        uint32_t visibleCount = 0;
+
+        forEachGroup(count, [&](uint32_t first, uint32_t n) {
+            Lane x = load(s.centerX + first, n);
+            Lane y = load(s.centerY + first, n);
+            Lane z = load(s.centerZ + first, n);
+            Lane minDistance = sub(zero, load(s.radius + first, n));
+
+            // Inside while the signed distance to every plane is at least -radius
+            auto inside = [&](int p) {
+                return greaterEqual(madd(planes[p][0], x, madd(planes[p][1], y, madd(planes[p][2], z, planes[p][3]))), minDistance);
+            };
+
+            Mask mask = maskAnd(maskAnd(inside(Frustum::LEFT), inside(Frustum::RIGHT)),
+                                maskAnd(maskAnd(inside(Frustum::BOTTOM), inside(Frustum::TOP)),
+                                        maskAnd(inside(Frustum::ZNEAR), inside(Frustum::ZFAR))));
+
+            uint32_t visibleLanes = bits(mask) & ((1u << n) - 1);
+            while (visibleLanes != 0) {
+                visible[visibleCount++] = first + static_cast<uint32_t>(std::countr_zero(visibleLanes));
+                visibleLanes &= visibleLanes - 1;
+            }
+        });
+
+        return visibleCount;
+    }
+
+} // namespace re::math
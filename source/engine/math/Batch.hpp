@@ -0,0 +1,78 @@
+#ifndef RAVENENGINE_BATCH_HPP
+#define RAVENENGINE_BATCH_HPP
+
+
+#include <cstdint>
+
+#include "Simd.hpp"
+#include "Matrix4.hpp"
+#include "Frustum.hpp"
+
+
+namespace re::math {
+
+    // Values processed by each instruction of the batch kernels
+#if defined(RE_SIMD_FMA)
+    constexpr uint32_t BATCH_WIDTH = 8;
+#elif defined(RE_SIMD_SSE4)
+    constexpr uint32_t BATCH_WIDTH = 4;
+#else
+    constexpr uint32_t BATCH_WIDTH = 1;
+#endif
+
+    /**
+     * @brief Points as structure of arrays, each array holds the batch count values
+     */
+    struct PointArrays {
+        const float* x;
+        const float* y;
+        const float* z;
+    };
+
+    /**
+     * @brief Output of transformPoints, homogeneous points as structure of arrays
+     */
+    struct ClipArrays {
+        float* x;
+        float* y;
+        float* z;
+        float* w;
+    };
+
+    /**
+     * @brief Position, rotation (W - X - Y - Z) and scale of each transform as structure of arrays
+     */
+    struct TransformArrays {
+        const float* positionX;
+        const float* positionY;
+        const float* positionZ;
+        const float* rotationW;
+        const float* rotationX;
+        const float* rotationY;
+        const float* rotationZ;
+        const float* scaleX;
+        const float* scaleY;
+        const float* scaleZ;
+    };
+
+    struct SphereArrays {
+        const float* centerX;
+        const float* centerY;
+        const float* centerZ;
+        const float* radius;
+    };
+
+    void transformPoints(const Matrix4& m, const PointArrays& points, uint32_t count, const ClipArrays& out);
+
+    void multiply(const Matrix4& viewProj, const Matrix4* matrices, uint32_t count, Matrix4* out);
+
+    void compose(const TransformArrays& transforms, uint32_t count, Matrix4* out);
+
+    void composeInverse(const TransformArrays& transforms, uint32_t count, Matrix4* out);
+
+    uint32_t cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint32_t count, uint32_t* visible);
+
+} // namespace re::math
+
+
+#endif //RAVENENGINE_BATCH_HPP
@@ -0,0 +1,79 @@
+#include "Bounds.hpp"
+
+#include <utility>
+
+
+namespace re {
+
+    /**
+     *
+     * @param sphere Sphere to test
+     * @return True if the sphere touches or is inside the box
+     */
+    bool AABB::intersects(const Sphere &sphere) const {
+        float distance = 0.0f;
+
+        for (int i = 0; i < 3; ++i) {
+            float closest = std::fmax(min[i], std::fmin(sphere.center[i], max[i]));
+            distance += (sphere.center[i] - closest) * (sphere.center[i] - closest);
+        }
+
+        return distance <= sphere.radius * sphere.radius;
+    }
+
+    /**
+     * @brief Slab test
+     * @param ray Ray to test
+     * @param maxDistance Hits further than this distance along the ray are ignored
+     * @param distance Distance along the ray to the entry point, 0 if the origin is inside the box
+     * @return True if the ray hits the box
+     */
+    bool AABB::intersects(const Ray &ray, float maxDistance, float &distance) const {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int i = 0; i < 3; ++i) {
+            if (std::fabs(ray.direction[i]) < std::numeric_limits<float>::epsilon()) {
+                if (ray.origin[i] < min[i] || ray.origin[i] > max[i]) return false;
+                continue;
+            }
+
+            float invDirection = 1.0f / ray.direction[i];
+            float t0 = (min[i] - ray.origin[i]) * invDirection;
+            float t1 = (max[i] - ray.origin[i]) * invDirection;
+            if (t0 > t1) std::swap(t0, t1);
+
+            tMin = std::fmax(tMin, t0);
+            tMax = std::fmin(tMax, t1);
+            if (tMin > tMax) return false;
+        }
+
+        distance = tMin;
+        return true;
+    }
+
+    /**
+     * @brief Transform the box and return the box that encloses the result
+     * @param m Affine transform. Matrix4 stores columns, elements[3] is the translation.
+     * @return Transformed box
+     */
+    AABB AABB::transformed(const Matrix4 &m) const {
+        if (empty()) return {};
+
+        Vector3 c = center();
+        Vector3 e = extents();
+
+        Vector3 newCenter{m[3][0], m[3][1], m[3][2]};
+        Vector3 newExtents{0.0f};
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                newCenter[i] += m[j][i] * c[j];
+                newExtents[i] += std::fabs(m[j][i]) * e[j];
+            }
+        }
+
+        return {newCenter - newExtents, newCenter + newExtents};
+    }
+
+} // namespace re
@@ -0,0 +1,130 @@
+#ifndef RAVENENGINE_BOUNDS_HPP
+#define RAVENENGINE_BOUNDS_HPP
+
+
+#include <limits>
+#include <cmath>
+
+#include "Vector3.hpp"
+#include "Matrix4.hpp"
+
+
+namespace re {
+
+    class Sphere;
+    class Ray;
+
+    /**
+     * @brief Axis aligned bounding box. A default constructed box is empty (min > max).
+     */
+    class AABB {
+    public:
+        inline AABB() = default;
+
+        inline AABB(const Vector3& min, const Vector3& max);
+
+        inline void expand(const Vector3& point);
+
+        inline void merge(const AABB& box);
+
+        [[nodiscard]] inline bool empty() const;
+
+        [[nodiscard]] inline Vector3 center() const;
+
+        [[nodiscard]] inline Vector3 extents() const;
+
+        [[nodiscard]] inline float surfaceArea() const;
+
+        [[nodiscard]] inline bool contains(const AABB& box) const;
+
+        [[nodiscard]] inline bool intersects(const AABB& box) const;
+
+        [[nodiscard]] bool intersects(const Sphere& sphere) const;
+
+        [[nodiscard]] bool intersects(const Ray& ray, float maxDistance, float& distance) const;
+
+        [[nodiscard]] AABB transformed(const Matrix4& m) const;
+
+        Vector3 min{std::numeric_limits<float>::max()};
+        Vector3 max{-std::numeric_limits<float>::max()};
+    };
+
+    class Sphere {
+    public:
+        inline Sphere() = default;
+
+        inline Sphere(const Vector3& center, float radius);
+
+        Vector3 center;
+        float radius{};
+    };
+
+    /**
+     * @brief Half line. The direction is expected to be normalized.
+     */
+    class Ray {
+    public:
+        inline Ray() = default;
+
+        inline Ray(const Vector3& origin, const Vector3& direction);
+
+        Vector3 origin;
+        Vector3 direction;
+    };
+
+    AABB::AABB(const Vector3 &min, const Vector3 &max) : min(min), max(max) {
+
+    }
+
+    void AABB::expand(const Vector3 &point) {
+        min = {std::fmin(min.x, point.x), std::fmin(min.y, point.y), std::fmin(min.z, point.z)};
+        max = {std::fmax(max.x, point.x), std::fmax(max.y, point.y), std::fmax(max.z, point.z)};
+    }
+
+    void AABB::merge(const AABB &box) {
+        if (box.empty()) return;
+
+        expand(box.min);
+        expand(box.max);
+    }
+
+    bool AABB::empty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    Vector3 AABB::center() const {
+        return (min + max) * 0.5f;
+    }
+
+    Vector3 AABB::extents() const {
+        return (max - min) * 0.5f;
+    }
+
+    float AABB::surfaceArea() const {
+        Vector3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool AABB::contains(const AABB &box) const {
+        return min.x <= box.min.x && min.y <= box.min.y && min.z <= box.min.z &&
+               box.max.x <= max.x && box.max.y <= max.y && box.max.z <= max.z;
+    }
+
+    bool AABB::intersects(const AABB &box) const {
+        return min.x <= box.max.x && box.min.x <= max.x &&
+               min.y <= box.max.y && box.min.y <= max.y &&
+               min.z <= box.max.z && box.min.z <= max.z;
+    }
+
+    Sphere::Sphere(const Vector3 &center, float radius) : center(center), radius(radius) {
+
+    }
+
+    Ray::Ray(const Vector3 &origin, const Vector3 &direction) : origin(origin), direction(direction) {
+
+    }
+
+} // namespace re
+
+
+#endif //RAVENENGINE_BOUNDS_HPP
@@ -0,0 +1,145 @@
+#ifndef RAVENENGINE_CONSTMATH_HPP
+#define RAVENENGINE_CONSTMATH_HPP
+
+
+#include <cstdint>
+#include <limits>
+
+#include "Typedefs.hpp"
+
+
+/**
+ * Approximations of the <cmath> functions usable in constant expressions, meant for building constants and
+ * lookup tables at compile time. They are evaluated in double precision, so the tables stored as float are
+ * correctly rounded, but are slower than the standard functions and should not be used in runtime code.
+ */
+namespace re::math {
+
+    constexpr double PI = Math_PI;
+
+    constexpr double TWO_PI = Math_PI * 2.0;
+
+    constexpr double HALF_PI = Math_PI * 0.5;
+
+    constexpr double LN2 = 0.693147180559945309417232121458;
+
+    constexpr double abs(double x) {
+        return x < 0.0 ? -x : x;
+    }
+
+    /**
+     *
+     * @return Nearest integer, halfway cases away from zero
+     */
+    constexpr double round(double x) {
+        return static_cast<double>(static_cast<int64_t>(x < 0.0 ? x - 0.5 : x + 0.5));
+    }
+
+    /**
+     *
+     * @return Sine of x with an error below 1e-12, x is reduced to [-pi/2, pi/2] and then evaluated
+     * with its Taylor series up to x^17
+     */
+    constexpr double sin(double x) {
+        x -= TWO_PI * round(x / TWO_PI);
+
+        if (x > HALF_PI) x = PI - x;
+        else if (x < -HALF_PI) x = -PI - x;
+
+        const double x2 = x * x;
+        double term = x;
+        double result = x;
+
+        for (int i = 2; i <= 16; i += 2) {
+            term *= -x2 / static_cast<double>(i * (i + 1));
+            result += term;
+        }
+
+        return result;
+    }
+
+    constexpr double cos(double x) {
+        return sin(x + HALF_PI);
+    }
+
+    /**
+     *
+     * @return Square root by Newton iterations, NaN for negative values
+     */
+    constexpr double sqrt(double x) {
+        if (x < 0.0) return std::numeric_limits<double>::quiet_NaN();
+        if (x == 0.0 || x == std::numeric_limits<double>::infinity()) return x;
+
+        double result = x > 1.0 ? x : 1.0;
+        for (int i = 0; i < 1100; ++i) {
+            const double next = 0.5 * (result + x / result);
+            if (next >= result) break;
+            result = next;
+        }
+
+        return result;
+    }
+
+    /**
+     *
+     * @return e^x, x is reduced to k * ln2 + r with |r| <= ln2 / 2, so the series of e^r converges in a few terms
+     */
+    constexpr double exp(double x) {
+        if (x > 709.0) return std::numeric_limits<double>::infinity();
+        if (x < -745.0) return 0.0;
+
+        const auto k = static_cast<int>(round(x / LN2));
+        const double r = x - k * LN2;
+
+        double term = 1.0;
+        double result = 1.0;
+        for (int i = 1; i < 16; ++i) {
+            term *= r / i;
+            result += term;
+        }
+
+        const double scale = k < 0 ? 0.5 : 2.0;
+        for (int i = 0; i < (k < 0 ? -k : k); ++i) result *= scale;
+
+        return result;
+    }
+
+    /**
+     *
+     * @return Natural logarithm, x is reduced to m * 2^e with m in [1, 2) and log(m) = 2 * atanh((m - 1) / (m + 1))
+     */
+    constexpr double log(double x) {
+        if (x < 0.0) return std::numeric_limits<double>::quiet_NaN();
+        if (x == 0.0) return -std::numeric_limits<double>::infinity();
+
+        int e = 0;
+        while (x >= 2.0) { x *= 0.5; ++e; }
+        while (x < 1.0) { x *= 2.0; --e; }
+
+        const double z = (x - 1.0) / (x + 1.0);
+        const double z2 = z * z;
+        double term = z;
+        double result = 0.0;
+        for (int i = 1; i < 40; i += 2) {
+            result += term / i;
+            term *= z2;
+        }
+
+        return 2.0 * result + e * LN2;
+    }
+
+    /**
+     *
+     * @return x^y for x >= 0
+     */
+    constexpr double pow(double x, double y) {
+        if (y == 0.0) return 1.0;
+        if (x == 0.0) return 0.0;
+
+        return exp(y * log(x));
+    }
+
+} // namespace re::math
+
+
+#endif //RAVENENGINE_CONSTMATH_HPP
@@ -0,0 +1,190 @@
+#include "FastMath.hpp"
+
+#include <bit>
+
+#include "Math.hpp"
+#include "Lanes.hpp"
+
+
+namespace re::math {
+
+    namespace {
+
+        using namespace lanes;
+
+        // pi / 2 in three parts, the first ones have few bits so q * part is exact (Cody-Waite reduction)
+        constexpr float HALF_PI_1 = 1.5703125f;
+        constexpr float HALF_PI_2 = 4.837512969970703125e-4f;
+        constexpr float HALF_PI_3 = 7.54978995489188216e-8f;
+        constexpr float TWO_OVER_PI = 0.636619772367581343f;
+
+        // Minimax polynomials of sin and cos on [-pi/4, pi/4], from Cephes sinf and cosf
+        constexpr float SIN_1 = -1.6666654611e-1f;
+        constexpr float SIN_2 = 8.3321608736e-3f;
+        constexpr float SIN_3 = -1.9515295891e-4f;
+        constexpr float COS_1 = 4.166664568298827e-2f;
+        constexpr float COS_2 = -1.388731625493765e-3f;
+        constexpr float COS_3 = 2.443315711809948e-5f;
+
+        constexpr float ROUND_MAGIC = 12582912.0f;
+
+        // Angles closer than this interpolate linearly, 1 / sin(theta) grows too fast
+        constexpr float SLERP_THRESHOLD = 1.0f - 1e-4f;
+
+        // Chunk of Euler angles whose sines and cosines are computed together by eulerToQuaternions
+        constexpr uint32_t EULER_CHUNK = 64;
+
+        /**
+         * @brief Sine and cosine of x, reduced to r in [-pi/4, pi/4] with x = q * pi/2 + r. The quadrant q swaps
+         * the polynomials and flips their signs.
+         */
+        inline void sincosLanes(Lane x, Lane& s, Lane& c) {
+            Int q = toInt(mul(x, set(TWO_OVER_PI)));
+            Lane qf = toFloat(q);
+            Lane r = madd(qf, set(-HALF_PI_1), x);
+            r = madd(qf, set(-HALF_PI_2), r);
+            r = madd(qf, set(-HALF_PI_3), r);
+
+            Lane z = mul(r, r);
+            Lane sinR = madd(mul(madd(madd(set(SIN_3), z, set(SIN_2)), z, set(SIN_1)), z), r, r);
+            Lane cosR = madd(mul(madd(madd(set(COS_3), z, set(COS_2)), z, set(COS_1)), z), z, madd(set(-0.5f), z, set(1.0f)));
+
+            Mask swap = bitSet(q, 1);
+            s = negate(bitSet(q, 2), blend(swap, cosR, sinR));
+            c = negate(bitSet(add(q, 1), 2), blend(swap, sinR, cosR));
+        }
+
+        /**
+         *
+         * @return acos(x) for x in [0, 1]. Abramowitz and Stegun 4.4.46, whose 2e-8 error bound holds in exact
+         * arithmetic, evaluated in float the rounding of the polynomial and the sqrt dominates.
+         */
+        inline float acosPositive(float x) {
+            float p = -0.0012624911f;
+            p = p * x + 0.0066700901f;
+            p = p * x - 0.0170881256f;
+            p = p * x + 0.0308918810f;
+            p = p * x - 0.0501743046f;
+            p = p * x + 0.0889789874f;
+            p = p * x - 0.2145988016f;
+            p = p * x + 1.5707963050f;
+            return Math::sqrt(1.0f - x) * p;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Sine and cosine together, minimax polynomials after reducing x to [-pi/4, pi/4]
+     * @param x Angle in radians, with |x| <= SINCOS_RANGE the error stays below SINCOS_MAX_ERROR
+     */
+    void sincos(float x, float& s, float& c) {
+        // Branchless, the quadrants of random angles would mispredict. Adding 1.5 * 2^23 rounds to an integer.
+        const float qf = (x * TWO_OVER_PI + ROUND_MAGIC) - ROUND_MAGIC;
+        const auto q = static_cast<uint32_t>(static_cast<int32_t>(qf));
+        float r = x - qf * HALF_PI_1;
+        r -= qf * HALF_PI_2;
+        r -= qf * HALF_PI_3;
+
+        const float z = r * r;
+        const auto sinR = std::bit_cast<uint32_t>(((SIN_3 * z + SIN_2) * z + SIN_1) * z * r + r);
+        const auto cosR = std::bit_cast<uint32_t>(((COS_3 * z + COS_2) * z + COS_1) * z * z - 0.5f * z + 1.0f);
+
+        const uint32_t swap = 0u - (q & 1u);
+        s = std::bit_cast<float>(((cosR & swap) | (sinR & ~swap)) ^ ((q & 2u) << 30));
+        c = std::bit_cast<float>(((sinR & swap) | (cosR & ~swap)) ^ (((q + 1u) & 2u) << 30));
+    }
+
+    /**
+     * @brief Vectorized sincos of count angles
+     * @param s Room for count values, can alias x
+     * @param c Room for count values, can alias x
+     */
+    void sincos(const float* x, uint32_t count, float* s, float* c) {
+        forEachGroup(count, [&](uint32_t first, uint32_t n) {
+            Lane sinX, cosX;
+            sincosLanes(load(x + first, n), sinX, cosX);
+            store(s + first, sinX, n);
+            store(c + first, cosX, n);
+        });
+    }
+
+    /**
+     * @brief Normalized linear interpolation along the shortest arc. Same path as slerp but without constant
+     * angular speed, the difference stays below NLERP_MAX_ERROR.
+     * @param from Unit quaternion at t = 0
+     * @param to Unit quaternion at t = 1
+     * @param t Interpolation factor in [0, 1]
+     */
+    Quaternion nlerp(const Quaternion& from, const Quaternion& to, float t) {
+        const Quaternion q = from * (1.0f - t) + to * std::copysign(t, from.dot(to));
+        return q * (1.0f / Math::sqrt(q.lengthSqrt()));
+    }
+
+    /**
+     * @brief Slerp with a polynomial acos and a single sincos. With sin((1 - t) * theta) expanded, the weights
+     * only need sin(t * theta) and cos(t * theta), and sin(theta) comes from cos(theta). Error below SLERP_MAX_ERROR.
+     * @param from Unit quaternion at t = 0
+     * @param to Unit quaternion at t = 1
+     * @param t Interpolation factor in [0, 1]
+     */
+    Quaternion fastSlerp(const Quaternion& from, const Quaternion& to, float t) {
+        const float dot = from.dot(to);
+        const float sign = std::copysign(1.0f, dot);
+        const float cosTheta = dot * sign;
+
+        if (cosTheta > SLERP_THRESHOLD)
+            return nlerp(from, to, t);
+
+        const float theta = acosPositive(cosTheta);
+        const float invSinTheta = 1.0f / Math::sqrt(1.0f - cosTheta * cosTheta);
+
+        float sinT, cosT;
+        sincos(t * theta, sinT, cosT);
+
+        const float endWeight = sinT * invSinTheta;
+        return from * (cosT - cosTheta * endWeight) + to * (sign * endWeight);
+    }
+
+    /**
+     * @brief Batch Quaternion(angles), Y - Z - X like Quaternion::eulerAngles2QuatYZX. The sines and cosines of
+     * the half angles of a chunk are computed with the vectorized sincos.
+     * @param out Room for count quaternions
+     */
+    void eulerToQuaternions(const Vector3* angles, uint32_t count, Quaternion* out) {
+        alignas(32) float halfAngles[EULER_CHUNK * 3];
+        alignas(32) float sines[EULER_CHUNK * 3];
+        alignas(32) float cosines[EULER_CHUNK * 3];
+
+        for (uint32_t chunk = 0; chunk < count; chunk += EULER_CHUNK) {
+            const uint32_t size = std::min(EULER_CHUNK, count - chunk);
+
+            // Each Vector3 is its own array, the components are copied to one array for the vectorized sincos
+            for (uint32_t i = 0; i < size; ++i) {
+                const Vector3& angle = angles[chunk + i];
+                halfAngles[i * 3] = angle.x * 0.5f;
+                halfAngles[i * 3 + 1] = angle.y * 0.5f;
+                halfAngles[i * 3 + 2] = angle.z * 0.5f;
+            }
+
+            forEachGroup(size * 3, [&](uint32_t first, uint32_t n) {
+                Lane sinX, cosX;
+                sincosLanes(load(halfAngles + first, n), sinX, cosX);
+                store(sines + first, sinX, n);
+                store(cosines + first, cosX, n);
+            });
+
+            for (uint32_t i = 0; i < size; ++i) {
+                const float s1 = sines[i * 3], s2 = sines[i * 3 + 1], s3 = sines[i * 3 + 2];
+                const float c1 = cosines[i * 3], c2 = cosines[i * 3 + 1], c3 = cosines[i * 3 + 2];
+
+                out[chunk + i] = {
+                    c1 * c2 * c3 + s1 * s2 * s3,
+                    c1 * c2 * s3 - s1 * s2 * c3,
+                    s1 * c2 * c3 - c1 * s2 * s3,
+                    c1 * s2 * c3 + s1 * c2 * s3
+                };
+            }
+        }
+    }
+
+} // namespace re::math
@@ -0,0 +1,47 @@
+#ifndef RAVENENGINE_FASTMATH_HPP
+#define RAVENENGINE_FASTMATH_HPP
+
+
+#include <cstdint>
+
+#include "Vector3.hpp"
+#include "Quaternion.hpp"
+
+
+/**
+ * Approximations for code that converts or interpolates thousands of rotations per frame, like animation and
+ * cameras. The errors below are absolute bounds, a margin over the worst case of sweeps of 10^8 random and
+ * adversarial inputs in the scalar, SSE4.1 and AVX2 builds. The math benchmark checks a million of those inputs
+ * against them.
+ */
+namespace re::math {
+
+    // Inputs are reduced to [-pi/4, pi/4] in float, past this range the reduction loses the max error below
+    constexpr float SINCOS_RANGE = 8192.0f;
+
+    // sincos against double precision sin and cos for |x| <= SINCOS_RANGE
+    constexpr float SINCOS_MAX_ERROR = 1.5e-7f;
+
+    // Components of fastSlerp against a double precision slerp of unit quaternions, 8e-7 found near the threshold
+    // where it switches to nlerp
+    constexpr float SLERP_MAX_ERROR = 1e-6f;
+
+    // Components of nlerp against a double precision slerp of unit quaternions. nlerp follows the same arc but not
+    // at constant speed, at 90 degrees between the quaternions (180 degrees of rotation) it trails slerp by up to
+    // 2 * sin(0.0355) = 0.071 at t = 0.24, float rounding adds a little more
+    constexpr float NLERP_MAX_ERROR = 7.5e-2f;
+
+    void sincos(float x, float& s, float& c);
+
+    void sincos(const float* x, uint32_t count, float* s, float* c);
+
+    Quaternion nlerp(const Quaternion& from, const Quaternion& to, float t);
+
+    Quaternion fastSlerp(const Quaternion& from, const Quaternion& to, float t);
+
+    void eulerToQuaternions(const Vector3* angles, uint32_t count, Quaternion* out);
+
+} // namespace re::math
+
+
+#endif //RAVENENGINE_FASTMATH_HPP
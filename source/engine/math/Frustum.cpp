@@ -0,0 +1,103 @@
+#include "Frustum.hpp"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define RE_FRUSTUM_SSE
+#endif
+
+
+namespace re {
+
+    /**
+     * @brief Extract frustum planes from a view projection matrix (Gribb-Hartmann). Projection maps depth to [0, 1].
+     * @param viewProj Camera projection * view
+     */
+    Frustum::Frustum(const Matrix4 &viewProj) {
+        // Matrix4 stores columns, so row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&viewProj](int i) {
+            return Vector4{viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]};
+        };
+
+        Vector4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        planes[LEFT] = r3 + r0;
+        planes[RIGHT] = r3 - r0;
+        planes[BOTTOM] = r3 + r1;
+        planes[TOP] = r3 - r1;
+        planes[ZNEAR] = r2;
+        planes[ZFAR] = r3 - r2;
+
+        for (int i = 0; i < PLANE_COUNT; ++i) {
+            Vector4& plane = planes[i];
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) plane = plane / length;
+
+            normalX[i] = plane.x;
+            normalY[i] = plane.y;
+            normalZ[i] = plane.z;
+            distance[i] = plane.w;
+        }
+    }
+
+    /**
+     * @brief Conservative box test. It can report intersection for boxes near frustum corners.
+     * @param box World space box
+     * @return False if the box is fully outside of any plane
+     */
+    bool Frustum::intersects(const AABB &box) const {
+        if (box.empty()) return false;
+
+        Vector3 c = box.center();
+        Vector3 e = box.extents();
+
+#ifdef RE_FRUSTUM_SSE
+        const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+        const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        for (int i = 0; i < 8; i += 4) {
+            __m128 nx = _mm_load_ps(normalX + i);
+            __m128 ny = _mm_load_ps(normalY + i);
+            __m128 nz = _mm_load_ps(normalZ + i);
+
+            // Signed distance of the center and projected radius of the box on each plane normal
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                     _mm_add_ps(_mm_mul_ps(nz, cz), _mm_load_ps(distance + i)));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, nx), ex),
+                                                  _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey)),
+                                       _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+
+            if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps())) != 0)
+                return false;
+        }
+
+        return true;
+#else
+        for (int i = 0; i < PLANE_COUNT; ++i) {
+            float dist = normalX[i] * c.x + normalY[i] * c.y + normalZ[i] * c.z + distance[i];
+            float radius = std::fabs(normalX[i]) * e.x + std::fabs(normalY[i]) * e.y + std::fabs(normalZ[i]) * e.z;
+
+            if (dist + radius < 0.0f) return false;
+        }
+
+        return true;
+#endif
+    }
+
+    /**
+     *
+     * @param sphere World space sphere
+     * @return False if the sphere is fully outside of any plane
+     */
+    bool Frustum::intersects(const Sphere &sphere) const {
+        for (int i = 0; i < PLANE_COUNT; ++i) {
+            float dist = normalX[i] * sphere.center.x + normalY[i] * sphere.center.y + normalZ[i] * sphere.center.z + distance[i];
+            if (dist < -sphere.radius) return false;
+        }
+
+        return true;
+    }
+
+} // namespace re
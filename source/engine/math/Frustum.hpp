@@ -0,0 +1,50 @@
+#ifndef RAVENENGINE_FRUSTUM_HPP
+#define RAVENENGINE_FRUSTUM_HPP
+
+
+#include "Vector4.hpp"
+#include "Matrix4.hpp"
+#include "Bounds.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief View frustum planes, with normals pointing inside. Planes are also kept as structure of arrays so
+     * a box is tested against four planes at once.
+     */
+    class Frustum {
+    public:
+        enum Plane {
+            LEFT = 0,
+            RIGHT,
+            BOTTOM,
+            TOP,
+            ZNEAR,
+            ZFAR,
+            PLANE_COUNT
+        };
+
+    public:
+        Frustum() = default;
+
+        explicit Frustum(const Matrix4& viewProj);
+
+        [[nodiscard]] bool intersects(const AABB& box) const;
+
+        [[nodiscard]] bool intersects(const Sphere& sphere) const;
+
+        Vector4 planes[PLANE_COUNT];
+
+    private:
+        // Two extra planes always pass (normal 0, distance 1), so the planes fit two groups of four
+        alignas(16) float normalX[8]{};
+        alignas(16) float normalY[8]{};
+        alignas(16) float normalZ[8]{};
+        alignas(16) float distance[8]{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_FRUSTUM_HPP
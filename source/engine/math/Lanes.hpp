@@ -0,0 +1,181 @@
+#ifndef RAVENENGINE_LANES_HPP
+#define RAVENENGINE_LANES_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Batch.hpp"
+
+
+/**
+ * One lane per value of a batch, BATCH_WIDTH wide. Kernels written with these functions compile to AVX2, SSE4.1
+ * or plain float code. Only the batch kernels include this header.
+ */
+namespace re::math::lanes {
+
+#if defined(RE_SIMD_FMA)
+    using Lane = __m256;
+    using Mask = __m256;
+    using Int = __m256i;
+
+    inline Lane set(float v) { return _mm256_set1_ps(v); }
+    inline Lane loadu(const float* p) { return _mm256_loadu_ps(p); }
+    inline void storeu(float* p, Lane v) { _mm256_storeu_ps(p, v); }
+    inline Lane add(Lane a, Lane b) { return _mm256_add_ps(a, b); }
+    inline Lane sub(Lane a, Lane b) { return _mm256_sub_ps(a, b); }
+    inline Lane mul(Lane a, Lane b) { return _mm256_mul_ps(a, b); }
+    inline Lane div(Lane a, Lane b) { return _mm256_div_ps(a, b); }
+    inline Lane madd(Lane a, Lane b, Lane c) { return _mm256_fmadd_ps(a, b, c); }
+    inline Lane abs(Lane a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    inline Mask greater(Lane a, Lane b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    inline Mask greaterEqual(Lane a, Lane b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    inline Mask maskAnd(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    inline Lane select(Mask m, Lane a) { return _mm256_and_ps(m, a); }
+    inline uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+    inline Lane blend(Mask m, Lane a, Lane b) { return _mm256_blendv_ps(b, a, m); }
+    inline Lane negate(Mask m, Lane a) { return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f))); }
+    inline Int toInt(Lane a) { return _mm256_cvtps_epi32(a); }
+    inline Lane toFloat(Int a) { return _mm256_cvtepi32_ps(a); }
+    inline Int add(Int a, int32_t b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+    inline Mask bitSet(Int a, int32_t bit) {
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, _mm256_set1_epi32(bit)), _mm256_set1_epi32(bit)));
+    }
+
+    /**
+     * @brief Write column j of eight consecutive matrices, lane i goes to out[i]
+     */
+    inline void storeColumn(Matrix4* out, int j, Lane x, Lane y, Lane z, Lane w) {
+        __m128 x0 = _mm256_castps256_ps128(x), y0 = _mm256_castps256_ps128(y);
+        __m128 z0 = _mm256_castps256_ps128(z), w0 = _mm256_castps256_ps128(w);
+        __m128 x1 = _mm256_extractf128_ps(x, 1), y1 = _mm256_extractf128_ps(y, 1);
+        __m128 z1 = _mm256_extractf128_ps(z, 1), w1 = _mm256_extractf128_ps(w, 1);
+
+        _MM_TRANSPOSE4_PS(x0, y0, z0, w0);
+        _MM_TRANSPOSE4_PS(x1, y1, z1, w1);
+
+        _mm_store_ps(out[0][j].values, x0);
+        _mm_store_ps(out[1][j].values, y0);
+        _mm_store_ps(out[2][j].values, z0);
+        _mm_store_ps(out[3][j].values, w0);
+        _mm_store_ps(out[4][j].values, x1);
+        _mm_store_ps(out[5][j].values, y1);
+        _mm_store_ps(out[6][j].values, z1);
+        _mm_store_ps(out[7][j].values, w1);
+    }
+#elif defined(RE_SIMD_SSE4)
+    using Lane = __m128;
+    using Mask = __m128;
+    using Int = __m128i;
+
+    inline Lane set(float v) { return _mm_set1_ps(v); }
+    inline Lane loadu(const float* p) { return _mm_loadu_ps(p); }
+    inline void storeu(float* p, Lane v) { _mm_storeu_ps(p, v); }
+    inline Lane add(Lane a, Lane b) { return _mm_add_ps(a, b); }
+    inline Lane sub(Lane a, Lane b) { return _mm_sub_ps(a, b); }
+    inline Lane mul(Lane a, Lane b) { return _mm_mul_ps(a, b); }
+    inline Lane div(Lane a, Lane b) { return _mm_div_ps(a, b); }
+    inline Lane madd(Lane a, Lane b, Lane c) { return simd::madd(a, b, c); }
+    inline Lane abs(Lane a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline Mask greater(Lane a, Lane b) { return _mm_cmpgt_ps(a, b); }
+    inline Mask greaterEqual(Lane a, Lane b) { return _mm_cmpge_ps(a, b); }
+    inline Mask maskAnd(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    inline Lane select(Mask m, Lane a) { return _mm_and_ps(m, a); }
+    inline uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+    inline Lane blend(Mask m, Lane a, Lane b) { return _mm_blendv_ps(b, a, m); }
+    inline Lane negate(Mask m, Lane a) { return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f))); }
+    inline Int toInt(Lane a) { return _mm_cvtps_epi32(a); }
+    inline Lane toFloat(Int a) { return _mm_cvtepi32_ps(a); }
+    inline Int add(Int a, int32_t b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+    inline Mask bitSet(Int a, int32_t bit) {
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, _mm_set1_epi32(bit)), _mm_set1_epi32(bit)));
+    }
+
+    /**
+     * @brief Write column j of four consecutive matrices, lane i goes to out[i]
+     */
+    inline void storeColumn(Matrix4* out, int j, Lane x, Lane y, Lane z, Lane w) {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        _mm_store_ps(out[0][j].values, x);
+        _mm_store_ps(out[1][j].values, y);
+        _mm_store_ps(out[2][j].values, z);
+        _mm_store_ps(out[3][j].values, w);
+    }
+#else
+    using Lane = float;
+    using Mask = bool;
+    using Int = int32_t;
+
+    inline Lane set(float v) { return v; }
+    inline Lane loadu(const float* p) { return *p; }
+    inline void storeu(float* p, Lane v) { *p = v; }
+    inline Lane add(Lane a, Lane b) { return a + b; }
+    inline Lane sub(Lane a, Lane b) { return a - b; }
+    inline Lane mul(Lane a, Lane b) { return a * b; }
+    inline Lane div(Lane a, Lane b) { return a / b; }
+    inline Lane madd(Lane a, Lane b, Lane c) { return a * b + c; }
+    inline Lane abs(Lane a) { return std::fabs(a); }
+    inline Mask greater(Lane a, Lane b) { return a > b; }
+    inline Mask greaterEqual(Lane a, Lane b) { return a >= b; }
+    inline Mask maskAnd(Mask a, Mask b) { return a && b; }
+    inline Lane select(Mask m, Lane a) { return m ? a : 0.0f; }
+    inline uint32_t bits(Mask m) { return m ? 1 : 0; }
+    inline Lane blend(Mask m, Lane a, Lane b) { return m ? a : b; }
+    inline Lane negate(Mask m, Lane a) { return m ? -a : a; }
+    inline Int toInt(Lane a) { return static_cast<Int>((a + 12582912.0f) - 12582912.0f); }
+    inline Lane toFloat(Int a) { return static_cast<Lane>(a); }
+    inline Int add(Int a, int32_t b) { return a + b; }
+    inline Mask bitSet(Int a, int32_t bit) { return (a & bit) != 0; }
+
+    inline void storeColumn(Matrix4* out, int j, Lane x, Lane y, Lane z, Lane w) {
+        out[0][j] = {x, y, z, w};
+    }
+#endif
+
+    /**
+     * @brief Load n values, the lanes past n of the last group of a batch are zero
+     */
+    inline Lane load(const float* p, uint32_t n) {
+        if constexpr (BATCH_WIDTH > 1) {
+            if (n < BATCH_WIDTH) {
+                alignas(32) float values[BATCH_WIDTH]{};
+                std::copy_n(p, n, values);
+                return loadu(values);
+            }
+        }
+
+        return loadu(p);
+    }
+
+    inline void store(float* p, Lane v, uint32_t n) {
+        if constexpr (BATCH_WIDTH > 1) {
+            if (n < BATCH_WIDTH) {
+                alignas(32) float values[BATCH_WIDTH];
+                storeu(values, v);
+                std::copy_n(values, n, p);
+                return;
+            }
+        }
+
+        storeu(p, v);
+    }
+
+    /**
+     * @brief Call group(first, n) for each group of BATCH_WIDTH values. Only the last call can have less
+     * values, so the loads and stores of the full groups don't check n.
+     */
+    template<typename Group>
+    inline void forEachGroup(uint32_t count, Group&& group) {
+        uint32_t first = 0;
+        for (; first + BATCH_WIDTH <= count; first += BATCH_WIDTH)
+            group(first, BATCH_WIDTH);
+
+        if (first < count) group(first, count - first);
+    }
+
+} // namespace re::math::lanes
+
+
+#endif //RAVENENGINE_LANES_HPP
@@ -16,9 +16,14 @@ namespace re {
 
     class Math {
     public:
-        static inline float pi() { return Math_PI; }
+        // Math_PI is a double literal, the float constants keep float code from promoting to double
+        static constexpr float PI = static_cast<float>(Math_PI);
 
-        static inline float twoPi() { return Math_PI * 2; }
+        static constexpr float TWO_PI = static_cast<float>(Math_PI * 2.0);
+
+        static constexpr float pi() { return PI; }
+
+        static constexpr float twoPi() { return TWO_PI; }
 
         static inline float sin(float x) { return ::sinf(x); }
         static inline Vector3 sin(const Vector3& v) { return { sin(v.x), sin(v.y), sin(v.z)}; }
@@ -52,14 +57,14 @@ namespace re {
 
         static inline float exp(float x) { return ::expf(x); }
 
-        static inline int abs(int x) { return x > 0 ? x : -x; }
-        static inline float abs(float x) { return ::abs(x); }
+        static constexpr int abs(int x) { return x > 0 ? x : -x; }
+        static constexpr float abs(float x) { return x < 0.0f ? -x : x; }
 
-        static inline float deg2rad(float x) { return x * (Math_PI / 180.0); }
-        static inline Vector3 deg2rad(const Vector3& v) { return {deg2rad(v.x), deg2rad(v.y), deg2rad(v.z)}; }
+        static constexpr float deg2rad(float x) { return x * (PI / 180.0f); }
+        static constexpr Vector3 deg2rad(const Vector3& v) { return {deg2rad(v.x), deg2rad(v.y), deg2rad(v.z)}; }
 
-        static inline float rad2deg(float x) { return x * (180.0 / Math_PI); }
-        static inline Vector3 rad2deg(const Vector3& v) { return {rad2deg(v.x), rad2deg(v.y), rad2deg(v.z)}; }
+        static constexpr float rad2deg(float x) { return x * (180.0f / PI); }
+        static constexpr Vector3 rad2deg(const Vector3& v) { return {rad2deg(v.x), rad2deg(v.y), rad2deg(v.z)}; }
     };
 
 } // namespace re
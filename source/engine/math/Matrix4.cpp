@@ -8,7 +8,13 @@ namespace re {
     }
 
     Matrix4 Matrix4::inverted() const {
+#ifdef RE_SIMD_SSE4
+        Matrix4 result;
+        simd::inverse(elements[0].values, result.elements[0].values);
+        return result;
+#else
         return adjugate() / determinant();
+#endif
     }
 
     Matrix4 Matrix4::adjugate() const {
@@ -69,30 +75,135 @@ namespace re {
         };
     }
 
-    std::string Matrix4::str() const {
-        return "[" + std::to_string(elements[0][0]) + " " + std::to_string(elements[0][1]) + " " + std::to_string(elements[0][2]) + " " + std::to_string(elements[0][3]) + "]"
-            + "[" + std::to_string(elements[1][0]) + " " + std::to_string(elements[1][1]) + " " + std::to_string(elements[1][2]) + " " + std::to_string(elements[1][3]) + "]"
-            + "[" + std::to_string(elements[2][0]) + " " + std::to_string(elements[2][1]) + " " + std::to_string(elements[2][2]) + " " + std::to_string(elements[2][3]) + "]"
-            + "[" + std::to_string(elements[3][0]) + " " + std::to_string(elements[3][1]) + " " + std::to_string(elements[3][2]) + " " + std::to_string(elements[3][3]) + "]";
+    /**
+     * @brief Inverse of a matrix whose last row is (0, 0, 0, 1), like the Transform and node matrices. Only the
+     * 3x3 part is inverted, with its cofactors, and the translation is moved to that space.
+     * @return Inverse, not finite if the 3x3 part has no inverse
+     */
+    Matrix4 Matrix4::affineInverted() const {
+#ifdef RE_SIMD_SSE4
+        Matrix4 result;
+        simd::affineInverse(elements[0].values, result.elements[0].values);
+        return result;
+#else
+        const Vector3 c0(elements[0].x, elements[0].y, elements[0].z);
+        const Vector3 c1(elements[1].x, elements[1].y, elements[1].z);
+        const Vector3 c2(elements[2].x, elements[2].y, elements[2].z);
+
+        // Rows of the inverse
+        const float invDet = 1.0f / c0.dot(c1.cross(c2));
+        const Vector3 r0 = c1.cross(c2) * invDet;
+        const Vector3 r1 = c2.cross(c0) * invDet;
+        const Vector3 r2 = c0.cross(c1) * invDet;
+        const Vector3 t(elements[3].x, elements[3].y, elements[3].z);
+
+        return {
+            {r0.x, r1.x, r2.x, 0.0f},
+            {r0.y, r1.y, r2.y, 0.0f},
+            {r0.z, r1.z, r2.z, 0.0f},
+            {-r0.dot(t), -r1.dot(t), -r2.dot(t), 1.0f}
+        };
+#endif
     }
 
-    Matrix4 Matrix4::operator*(const Matrix4 &m) const {
-        const vec4 srcA0 = elements[0];
-        const vec4 srcA1 = elements[1];
-        const vec4 srcA2 = elements[2];
-        const vec4 srcA3 = elements[3];
+    /**
+     *
+     * @return Inverse transpose of the 3x3 part, to transform normals. Translation is 0.
+     */
+    Matrix4 Matrix4::normalMatrix() const {
+#ifdef RE_SIMD_SSE4
+        Matrix4 result;
+        simd::normalMatrix(elements[0].values, result.elements[0].values);
+        return result;
+#else
+        const Vector3 c0(elements[0].x, elements[0].y, elements[0].z);
+        const Vector3 c1(elements[1].x, elements[1].y, elements[1].z);
+        const Vector3 c2(elements[2].x, elements[2].y, elements[2].z);
+
+        // The rows of the inverse are the columns of its transpose
+        const float invDet = 1.0f / c0.dot(c1.cross(c2));
+        const Vector3 r0 = c1.cross(c2) * invDet;
+        const Vector3 r1 = c2.cross(c0) * invDet;
+        const Vector3 r2 = c0.cross(c1) * invDet;
+
+        return {
+            {r0.x, r0.y, r0.z, 0.0f},
+            {r1.x, r1.y, r1.z, 0.0f},
+            {r2.x, r2.y, r2.z, 0.0f},
+            {0.0f, 0.0f, 0.0f, 1.0f}
+        };
+#endif
+    }
 
-        const vec4 srcB0 = m[0];
-        const vec4 srcB1 = m[1];
-        const vec4 srcB2 = m[2];
-        const vec4 srcB3 = m[3];
+    /**
+     * @brief Build the matrix from position, rotation and scale without an intermediate Basis. It's the same
+     * matrix as Basis(rotation, scale) with the position as translation: the rows of the rotation are scaled.
+     * @param position Translation
+     * @param rotation Rotation, it doesn't need to be unit
+     * @param scale Scale of each row of the rotation
+     */
+    Matrix4 Matrix4::compose(const Vector3 &position, const Quaternion &rotation, const Vector3 &scale) {
+#ifdef RE_SIMD_SSE4
+        Matrix4 result;
+        simd::compose(_mm_setr_ps(position.x, position.y, position.z, 1.0f), _mm_load_ps(rotation.values),
+                      _mm_setr_ps(scale.x, scale.y, scale.z, 0.0f), result.elements[0].values);
+        return result;
+#else
+        const Quaternion& q = rotation;
+        float d = 2.0f / q.lengthSqrt();
+        float xs = q.x * d, ys = q.y * d, zs = q.z * d;
+        float wx = q.w * xs, wy = q.w * ys, wz = q.w * zs;
+        float xx = q.x * xs, xy = q.x * ys, xz = q.x * zs;
+        float yy = q.y * ys, yz = q.y * zs, zz = q.z * zs;
 
         return {
-                {srcA0 * srcB0[0] + srcA1 * srcB0[1] + srcA2 * srcB0[2] + srcA3 * srcB0[3]},
-                {srcA0 * srcB1[0] + srcA1 * srcB1[1] + srcA2 * srcB1[2] + srcA3 * srcB1[3]},
-                {srcA0 * srcB2[0] + srcA1 * srcB2[1] + srcA2 * srcB2[2] + srcA3 * srcB2[3]},
-                {srcA0 * srcB3[0] + srcA1 * srcB3[1] + srcA2 * srcB3[2] + srcA3 * srcB3[3]}
+            {(1.0f - (yy + zz)) * scale.x, (xy + wz) * scale.y, (xz - wy) * scale.z, 0.0f},
+            {(xy - wz) * scale.x, (1.0f - (xx + zz)) * scale.y, (yz + wx) * scale.z, 0.0f},
+            {(xz + wy) * scale.x, (yz - wx) * scale.y, (1.0f - (xx + yy)) * scale.z, 0.0f},
+            {position.x, position.y, position.z, 1.0f}
         };
+#endif
+    }
+
+    /**
+     * @brief Inverse of compose: the rotation is transposed, the scale inverted and the translation moved to
+     * that space, so no determinant is calculated
+     * @param scale Scale of each row of the rotation, no component can be 0
+     */
+    Matrix4 Matrix4::composeInverse(const Vector3 &position, const Quaternion &rotation, const Vector3 &scale) {
+#ifdef RE_SIMD_SSE4
+        Matrix4 result;
+        simd::composeInverse(_mm_setr_ps(position.x, position.y, position.z, 1.0f), _mm_load_ps(rotation.values),
+                             _mm_setr_ps(scale.x, scale.y, scale.z, 1.0f), result.elements[0].values);
+        return result;
+#else
+        const Quaternion& q = rotation;
+        float d = 2.0f / q.lengthSqrt();
+        float xs = q.x * d, ys = q.y * d, zs = q.z * d;
+        float wx = q.w * xs, wy = q.w * ys, wz = q.w * zs;
+        float xx = q.x * xs, xy = q.x * ys, xz = q.x * zs;
+        float yy = q.y * ys, yz = q.y * zs, zz = q.z * zs;
+
+        // Column j of the inverse is row j of the rotation divided by scale j
+        const Vector3 c0 = Vector3(1.0f - (yy + zz), xy - wz, xz + wy) / scale.x;
+        const Vector3 c1 = Vector3(xy + wz, 1.0f - (xx + zz), yz - wx) / scale.y;
+        const Vector3 c2 = Vector3(xz - wy, yz + wx, 1.0f - (xx + yy)) / scale.z;
+        const Vector3 t = -(c0 * position.x + c1 * position.y + c2 * position.z);
+
+        return {
+            {c0.x, c0.y, c0.z, 0.0f},
+            {c1.x, c1.y, c1.z, 0.0f},
+            {c2.x, c2.y, c2.z, 0.0f},
+            {t.x, t.y, t.z, 1.0f}
+        };
+#endif
+    }
+
+    std::string Matrix4::str() const {
+        return "[" + std::to_string(elements[0][0]) + " " + std::to_string(elements[0][1]) + " " + std::to_string(elements[0][2]) + " " + std::to_string(elements[0][3]) + "]"
+            + "[" + std::to_string(elements[1][0]) + " " + std::to_string(elements[1][1]) + " " + std::to_string(elements[1][2]) + " " + std::to_string(elements[1][3]) + "]"
+            + "[" + std::to_string(elements[2][0]) + " " + std::to_string(elements[2][1]) + " " + std::to_string(elements[2][2]) + " " + std::to_string(elements[2][3]) + "]"
+            + "[" + std::to_string(elements[3][0]) + " " + std::to_string(elements[3][1]) + " " + std::to_string(elements[3][2]) + " " + std::to_string(elements[3][3]) + "]";
     }
 
 } // namespace re
\ No newline at end of file
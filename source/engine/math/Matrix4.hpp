@@ -3,21 +3,24 @@
 
 
 #include <string>
+#include <type_traits>
 
+#include "Vector3.hpp"
 #include "Vector4.hpp"
+#include "Quaternion.hpp"
 
 
 namespace re {
 
     class Matrix4 {
     public:
-        inline Matrix4() = default;
+        constexpr Matrix4() = default;
 
-        inline explicit Matrix4(float n);
+        constexpr explicit Matrix4(float n);
 
-        inline Matrix4(const Vector4& x, const Vector4& y, const Vector4& z, const Vector4& w);
+        constexpr Matrix4(const Vector4& x, const Vector4& y, const Vector4& z, const Vector4& w);
 
-        inline Matrix4(const Matrix4& m) = default;
+        constexpr Matrix4(const Matrix4& m) = default;
 
         void invert();
 
@@ -25,55 +28,65 @@ namespace re {
 
         [[nodiscard]] Matrix4 adjugate() const;
 
-        inline void transpose();
+        [[nodiscard]] Matrix4 affineInverted() const;
 
-        inline Matrix4 transposed();
+        [[nodiscard]] Matrix4 normalMatrix() const;
 
-        [[nodiscard]] inline float determinant() const;
+        static Matrix4 compose(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
 
-        inline void setIdentity();
+        static Matrix4 composeInverse(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
 
-        inline void setZero();
+        constexpr void transpose();
 
-        inline void setDiagonal(const Vector4& dig);
+        [[nodiscard]] constexpr Matrix4 transposed() const;
+
+        [[nodiscard]] constexpr float determinant() const;
+
+        [[nodiscard]] constexpr Vector4 transformPoint(const Vector3& p) const;
+
+        constexpr void setIdentity();
+
+        constexpr void setZero();
+
+        constexpr void setDiagonal(const Vector4& dig);
 
         [[nodiscard]] std::string str() const;
 
-        inline Matrix4& operator=(const Matrix4&) = default;
+        constexpr Matrix4& operator=(const Matrix4&) = default;
 
-        inline Matrix4& operator=(Matrix4&&) = default;
+        constexpr Matrix4& operator=(Matrix4&&) = default;
 
-        inline Vector4& operator[](size_t row);
+        constexpr Vector4& operator[](size_t row);
 
-        inline const Vector4& operator[](size_t row) const;
+        constexpr const Vector4& operator[](size_t row) const;
 
-        inline Matrix4 operator-() const;
+        constexpr Matrix4 operator-() const;
 
-        inline void operator+=(const Matrix4& m);
+        constexpr void operator+=(const Matrix4& m);
 
-        inline void operator-=(const Matrix4& m);
+        constexpr void operator-=(const Matrix4& m);
 
-        inline void operator*=(float n);
+        constexpr void operator*=(float n);
 
-        inline void operator*=(const Matrix4& m);
+        constexpr void operator*=(const Matrix4& m);
 
-        inline void operator/=(float n);
+        constexpr void operator/=(float n);
 
-        inline Matrix4 operator+(const Matrix4& m) const;
+        constexpr Matrix4 operator+(const Matrix4& m) const;
 
-        inline Matrix4 operator-(const Matrix4& m) const;
+        constexpr Matrix4 operator-(const Matrix4& m) const;
 
-        inline Matrix4 operator*(float n) const;
+        constexpr Matrix4 operator*(float n) const;
 
-        inline Vector4 operator*(const Vector4& v) const;
+        constexpr Vector4 operator*(const Vector4& v) const;
 
-        Matrix4 operator*(const Matrix4& m) const;
+        constexpr Matrix4 operator*(const Matrix4& m) const;
 
-        inline Matrix4 operator/(float n) const;
+        constexpr Matrix4 operator/(float n) const;
 
-        inline bool operator==(const Matrix4& m) const;
+        constexpr bool operator==(const Matrix4& m) const;
 
-        inline bool operator!=(const Matrix4& m) const;
+        constexpr bool operator!=(const Matrix4& m) const;
 
         Vector4 elements[4] = {
                 {1.0f, 0.0f, 0.0f, 0.0f},
@@ -83,25 +96,32 @@ namespace re {
         };
     };
 
-    Matrix4::Matrix4(float n) {
+    constexpr Matrix4::Matrix4(float n) {
         elements[0] = {n, 0.0f, 0.0f, 0.0f};
         elements[1] = {0.0f, n, 0.0f, 0.0f};
         elements[2] = {0.0f, 0.0f, n, 0.0f};
         elements[3] = {0.0f, 0.0f, 0.0f, n};
     }
 
-    Matrix4::Matrix4(const Vector4 &x, const Vector4 &y, const Vector4 &z, const Vector4 &w) {
+    constexpr Matrix4::Matrix4(const Vector4 &x, const Vector4 &y, const Vector4 &z, const Vector4 &w) {
         elements[0] = x;
         elements[1] = y;
         elements[2] = z;
         elements[3] = w;
     }
 
-    void Matrix4::transpose() {
+    constexpr void Matrix4::transpose() {
         *this = transposed();
     }
 
-    Matrix4 Matrix4::transposed() {
+    constexpr Matrix4 Matrix4::transposed() const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Matrix4 result;
+            simd::transpose(elements[0].values, result.elements[0].values);
+            return result;
+        }
+#endif
         return {
             {elements[0][0], elements[1][0], elements[2][0], elements[3][0] },
             {elements[0][1], elements[1][1], elements[2][1], elements[3][1] },
@@ -110,94 +130,146 @@ namespace re {
         };
     }
 
-    float Matrix4::determinant() const {
+    constexpr float Matrix4::determinant() const {
         return elements[0][0] * (elements[1][1] * (elements[2][2] * elements[3][3] - elements[2][3] * elements[3][2]) + elements[1][2] * (elements[2][3] * elements[3][1] - elements[2][1] * elements[3][3]) + elements[1][3] * (elements[2][1] * elements[3][2] - elements[2][2] * elements[3][1])) +
                elements[0][1] * (elements[1][0] * (elements[2][3] * elements[3][2] - elements[2][2] * elements[3][3]) + elements[1][2] * (elements[2][0] * elements[3][3] - elements[2][3] * elements[3][0]) + elements[1][3] * (elements[2][2] * elements[3][0] - elements[2][0] * elements[3][2])) +
                elements[0][2] * (elements[1][0] * (elements[2][1] * elements[3][3] - elements[2][3] * elements[3][1]) + elements[1][1] * (elements[2][3] * elements[3][0] - elements[2][0] * elements[3][3]) + elements[1][3] * (elements[2][0] * elements[3][1] - elements[2][1] * elements[3][0])) +
                elements[0][3] * (elements[1][0] * (elements[2][2] * elements[3][1] - elements[2][1] * elements[3][2]) + elements[1][1] * (elements[2][0] * elements[3][2] - elements[2][2] * elements[3][0]) + elements[1][2] * (elements[2][1] * elements[3][0] - elements[2][0] * elements[3][1]));
     }
 
-    void Matrix4::setIdentity() {
+    /**
+     *
+     * @param p Point, w is taken as 1
+     * @return Sum of the columns scaled by the point plus the translation column, w is kept for projections
+     */
+    constexpr Vector4 Matrix4::transformPoint(const Vector3 &p) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, simd::transformPoint(elements[0].values, p.x, p.y, p.z));
+            return result;
+        }
+#endif
+        return elements[0] * p.x + elements[1] * p.y + elements[2] * p.z + elements[3];
+    }
+
+    constexpr void Matrix4::setIdentity() {
         elements[0] = {1.0f, 0.0f, 0.0f, 0.0f};
         elements[1] = {0.0f, 1.0f, 0.0f, 0.0f};
         elements[2] = {0.0f, 0.0f, 1.0f, 0.0f};
         elements[3] = {0.0f, 0.0f, 0.0f, 1.0f};
     }
 
-    void Matrix4::setZero() {
+    constexpr void Matrix4::setZero() {
         elements[0] = {0.0f, 0.0f, 0.0f, 0.0f};
         elements[1] = {0.0f, 0.0f, 0.0f, 0.0f};
         elements[2] = {0.0f, 0.0f, 0.0f, 0.0f};
         elements[3] = {0.0f, 0.0f, 0.0f, 0.0f};
     }
 
-    void Matrix4::setDiagonal(const Vector4 &dig) {
+    constexpr void Matrix4::setDiagonal(const Vector4 &dig) {
         elements[0] = {dig.x, 0.0f, 0.0f, 0.0f};
         elements[1] = {0.0f, dig.y, 0.0f, 0.0f};
         elements[2] = {0.0f, 0.0f, dig.z, 0.0f};
         elements[3] = {0.0f, 0.0f, 0.0f, dig.w};
     }
 
-    Vector4 &Matrix4::operator[](size_t row) {
+    constexpr Vector4 &Matrix4::operator[](size_t row) {
         return elements[row];
     }
 
-    const Vector4 &Matrix4::operator[](size_t row) const {
+    constexpr const Vector4 &Matrix4::operator[](size_t row) const {
         return elements[row];
     }
 
-    Matrix4 Matrix4::operator-() const {
+    constexpr Matrix4 Matrix4::operator-() const {
         return {-elements[0], -elements[1], -elements[2], -elements[3]};
     }
 
-    void Matrix4::operator+=(const Matrix4 &m) {
+    constexpr void Matrix4::operator+=(const Matrix4 &m) {
         *this = *this + m;
     }
 
-    void Matrix4::operator-=(const Matrix4 &m) {
+    constexpr void Matrix4::operator-=(const Matrix4 &m) {
         *this = *this - m;
     }
 
-    void Matrix4::operator*=(float n) {
+    constexpr void Matrix4::operator*=(float n) {
         *this = *this * n;
     }
 
-    void Matrix4::operator*=(const Matrix4 &m) {
+    constexpr void Matrix4::operator*=(const Matrix4 &m) {
         *this = *this * m;
     }
 
-    void Matrix4::operator/=(float n) {
+    constexpr void Matrix4::operator/=(float n) {
         *this = *this / n;
     }
 
-    Matrix4 Matrix4::operator+(const Matrix4 &m) const {
+    constexpr Matrix4 Matrix4::operator+(const Matrix4 &m) const {
         return {elements[0] + m[0], elements[1] + m[1], elements[2] + m[2], elements[3] + m[3]};
     }
 
-    Matrix4 Matrix4::operator-(const Matrix4 &m) const {
+    constexpr Matrix4 Matrix4::operator-(const Matrix4 &m) const {
         return {elements[0] - m[0], elements[1] - m[1], elements[2] - m[2], elements[3] - m[3]};
     }
 
-    Matrix4 Matrix4::operator*(float n) const {
+    constexpr Matrix4 Matrix4::operator*(float n) const {
         return {elements[0] * n, elements[1] * n, elements[2] * n, elements[3] * n};
     }
 
-    Vector4 Matrix4::operator*(const Vector4 &v) const {
+    constexpr Vector4 Matrix4::operator*(const Vector4 &v) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, simd::dot4(elements[0].values, _mm_load_ps(v.values)));
+            return result;
+        }
+#endif
         return {elements[0].dot(v), elements[1].dot(v), elements[2].dot(v), elements[3].dot(v)};
     }
 
-    Matrix4 Matrix4::operator/(float n) const {
+    constexpr Matrix4 Matrix4::operator*(const Matrix4 &m) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Matrix4 result;
+            simd::multiply(elements[0].values, m.elements[0].values, result.elements[0].values);
+            return result;
+        }
+#endif
+        const vec4 srcA0 = elements[0];
+        const vec4 srcA1 = elements[1];
+        const vec4 srcA2 = elements[2];
+        const vec4 srcA3 = elements[3];
+
+        const vec4 srcB0 = m[0];
+        const vec4 srcB1 = m[1];
+        const vec4 srcB2 = m[2];
+        const vec4 srcB3 = m[3];
+
+        return {
+                {srcA0 * srcB0[0] + srcA1 * srcB0[1] + srcA2 * srcB0[2] + srcA3 * srcB0[3]},
+                {srcA0 * srcB1[0] + srcA1 * srcB1[1] + srcA2 * srcB1[2] + srcA3 * srcB1[3]},
+                {srcA0 * srcB2[0] + srcA1 * srcB2[1] + srcA2 * srcB2[2] + srcA3 * srcB2[3]},
+                {srcA0 * srcB3[0] + srcA1 * srcB3[1] + srcA2 * srcB3[2] + srcA3 * srcB3[3]}
+        };
+    }
+
+    constexpr Matrix4 Matrix4::operator/(float n) const {
         return {elements[0] / n, elements[1] / n, elements[2] / n, elements[3] / n};
     }
 
-    bool Matrix4::operator==(const Matrix4 &m) const {
+    constexpr bool Matrix4::operator==(const Matrix4 &m) const {
         return elements[0] == m[0] && elements[1] == m[1] && elements[2] == m[2] && elements[3] == m[3];
     }
 
-    bool Matrix4::operator!=(const Matrix4 &m) const {
-        return elements[0] != m[0] && elements[1] != m[1] && elements[2] != m[2] && elements[3] != m[3];
+    constexpr bool Matrix4::operator!=(const Matrix4 &m) const {
+        return elements[0] != m[0] || elements[1] != m[1] || elements[2] != m[2] || elements[3] != m[3];
     }
 
+    // The SIMD kernels read the four columns as one contiguous array of 16 floats
+    static_assert(sizeof(Vector4) == 4 * sizeof(float) && alignof(Matrix4) == 16);
+
     using mat4 = Matrix4;
 
 
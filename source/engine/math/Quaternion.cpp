@@ -323,6 +323,31 @@ namespace re {
         return {phi, theta, psi};
     }
 
+    /**
+     * @brief Spherical linear interpolation along the shortest arc. Nearly parallel rotations fall back to a
+     * normalized linear interpolation.
+     * @param from Unit quaternion at t = 0
+     * @param to Unit quaternion at t = 1
+     * @param t Interpolation factor in [0, 1]
+     * @link https://www.wikiwand.com/en/Slerp
+     */
+    Quaternion Quaternion::slerp(const Quaternion &from, const Quaternion &to, float t) {
+        float cosTheta = from.dot(to);
+        Quaternion end = to;
+
+        if (cosTheta < 0.0f) {
+            cosTheta = -cosTheta;
+            end = -to;
+        }
+
+        if (cosTheta > 1.0f - 1e-4f)
+            return (from * (1.0f - t) + end * t).normalized();
+
+        const float theta = Math::acos(cosTheta);
+        const float sinTheta = Math::sin(theta);
+        return (from * Math::sin((1.0f - t) * theta) + end * Math::sin(t * theta)) / sinTheta;
+    }
+
     std::string Quaternion::str() const {
         return "(" + std::to_string(w) + ", " + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")";
     }
@@ -3,9 +3,11 @@
 
 
 #include <limits>
+#include <type_traits>
 #include <string>
 
 #include "Vector3.hpp"
+#include "Simd.hpp"
 
 
 namespace re {
@@ -14,11 +16,11 @@ namespace re {
      * This implementation has W component first\n
      * W - X - Y - Z
      */
-    class Quaternion {
+    class alignas(16) Quaternion {
     public:
-        inline Quaternion() = default;
+        constexpr Quaternion();
 
-        inline Quaternion(float w, float x, float y, float z);
+        constexpr Quaternion(float w, float x, float y, float z);
 
         inline explicit Quaternion(const Vector3& angles);
 
@@ -26,9 +28,9 @@ namespace re {
 
         explicit Quaternion(const double* v);
 
-        inline Quaternion(const Quaternion& q) = default;
+        constexpr Quaternion(const Quaternion& q) = default;
 
-        [[nodiscard]] inline float lengthSqrt() const;
+        [[nodiscard]] constexpr float lengthSqrt() const;
 
         [[nodiscard]] float length() const;
 
@@ -38,9 +40,9 @@ namespace re {
 
         [[nodiscard]] Quaternion normalized() const;
 
-        [[nodiscard]] inline float dot(const Quaternion& q) const;
+        [[nodiscard]] constexpr float dot(const Quaternion& q) const;
 
-        [[nodiscard]] inline Quaternion conjugate() const;
+        [[nodiscard]] constexpr Quaternion conjugate() const;
 
         void inverse();
 
@@ -72,41 +74,43 @@ namespace re {
 
         static Vector3 quat2EulerAnglesZXY(const Quaternion& quat);
 
+        static Quaternion slerp(const Quaternion& from, const Quaternion& to, float t);
+
         [[nodiscard]] std::string str() const;
 
-        inline Quaternion& operator=(const Quaternion&) = default;
+        constexpr Quaternion& operator=(const Quaternion&) = default;
 
-        inline Quaternion& operator=(Quaternion&&) = default;
+        constexpr Quaternion& operator=(Quaternion&&) = default;
 
-        inline float& operator[](size_t i);
+        constexpr float& operator[](size_t i);
 
-        inline const float& operator[](size_t i) const;
+        constexpr const float& operator[](size_t i) const;
 
-        inline Quaternion operator-() const;
+        constexpr Quaternion operator-() const;
 
-        inline void operator+=(const Quaternion& q);
+        constexpr void operator+=(const Quaternion& q);
 
-        inline void operator-=(const Quaternion& q);
+        constexpr void operator-=(const Quaternion& q);
 
-        inline void operator*=(float s);
+        constexpr void operator*=(float s);
 
-        inline void operator*=(const Quaternion& q);
+        constexpr void operator*=(const Quaternion& q);
 
-        inline void operator/=(float s);
+        constexpr void operator/=(float s);
 
-        inline Quaternion operator+(const Quaternion& q) const;
+        constexpr Quaternion operator+(const Quaternion& q) const;
 
-        inline Quaternion operator-(const Quaternion& q) const;
+        constexpr Quaternion operator-(const Quaternion& q) const;
 
-        inline Quaternion operator*(float s) const;
+        constexpr Quaternion operator*(float s) const;
 
-        inline Quaternion operator*(const Quaternion& q) const;
+        constexpr Quaternion operator*(const Quaternion& q) const;
 
-        inline Quaternion operator/(float s) const;
+        constexpr Quaternion operator/(float s) const;
 
-        inline bool operator==(const Quaternion& q) const;
+        constexpr bool operator==(const Quaternion& q) const;
 
-        inline bool operator!=(const Quaternion& q) const;
+        constexpr bool operator!=(const Quaternion& q) const;
 
         union {
             struct {
@@ -116,7 +120,11 @@ namespace re {
         };
     };
 
-    Quaternion::Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {
+    constexpr Quaternion::Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {
+
+    }
+
+    constexpr Quaternion::Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {
 
     }
 
@@ -128,7 +136,7 @@ namespace re {
      *
      * @return Quaternion length without apply squared root
      */
-    float Quaternion::lengthSqrt() const {
+    constexpr float Quaternion::lengthSqrt() const {
         return dot(*this);
     }
 
@@ -137,7 +145,7 @@ namespace re {
      * @return Dot product(Scalar product) between this quaternion and another\n
      * @link https://www.wikiwand.com/en/Dot_product.
      */
-    float Quaternion::dot(const Quaternion &q) const {
+    constexpr float Quaternion::dot(const Quaternion &q) const {
         return w * q.w + x * q.x + y * q.y + z * q.z;
     }
 
@@ -146,7 +154,7 @@ namespace re {
      * @return Conjugate of this Quaternion
      * @link https://www.wikiwand.com/en/Quaternion#/Conjugation,_the_norm,_and_reciprocal
      */
-    Quaternion Quaternion::conjugate() const {
+    constexpr Quaternion Quaternion::conjugate() const {
         return {w, -x, -y, -z};
     }
 
@@ -158,72 +166,87 @@ namespace re {
         return quat2EulerAnglesYZX(*this);
     }
 
-    float &Quaternion::operator[](size_t i) {
+    constexpr float &Quaternion::operator[](size_t i) {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? w : i == 1 ? x : i == 2 ? y : z;
+
         return values[i];
     }
 
-    const float &Quaternion::operator[](size_t i) const {
+    constexpr const float &Quaternion::operator[](size_t i) const {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? w : i == 1 ? x : i == 2 ? y : z;
+
         return values[i];
     }
 
-    Quaternion Quaternion::operator-() const {
+    constexpr Quaternion Quaternion::operator-() const {
         return {-w, -x, -y, -z};
     }
 
-    void Quaternion::operator+=(const Quaternion &q) {
+    constexpr void Quaternion::operator+=(const Quaternion &q) {
         *this = *this + q;
     }
 
-    void Quaternion::operator-=(const Quaternion &q) {
+    constexpr void Quaternion::operator-=(const Quaternion &q) {
         *this = *this - q;
     }
 
-    void Quaternion::operator*=(float s) {
+    constexpr void Quaternion::operator*=(float s) {
         *this = *this * s;
     }
 
-    void Quaternion::operator*=(const Quaternion &q) {
+    constexpr void Quaternion::operator*=(const Quaternion &q) {
         *this = *this * q;
     }
 
-    void Quaternion::operator/=(float s) {
+    constexpr void Quaternion::operator/=(float s) {
         *this = *this / s;
     }
 
-    Quaternion Quaternion::operator+(const Quaternion &q) const {
+    constexpr Quaternion Quaternion::operator+(const Quaternion &q) const {
         return {w + q.w, x + q.x, y + q.y, z + q.z};
     }
 
-    Quaternion Quaternion::operator-(const Quaternion &q) const {
+    constexpr Quaternion Quaternion::operator-(const Quaternion &q) const {
         return {w - q.w, x - q.x, y - q.y, z - q.z};
     }
 
-    Quaternion Quaternion::operator*(float s) const {
+    constexpr Quaternion Quaternion::operator*(float s) const {
         return {w * s, x * s, y * s, z * s};
     }
 
-    Quaternion Quaternion::operator*(const Quaternion &q) const {
+    constexpr Quaternion Quaternion::operator*(const Quaternion &q) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Quaternion result;
+            _mm_store_ps(result.values, simd::quaternionMultiply(_mm_load_ps(values), _mm_load_ps(q.values)));
+            return result;
+        }
+#endif
         return {
                 w * q.w - x * q.x - y * q.y - z * q.z,
                 w * q.x + x * q.w + y * q.z - z * q.y,
                 w * q.y - x * q.z + y * q.w + z * q.x,
-                w * q.z + x * q.y - y * q.x + x * q.w
+                w * q.z + x * q.y - y * q.x + z * q.w
         };
     }
 
-    Quaternion Quaternion::operator/(float s) const {
+    constexpr Quaternion Quaternion::operator/(float s) const {
         return {w / s, x / s, y / s, z / s};
     }
 
-    bool Quaternion::operator==(const Quaternion &q) const {
+    constexpr bool Quaternion::operator==(const Quaternion &q) const {
         return w == q.w && x == q.x && y == q.y && z == q.z;
     }
 
-    bool Quaternion::operator!=(const Quaternion &q) const {
-        return w != q.w && x != q.x && y != q.y && z != q.z;
+    constexpr bool Quaternion::operator!=(const Quaternion &q) const {
+        return w != q.w || x != q.x || y != q.y || z != q.z;
     }
 
-    inline Quaternion operator*(float n, const Quaternion& q) {
+    constexpr Quaternion operator*(float n, const Quaternion& q) {
         return q * n;
     }
 
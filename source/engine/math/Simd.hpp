@@ -0,0 +1,361 @@
+#ifndef RAVENENGINE_SIMD_HPP
+#define RAVENENGINE_SIMD_HPP
+
+
+// RE_SIMD is defined by the RE_SIMD CMake option. The kernels need SSE4.1, without it or without the option the
+// math types use their scalar code.
+#if defined(RE_SIMD) && (defined(__SSE4_1__) || defined(__AVX__))
+#define RE_SIMD_SSE4
+#include <immintrin.h>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define RE_SIMD_FMA
+#endif
+#endif
+
+
+namespace re::simd {
+
+#ifdef RE_SIMD_SSE4
+
+    /**
+     *
+     * @return a * b + c, fused when AVX2 and FMA are enabled
+     */
+    inline __m128 madd(__m128 a, __m128 b, __m128 c) {
+#ifdef RE_SIMD_FMA
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    template<int i>
+    inline __m128 splat(__m128 v) {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i));
+    }
+
+    inline float dot(__m128 a, __m128 b) {
+        return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xFF));
+    }
+
+    /**
+     * @brief 4x4 product of matrices stored as four 16 byte aligned columns
+     * @param a Left matrix
+     * @param b Right matrix
+     * @param out Result, can't alias a nor b
+     */
+    inline void multiply(const float* a, const float* b, float* out) {
+        __m128 a0 = _mm_load_ps(a);
+        __m128 a1 = _mm_load_ps(a + 4);
+        __m128 a2 = _mm_load_ps(a + 8);
+        __m128 a3 = _mm_load_ps(a + 12);
+
+        for (int j = 0; j < 4; ++j) {
+            __m128 column = _mm_load_ps(b + 4 * j);
+
+            __m128 result = _mm_mul_ps(a0, splat<0>(column));
+            result = madd(a1, splat<1>(column), result);
+            result = madd(a2, splat<2>(column), result);
+            result = madd(a3, splat<3>(column), result);
+
+            _mm_store_ps(out + 4 * j, result);
+        }
+    }
+
+    inline void transpose(const float* in, float* out) {
+        __m128 r0 = _mm_load_ps(in);
+        __m128 r1 = _mm_load_ps(in + 4);
+        __m128 r2 = _mm_load_ps(in + 8);
+        __m128 r3 = _mm_load_ps(in + 12);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        _mm_store_ps(out, r0);
+        _mm_store_ps(out + 4, r1);
+        _mm_store_ps(out + 8, r2);
+        _mm_store_ps(out + 12, r3);
+    }
+
+    /**
+     * @brief Dot product of each of the four vectors of m with v
+     */
+    inline __m128 dot4(const float* m, __m128 v) {
+        __m128 r0 = _mm_load_ps(m);
+        __m128 r1 = _mm_load_ps(m + 4);
+        __m128 r2 = _mm_load_ps(m + 8);
+        __m128 r3 = _mm_load_ps(m + 12);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        __m128 result = _mm_mul_ps(r0, splat<0>(v));
+        result = madd(r1, splat<1>(v), result);
+        result = madd(r2, splat<2>(v), result);
+        return madd(r3, splat<3>(v), result);
+    }
+
+    /**
+     * @brief m * (x, y, z, 1) with m stored as columns
+     */
+    inline __m128 transformPoint(const float* m, float x, float y, float z) {
+        __m128 result = madd(_mm_load_ps(m), _mm_set1_ps(x), _mm_load_ps(m + 12));
+        result = madd(_mm_load_ps(m + 4), _mm_set1_ps(y), result);
+        return madd(_mm_load_ps(m + 8), _mm_set1_ps(z), result);
+    }
+
+    /**
+     * @brief General 4x4 inverse with Cramer's rule, based on the Intel SSE inverse (AP-928). The layout only
+     * needs to be the same in and out.
+     * @param in Matrix to invert
+     * @param out Inverse, can alias in
+     * @return Determinant of the matrix. If it's 0 out is not finite.
+     */
+    inline float inverse(const float* in, float* out) {
+        __m128 minor0, minor1, minor2, minor3;
+        __m128 row0, row1, row2, row3;
+        __m128 det, tmp;
+
+        tmp = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in)), reinterpret_cast<const __m64*>(in + 4));
+        row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in + 8)), reinterpret_cast<const __m64*>(in + 12));
+        row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+        row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+        tmp = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in + 2)), reinterpret_cast<const __m64*>(in + 6));
+        row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in + 10)), reinterpret_cast<const __m64*>(in + 14));
+        row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+        row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+        tmp = _mm_mul_ps(row2, row3);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        minor0 = _mm_mul_ps(row1, tmp);
+        minor1 = _mm_mul_ps(row0, tmp);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+        minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+        minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+        tmp = _mm_mul_ps(row1, row2);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+        minor3 = _mm_mul_ps(row0, tmp);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+        minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+        minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+        tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+        minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+        minor2 = _mm_mul_ps(row0, tmp);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+        minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+        minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+        tmp = _mm_mul_ps(row0, row1);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+        minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+        tmp = _mm_mul_ps(row0, row3);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+        minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+        minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+        tmp = _mm_mul_ps(row0, row2);
+        tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+        minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+        minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+        tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+        minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+        minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+        det = _mm_mul_ps(row0, minor0);
+        det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+        det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+        float determinant = _mm_cvtss_f32(det);
+
+        // Exact division instead of the reciprocal estimate of the original
+        __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), splat<0>(det));
+        _mm_store_ps(out, _mm_mul_ps(invDet, minor0));
+        _mm_store_ps(out + 4, _mm_mul_ps(invDet, minor1));
+        _mm_store_ps(out + 8, _mm_mul_ps(invDet, minor2));
+        _mm_store_ps(out + 12, _mm_mul_ps(invDet, minor3));
+
+        return determinant;
+    }
+
+    /**
+     *
+     * @return Cross product of the xyz lanes, w is 0
+     */
+    inline __m128 cross(__m128 a, __m128 b) {
+        __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 result = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+        return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    /**
+     * @brief Columns of the rotation matrix of a quaternion stored as (w, x, y, z), w lanes are 0. The
+     * quaternion doesn't need to be unit.
+     */
+    inline void rotationColumns(__m128 q, __m128& c0, __m128& c1, __m128& c2) {
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+        // v = (x, y, z, 0) and p = v * 2 / |q|^2
+        __m128 v = _mm_and_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 3, 2, 1)), xyzMask);
+        __m128 p = _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(2.0f), _mm_dp_ps(q, q, 0xFF)));
+
+        // Column j = e_j * (1 - v.p) + v * p_j + (w * p) x e_j
+        __m128 diagonal = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_dp_ps(v, p, 0x7F));
+        __m128 wp = _mm_mul_ps(splat<0>(q), p);
+        __m128 zero = _mm_setzero_ps();
+
+        // (w * p) x e0 = (0, wz, -wy), (w * p) x e1 = (-wz, 0, wx) and (w * p) x e2 = (wy, -wx, 0)
+        __m128 cross0 = _mm_mul_ps(_mm_shuffle_ps(wp, wp, _MM_SHUFFLE(3, 1, 2, 0)), _mm_setr_ps(0.0f, 1.0f, -1.0f, 0.0f));
+        __m128 cross1 = _mm_mul_ps(_mm_shuffle_ps(wp, wp, _MM_SHUFFLE(3, 0, 3, 2)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f));
+        __m128 cross2 = _mm_mul_ps(_mm_shuffle_ps(wp, wp, _MM_SHUFFLE(3, 3, 0, 1)), _mm_setr_ps(1.0f, -1.0f, 0.0f, 0.0f));
+
+        c0 = _mm_add_ps(madd(v, splat<0>(p), cross0), _mm_blend_ps(zero, diagonal, 0x1));
+        c1 = _mm_add_ps(madd(v, splat<1>(p), cross1), _mm_blend_ps(zero, diagonal, 0x2));
+        c2 = _mm_add_ps(madd(v, splat<2>(p), cross2), _mm_blend_ps(zero, diagonal, 0x4));
+    }
+
+    /**
+     * @brief Translation * scale * rotation matrix stored as columns, the layout of Matrix4::compose
+     * @param position (x, y, z, 1)
+     * @param rotation (w, x, y, z)
+     * @param scale (x, y, z, 0)
+     */
+    inline void compose(__m128 position, __m128 rotation, __m128 scale, float* out) {
+        __m128 c0, c1, c2;
+        rotationColumns(rotation, c0, c1, c2);
+
+        _mm_store_ps(out, _mm_mul_ps(c0, scale));
+        _mm_store_ps(out + 4, _mm_mul_ps(c1, scale));
+        _mm_store_ps(out + 8, _mm_mul_ps(c2, scale));
+        _mm_store_ps(out + 12, position);
+    }
+
+    /**
+     * @brief Inverse of compose: the transposed rotation with the reciprocal scale and the translation moved
+     * to that space
+     * @param position (x, y, z, 1)
+     * @param rotation (w, x, y, z)
+     * @param scale (x, y, z, 1), no component can be 0
+     */
+    inline void composeInverse(__m128 position, __m128 rotation, __m128 scale, float* out) {
+        __m128 c0, c1, c2, c3 = _mm_setzero_ps();
+        rotationColumns(rotation, c0, c1, c2);
+
+        // Rows of the rotation, column j of the inverse is row j / scale_j
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        __m128 invScale = _mm_div_ps(_mm_set1_ps(1.0f), scale);
+        c0 = _mm_mul_ps(c0, splat<0>(invScale));
+        c1 = _mm_mul_ps(c1, splat<1>(invScale));
+        c2 = _mm_mul_ps(c2, splat<2>(invScale));
+
+        __m128 translation = _mm_mul_ps(c0, splat<0>(position));
+        translation = madd(c1, splat<1>(position), translation);
+        translation = madd(c2, splat<2>(position), translation);
+        translation = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+        _mm_store_ps(out, c0);
+        _mm_store_ps(out + 4, c1);
+        _mm_store_ps(out + 8, c2);
+        _mm_store_ps(out + 12, translation);
+    }
+
+    /**
+     * @brief Rows of the inverse of the 3x3 part of a matrix stored as columns, not divided by the determinant.
+     * They are the cross products of the columns, so they are also the columns of the cofactor matrix.
+     * @return Determinant of the 3x3 part
+     */
+    inline float cofactors(const float* in, __m128& r0, __m128& r1, __m128& r2) {
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        __m128 c0 = _mm_and_ps(_mm_load_ps(in), xyzMask);
+        __m128 c1 = _mm_and_ps(_mm_load_ps(in + 4), xyzMask);
+        __m128 c2 = _mm_and_ps(_mm_load_ps(in + 8), xyzMask);
+
+        r0 = cross(c1, c2);
+        r1 = cross(c2, c0);
+        r2 = cross(c0, c1);
+
+        return _mm_cvtss_f32(_mm_dp_ps(c0, r0, 0x71));
+    }
+
+    /**
+     * @brief Inverse of an affine matrix stored as columns: inverse of the 3x3 part and the translation moved
+     * to that space. The last row of the input is taken as (0, 0, 0, 1).
+     * @return Determinant of the 3x3 part. If it's 0 out is not finite.
+     */
+    inline float affineInverse(const float* in, float* out) {
+        __m128 r0, r1, r2, r3 = _mm_setzero_ps();
+        float determinant = cofactors(in, r0, r1, r2);
+
+        __m128 invDet = _mm_set1_ps(1.0f / determinant);
+        r0 = _mm_mul_ps(r0, invDet);
+        r1 = _mm_mul_ps(r1, invDet);
+        r2 = _mm_mul_ps(r2, invDet);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        __m128 position = _mm_load_ps(in + 12);
+        __m128 translation = _mm_mul_ps(r0, splat<0>(position));
+        translation = madd(r1, splat<1>(position), translation);
+        translation = madd(r2, splat<2>(position), translation);
+        translation = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+        _mm_store_ps(out, r0);
+        _mm_store_ps(out + 4, r1);
+        _mm_store_ps(out + 8, r2);
+        _mm_store_ps(out + 12, translation);
+
+        return determinant;
+    }
+
+    /**
+     * @brief Inverse transpose of the 3x3 part of a matrix stored as columns, without translation
+     * @return Determinant of the 3x3 part. If it's 0 out is not finite.
+     */
+    inline float normalMatrix(const float* in, float* out) {
+        __m128 r0, r1, r2;
+        float determinant = cofactors(in, r0, r1, r2);
+
+        // The transpose of the inverse rows are the same vectors stored as columns
+        __m128 invDet = _mm_set1_ps(1.0f / determinant);
+        _mm_store_ps(out, _mm_mul_ps(r0, invDet));
+        _mm_store_ps(out + 4, _mm_mul_ps(r1, invDet));
+        _mm_store_ps(out + 8, _mm_mul_ps(r2, invDet));
+        _mm_store_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+
+        return determinant;
+    }
+
+    /**
+     * @brief Hamilton product of quaternions stored as (w, x, y, z)
+     */
+    inline __m128 quaternionMultiply(__m128 a, __m128 b) {
+        const __m128 signX = _mm_castsi128_ps(_mm_setr_epi32(static_cast<int>(0x80000000), 0, static_cast<int>(0x80000000), 0));
+        const __m128 signY = _mm_castsi128_ps(_mm_setr_epi32(static_cast<int>(0x80000000), 0, 0, static_cast<int>(0x80000000)));
+        const __m128 signZ = _mm_castsi128_ps(_mm_setr_epi32(static_cast<int>(0x80000000), static_cast<int>(0x80000000), 0, 0));
+
+        // a.w * (w, x, y, z) + a.x * (-x, w, -z, y) + a.y * (-y, z, w, -x) + a.z * (-z, -y, x, w)
+        __m128 result = _mm_mul_ps(splat<0>(a), b);
+        result = madd(splat<1>(a), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), signX), result);
+        result = madd(splat<2>(a), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), signY), result);
+        return madd(splat<3>(a), _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), signZ), result);
+    }
+
+#endif
+
+} // namespace re::simd
+
+
+#endif //RAVENENGINE_SIMD_HPP
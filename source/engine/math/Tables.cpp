@@ -0,0 +1,115 @@
+#include "Tables.hpp"
+
+#include "Math.hpp"
+#include "Matrix4.hpp"
+#include "Basis.hpp"
+
+
+namespace re::math {
+
+    namespace {
+
+        constexpr std::array<float, 256> makeSrgbToLinear() {
+            std::array<float, 256> table{};
+            for (uint32_t i = 0; i < 256; ++i)
+                table[i] = static_cast<float>(srgbToLinear(i / 255.0));
+
+            return table;
+        }
+
+        constexpr std::array<uint8_t, LINEAR_TO_SRGB_SIZE> makeLinearToSrgb() {
+            std::array<uint8_t, LINEAR_TO_SRGB_SIZE> table{};
+            for (uint32_t i = 0; i < LINEAR_TO_SRGB_SIZE; ++i)
+                table[i] = static_cast<uint8_t>(round(linearToSrgb(i / (LINEAR_TO_SRGB_SIZE - 1.0)) * 255.0));
+
+            return table;
+        }
+
+        constexpr std::array<Vector3, OCTAHEDRAL_SIZE * OCTAHEDRAL_SIZE> makeOctahedralDecode() {
+            std::array<Vector3, OCTAHEDRAL_SIZE * OCTAHEDRAL_SIZE> table{};
+            for (uint32_t y = 0; y < OCTAHEDRAL_SIZE; ++y) {
+                for (uint32_t x = 0; x < OCTAHEDRAL_SIZE; ++x) {
+                    table[x + y * OCTAHEDRAL_SIZE] = octahedralDecode(x / (OCTAHEDRAL_SIZE - 1.0) * 2.0 - 1.0,
+                                                                      y / (OCTAHEDRAL_SIZE - 1.0) * 2.0 - 1.0);
+                }
+            }
+
+            return table;
+        }
+
+        constexpr bool near(double a, double b, double tolerance) {
+            return abs(a - b) <= tolerance;
+        }
+
+        constexpr bool near(const Vector3& a, const Vector3& b, float tolerance) {
+            return near(a.x, b.x, tolerance) && near(a.y, b.y, tolerance) && near(a.z, b.z, tolerance);
+        }
+
+    } // namespace
+
+    // Defined constexpr after the extern declarations, so they keep external linkage and are built once here
+    constexpr std::array<float, 256> SRGB_TO_LINEAR = makeSrgbToLinear();
+
+    constexpr std::array<uint8_t, LINEAR_TO_SRGB_SIZE> LINEAR_TO_SRGB = makeLinearToSrgb();
+
+    constexpr std::array<Vector3, OCTAHEDRAL_SIZE * OCTAHEDRAL_SIZE> OCTAHEDRAL_DECODE = makeOctahedralDecode();
+
+    /**
+     *
+     * @param n Unit normal
+     * @return Code of the nearest entry of OCTAHEDRAL_DECODE
+     */
+    uint16_t encodeOctahedral(const Vector3& n) {
+        const float invL1 = 1.0f / (Math::abs(n.x) + Math::abs(n.y) + Math::abs(n.z));
+        float u = n.x * invL1;
+        float v = n.y * invL1;
+
+        if (n.z < 0.0f) {
+            const float foldedU = (1.0f - Math::abs(v)) * (u < 0.0f ? -1.0f : 1.0f);
+            v = (1.0f - Math::abs(u)) * (v < 0.0f ? -1.0f : 1.0f);
+            u = foldedU;
+        }
+
+        constexpr float scale = (OCTAHEDRAL_SIZE - 1) * 0.5f;
+        const auto x = static_cast<uint32_t>((u + 1.0f) * scale + 0.5f);
+        const auto y = static_cast<uint32_t>((v + 1.0f) * scale + 0.5f);
+
+        return static_cast<uint16_t>(x | (y << OCTAHEDRAL_BITS));
+    }
+
+    // Compile time tests of the constexpr approximations, the math types and the tables
+
+    static_assert(near(sin(0.0), 0.0, 1e-12) && near(sin(HALF_PI), 1.0, 1e-12) && near(sin(-HALF_PI), -1.0, 1e-12));
+    static_assert(near(sin(PI / 6.0), 0.5, 1e-12) && near(sin(100.0), -0.50636564110975879, 1e-10));
+    static_assert(near(cos(0.0), 1.0, 1e-12) && near(cos(PI), -1.0, 1e-12) && near(cos(PI / 3.0), 0.5, 1e-12));
+    static_assert(near(sqrt(2.0), 1.41421356237309505, 1e-15) && sqrt(0.0) == 0.0 && near(sqrt(1e-6), 1e-3, 1e-18));
+    static_assert(near(exp(1.0), Math_E, 1e-14) && near(exp(-2.0), 0.13533528323661270, 1e-16));
+    static_assert(near(log(Math_E), 1.0, 1e-14) && near(log(0.001), -6.90775527898213705, 1e-13));
+    static_assert(near(pow(2.0, 10.0), 1024.0, 1e-10) && near(pow(0.5, 2.4), 0.18946457081379978, 1e-15));
+
+    static_assert(Math::deg2rad(180.0f) == Math::PI && Math::rad2deg(Math::PI) == 180.0f);
+    static_assert(Math::abs(-2.0f) == 2.0f && Math::abs(-2) == 2);
+
+    static_assert(Vector3(1.0f, 2.0f, 3.0f).cross({0.0f, 1.0f, 0.0f}) == Vector3(-3.0f, 0.0f, 1.0f));
+    static_assert(Vector3(1.0f, 2.0f, 3.0f)[2] == 3.0f && Vector3(1.0f, 2.0f, 3.0f).dot({1.0f, 1.0f, 1.0f}) == 6.0f);
+    static_assert(Vector3(1.0f, 2.0f, 3.0f) != Vector3(1.0f, 2.0f, 4.0f));
+    static_assert(Vector4(1.0f, 2.0f, 3.0f, 4.0f) * 2.0f == Vector4(2.0f, 4.0f, 6.0f, 8.0f));
+    static_assert((Quaternion() * Quaternion(0.0f, 1.0f, 0.0f, 0.0f)) == Quaternion(0.0f, 1.0f, 0.0f, 0.0f));
+
+    static_assert(Matrix4(2.0f) * Matrix4(0.5f) == Matrix4() && Matrix4(2.0f).determinant() == 16.0f);
+    static_assert(Matrix4({1.0f, 2.0f, 3.0f, 4.0f}, {}, {}, {}).transposed()[3] == Vector4(4.0f, 0.0f, 0.0f, 0.0f));
+    static_assert(Matrix4().transformPoint({1.0f, 2.0f, 3.0f}) == Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+    static_assert(Basis(2.0f) == Basis().scaled({2.0f, 2.0f, 2.0f}) && Basis(2.0f).determinant() == 8.0f);
+    static_assert(Basis(2.0f) * Basis(0.5f) == Basis() && Basis(2.0f) * Vector3(1.0f) == Vector3(2.0f));
+
+    static_assert(SRGB_TO_LINEAR[0] == 0.0f && SRGB_TO_LINEAR[255] == 1.0f);
+    static_assert(near(SRGB_TO_LINEAR[10], 0.0030352698, 1e-9) && near(SRGB_TO_LINEAR[128], 0.2158605, 1e-7));
+    static_assert(LINEAR_TO_SRGB[0] == 0 && LINEAR_TO_SRGB[LINEAR_TO_SRGB_SIZE - 1] == 255);
+    static_assert(LINEAR_TO_SRGB[static_cast<uint32_t>(0.2158605 * (LINEAR_TO_SRGB_SIZE - 1) + 0.5)] == 128);
+
+    static_assert(near(OCTAHEDRAL_DECODE[0], Vector3(0.0f, 0.0f, -1.0f), 1e-6f));
+    static_assert(near(OCTAHEDRAL_DECODE[OCTAHEDRAL_SIZE - 1], Vector3(0.0f, 0.0f, -1.0f), 1e-6f));
+    static_assert(near(OCTAHEDRAL_DECODE[(OCTAHEDRAL_SIZE / 2 - 1) * OCTAHEDRAL_SIZE], Vector3(-1.0f, 0.0f, 0.0f), 1e-2f));
+    static_assert(near(OCTAHEDRAL_DECODE[(OCTAHEDRAL_SIZE / 2 - 1) * (OCTAHEDRAL_SIZE + 1)], Vector3(0.0f, 0.0f, 1.0f), 1e-2f));
+
+} // namespace re::math
@@ -0,0 +1,94 @@
+#ifndef RAVENENGINE_TABLES_HPP
+#define RAVENENGINE_TABLES_HPP
+
+
+#include <array>
+#include <cstdint>
+
+#include "ConstMath.hpp"
+#include "Vector3.hpp"
+
+
+namespace re::math {
+
+    // Entries of the linear to sRGB table, results are at most one code off where the curve is steepest, near black
+    constexpr uint32_t LINEAR_TO_SRGB_SIZE = 4096;
+
+    // Bits per axis of an octahedral encoded normal, two axes are packed in an uint16_t as x | y << OCTAHEDRAL_BITS.
+    // 7 bits keep the decode table at 192 KB and its generation at a few seconds of compile time, the round trip
+    // error stays below 2 degrees
+    constexpr uint32_t OCTAHEDRAL_BITS = 7;
+
+    constexpr uint32_t OCTAHEDRAL_SIZE = 1u << OCTAHEDRAL_BITS;
+
+    /**
+     *
+     * @param c sRGB encoded value in [0, 1]
+     * @return Linear value, with the IEC 61966-2-1 transfer function
+     */
+    constexpr double srgbToLinear(double c) {
+        return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    /**
+     *
+     * @param c Linear value in [0, 1]
+     * @return sRGB encoded value
+     */
+    constexpr double linearToSrgb(double c) {
+        return c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+    }
+
+    /**
+     *
+     * @param u Coordinate of the octahedron unfolded on [-1, 1]
+     * @param v Coordinate of the octahedron unfolded on [-1, 1]
+     * @return Unit normal, the lower hemisphere is folded over the diagonals
+     */
+    constexpr Vector3 octahedralDecode(double u, double v) {
+        double x = u;
+        double y = v;
+        const double z = 1.0 - abs(u) - abs(v);
+
+        if (z < 0.0) {
+            x = (1.0 - abs(v)) * (u < 0.0 ? -1.0 : 1.0);
+            y = (1.0 - abs(u)) * (v < 0.0 ? -1.0 : 1.0);
+        }
+
+        const double invLength = 1.0 / sqrt(x * x + y * y + z * z);
+        return {static_cast<float>(x * invLength), static_cast<float>(y * invLength), static_cast<float>(z * invLength)};
+    }
+
+    // sRGB 8 bits value to linear
+    extern const std::array<float, 256> SRGB_TO_LINEAR;
+
+    // Linear value quantized to LINEAR_TO_SRGB_SIZE steps to sRGB 8 bits value
+    extern const std::array<uint8_t, LINEAR_TO_SRGB_SIZE> LINEAR_TO_SRGB;
+
+    // Octahedral encoded normal to unit normal, indexed by the packed code
+    extern const std::array<Vector3, OCTAHEDRAL_SIZE * OCTAHEDRAL_SIZE> OCTAHEDRAL_DECODE;
+
+    inline float decodeSrgb(uint8_t c) {
+        return SRGB_TO_LINEAR[c];
+    }
+
+    /**
+     *
+     * @param c Linear value, clamped to [0, 1]
+     * @return sRGB 8 bits value
+     */
+    inline uint8_t encodeSrgb(float c) {
+        c = c > 0.0f ? (c < 1.0f ? c : 1.0f) : 0.0f;
+        return LINEAR_TO_SRGB[static_cast<uint32_t>(c * (LINEAR_TO_SRGB_SIZE - 1) + 0.5f)];
+    }
+
+    inline Vector3 decodeOctahedral(uint16_t code) {
+        return OCTAHEDRAL_DECODE[code];
+    }
+
+    uint16_t encodeOctahedral(const Vector3& n);
+
+} // namespace re::math
+
+
+#endif //RAVENENGINE_TABLES_HPP
@@ -4,25 +4,26 @@
 
 #include <string>
 #include <limits>
+#include <type_traits>
 
 
 namespace re {
 
     class Vector2 {
     public:
-        inline Vector2();
+        constexpr Vector2();
 
-        inline explicit Vector2(float n);
+        constexpr explicit Vector2(float n);
 
-        inline Vector2(float x, float y);
+        constexpr Vector2(float x, float y);
 
         explicit Vector2(const float* v);
 
         explicit Vector2(const double* v);
 
-        inline Vector2(const Vector2& v);
+        constexpr Vector2(const Vector2& v);
 
-        [[nodiscard]] inline float lengthSqrt() const;
+        [[nodiscard]] constexpr float lengthSqrt() const;
 
         [[nodiscard]] float length() const;
 
@@ -32,45 +33,45 @@ namespace re {
 
         [[nodiscard]] Vector2 normalized() const;
 
-        [[nodiscard]] inline float dot(const Vector2& v) const;
+        [[nodiscard]] constexpr float dot(const Vector2& v) const;
 
-        inline void inverse();
+        constexpr void inverse();
 
-        [[nodiscard]] inline Vector2 inversed() const;
+        [[nodiscard]] constexpr Vector2 inversed() const;
 
         [[nodiscard]] std::string str() const;
 
-        inline Vector2& operator=(const Vector2& v) = default;
+        constexpr Vector2& operator=(const Vector2& v) = default;
 
-        inline float& operator[](size_t i);
+        constexpr float& operator[](size_t i);
 
-        inline const float& operator[](size_t i) const;
+        constexpr const float& operator[](size_t i) const;
 
-        inline Vector2 operator-() const;
+        constexpr Vector2 operator-() const;
 
-        inline void operator+=(const Vector2& v);
+        constexpr void operator+=(const Vector2& v);
 
-        inline void operator-=(const Vector2& v);
+        constexpr void operator-=(const Vector2& v);
 
-        inline void operator*=(float s);
+        constexpr void operator*=(float s);
 
-        inline void operator*=(const Vector2& v);
+        constexpr void operator*=(const Vector2& v);
 
-        inline void operator/=(float s);
+        constexpr void operator/=(float s);
 
-        inline Vector2 operator+(const Vector2& v) const;
+        constexpr Vector2 operator+(const Vector2& v) const;
 
-        inline Vector2 operator-(const Vector2& v) const;
+        constexpr Vector2 operator-(const Vector2& v) const;
 
-        inline Vector2 operator*(float s) const;
+        constexpr Vector2 operator*(float s) const;
 
-        inline Vector2 operator*(const Vector2& v) const;
+        constexpr Vector2 operator*(const Vector2& v) const;
 
-        inline Vector2 operator/(float s) const;
+        constexpr Vector2 operator/(float s) const;
 
-        inline bool operator==(const Vector2& v) const;
+        constexpr bool operator==(const Vector2& v) const;
 
-        inline bool operator!=(const Vector2& v) const;
+        constexpr bool operator!=(const Vector2& v) const;
 
         union {
             struct {
@@ -80,17 +81,19 @@ namespace re {
         };
     };
 
-    Vector2::Vector2() = default;
+    constexpr Vector2::Vector2() : x(0.0f), y(0.0f) {
 
-    Vector2::Vector2(float n) : x(n), y(n) {
+    }
+
+    constexpr Vector2::Vector2(float n) : x(n), y(n) {
 
     }
 
-    Vector2::Vector2(float x, float y) : x(x), y(y) {
+    constexpr Vector2::Vector2(float x, float y) : x(x), y(y) {
 
     }
 
-    Vector2::Vector2(const Vector2 &v) : x(v.x), y(v.y) {
+    constexpr Vector2::Vector2(const Vector2 &v) : x(v.x), y(v.y) {
 
     }
 
@@ -98,7 +101,7 @@ namespace re {
      *
      * @return Vector length without apply squared root
      */
-    float Vector2::lengthSqrt() const {
+    constexpr float Vector2::lengthSqrt() const {
         return dot(*this);
     }
 
@@ -107,14 +110,14 @@ namespace re {
      * @return Dot product(Scalar product) between this vector and another\n
      * @link https://www.wikiwand.com/en/Dot_product.
      */
-    float Vector2::dot(const Vector2 &v) const {
+    constexpr float Vector2::dot(const Vector2 &v) const {
         return x * v.x + y * v.y;
     }
 
     /**
      * Turn this vector in its inverse
      */
-    void Vector2::inverse() {
+    constexpr void Vector2::inverse() {
         *this = inversed();
     }
 
@@ -122,71 +125,79 @@ namespace re {
      *
      * @return Inverse of this vector. 1 divided by each component.
      */
-    Vector2 Vector2::inversed() const {
+    constexpr Vector2 Vector2::inversed() const {
         return {1.0f / x, 1.0f / y};
     }
 
-    float &Vector2::operator[](size_t i) {
+    constexpr float &Vector2::operator[](size_t i) {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : y;
+
         return values[i];
     }
 
-    const float &Vector2::operator[](size_t i) const {
+    constexpr const float &Vector2::operator[](size_t i) const {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : y;
+
         return values[i];
     }
 
-    Vector2 Vector2::operator-() const {
+    constexpr Vector2 Vector2::operator-() const {
         return {-x, -y};
     }
 
-    void Vector2::operator+=(const Vector2 &v) {
+    constexpr void Vector2::operator+=(const Vector2 &v) {
         *this = *this + v;
     }
 
-    void Vector2::operator-=(const Vector2 &v) {
+    constexpr void Vector2::operator-=(const Vector2 &v) {
         *this = *this - v;
     }
 
-    void Vector2::operator*=(float s) {
+    constexpr void Vector2::operator*=(float s) {
         *this = *this * s;
     }
 
-    void Vector2::operator*=(const Vector2 &v) {
+    constexpr void Vector2::operator*=(const Vector2 &v) {
         *this = *this * v;
     }
 
-    void Vector2::operator/=(float s) {
+    constexpr void Vector2::operator/=(float s) {
         *this = *this / s;
     }
 
-    Vector2 Vector2::operator+(const Vector2 &v) const {
+    constexpr Vector2 Vector2::operator+(const Vector2 &v) const {
         return {x + v.x, y + v.y};
     }
 
-    Vector2 Vector2::operator-(const Vector2 &v) const {
+    constexpr Vector2 Vector2::operator-(const Vector2 &v) const {
         return {x - v.x,  y - v.y};
     }
 
-    Vector2 Vector2::operator*(float s) const {
+    constexpr Vector2 Vector2::operator*(float s) const {
         return {x * s, y * s};
     }
 
-    Vector2 Vector2::operator*(const Vector2 &v) const {
+    constexpr Vector2 Vector2::operator*(const Vector2 &v) const {
         return {x * v.x,  y * v.y};
     }
 
-    Vector2 Vector2::operator/(float s) const {
+    constexpr Vector2 Vector2::operator/(float s) const {
         return {x / s, y / s};
     }
 
-    bool Vector2::operator==(const Vector2 &v) const {
+    constexpr bool Vector2::operator==(const Vector2 &v) const {
         return x == v.x && y == v.y;
     }
 
-    bool Vector2::operator!=(const Vector2 &v) const {
-        return x != v.x && y != v.y;
+    constexpr bool Vector2::operator!=(const Vector2 &v) const {
+        return x != v.x || y != v.y;
     }
 
-    inline Vector2 operator*(float n, const Vector2& v) {
+    constexpr Vector2 operator*(float n, const Vector2& v) {
         return v * n;
     }
 
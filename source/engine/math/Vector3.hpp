@@ -4,25 +4,26 @@
 
 #include <string>
 #include <limits>
+#include <type_traits>
 
 
 namespace re {
 
     class Vector3 {
     public:
-        inline Vector3();
+        constexpr Vector3();
 
-        inline explicit Vector3(float n);
+        constexpr explicit Vector3(float n);
 
-        inline Vector3(float x, float y, float z);
+        constexpr Vector3(float x, float y, float z);
 
         explicit Vector3(const float* v);
 
         explicit Vector3(const double * v);
 
-        inline Vector3(const Vector3& v);
+        constexpr Vector3(const Vector3& v);
 
-        [[nodiscard]] inline float lengthSqrt() const;
+        [[nodiscard]] constexpr float lengthSqrt() const;
 
         [[nodiscard]] float length() const;
 
@@ -32,47 +33,47 @@ namespace re {
 
         [[nodiscard]] Vector3 normalized() const;
 
-        [[nodiscard]] inline float dot(const Vector3& v) const;
+        [[nodiscard]] constexpr float dot(const Vector3& v) const;
 
-        [[nodiscard]] inline Vector3 cross(const Vector3& v) const;
+        [[nodiscard]] constexpr Vector3 cross(const Vector3& v) const;
 
-        inline void inverse();
+        constexpr void inverse();
 
-        [[nodiscard]] inline Vector3 inversed() const;
+        [[nodiscard]] constexpr Vector3 inversed() const;
 
         [[nodiscard]] std::string str() const;
 
-        inline Vector3& operator=(const Vector3& v) = default;
+        constexpr Vector3& operator=(const Vector3& v) = default;
 
-        inline float& operator[](size_t i);
+        constexpr float& operator[](size_t i);
 
-        inline const float& operator[](size_t i) const;
+        constexpr const float& operator[](size_t i) const;
 
-        inline Vector3 operator-() const;
+        constexpr Vector3 operator-() const;
 
-        inline void operator+=(const Vector3& v);
+        constexpr void operator+=(const Vector3& v);
 
-        inline void operator-=(const Vector3& v);
+        constexpr void operator-=(const Vector3& v);
 
-        inline void operator*=(float s);
+        constexpr void operator*=(float s);
 
-        inline void operator*=(const Vector3& v);
+        constexpr void operator*=(const Vector3& v);
 
-        inline void operator/=(float s);
+        constexpr void operator/=(float s);
 
-        inline Vector3 operator+(const Vector3& v) const;
+        constexpr Vector3 operator+(const Vector3& v) const;
 
-        inline Vector3 operator-(const Vector3& v) const;
+        constexpr Vector3 operator-(const Vector3& v) const;
 
-        inline Vector3 operator*(float s) const;
+        constexpr Vector3 operator*(float s) const;
 
-        inline Vector3 operator*(const Vector3& v) const;
+        constexpr Vector3 operator*(const Vector3& v) const;
 
-        inline Vector3 operator/(float s) const;
+        constexpr Vector3 operator/(float s) const;
 
-        inline bool operator==(const Vector3& v) const;
+        constexpr bool operator==(const Vector3& v) const;
 
-        inline bool operator!=(const Vector3& v) const;
+        constexpr bool operator!=(const Vector3& v) const;
 
     public:
         union {
@@ -83,17 +84,19 @@ namespace re {
         };
     };
 
-    Vector3::Vector3() = default;
+    constexpr Vector3::Vector3() : x(0.0f), y(0.0f), z(0.0f) {
 
-    Vector3::Vector3(float n) : x(n), y(n), z(n) {
+    }
+
+    constexpr Vector3::Vector3(float n) : x(n), y(n), z(n) {
 
     }
 
-    Vector3::Vector3(float x, float y, float z) : x(x), y(y), z(z) {
+    constexpr Vector3::Vector3(float x, float y, float z) : x(x), y(y), z(z) {
 
     }
 
-    Vector3::Vector3(const Vector3 &v) : x(v.x), y(v.y), z(v.z) {
+    constexpr Vector3::Vector3(const Vector3 &v) : x(v.x), y(v.y), z(v.z) {
 
     }
 
@@ -101,7 +104,7 @@ namespace re {
      *
      * @return Vector length without apply squared root
      */
-    float Vector3::lengthSqrt() const {
+    constexpr float Vector3::lengthSqrt() const {
         return dot(*this);
     }
 
@@ -110,7 +113,7 @@ namespace re {
      * @return Dot product(Scalar product) between this vector and another\n
      * @link https://www.wikiwand.com/en/Dot_product.
      */
-    float Vector3::dot(const Vector3 &v) const {
+    constexpr float Vector3::dot(const Vector3 &v) const {
         return x * v.x + y * v.y + z * v.z;
     }
 
@@ -119,7 +122,7 @@ namespace re {
      * @return Cross product between this vector and another\n
      * @link https://www.wikiwand.com/en/Cross_product
      */
-    Vector3 Vector3::cross(const Vector3 &v) const {
+    constexpr Vector3 Vector3::cross(const Vector3 &v) const {
         return {
             y * v.z - z * v.y,
             z * v.x - x * v.z,
@@ -130,7 +133,7 @@ namespace re {
     /**
      * Turn this vector in its inverse
      */
-    void Vector3::inverse() {
+    constexpr void Vector3::inverse() {
         *this = inversed();
     }
 
@@ -138,71 +141,79 @@ namespace re {
      *
      * @return Inverse of this vector. 1 divided by each component.
      */
-    Vector3 Vector3::inversed() const {
+    constexpr Vector3 Vector3::inversed() const {
         return {1.0f / x, 1.0f / y, 1.0f / z};
     }
 
-    float &Vector3::operator[](size_t i) {
+    constexpr float &Vector3::operator[](size_t i) {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : i == 1 ? y : z;
+
         return values[i];
     }
 
-    const float &Vector3::operator[](size_t i) const {
+    constexpr const float &Vector3::operator[](size_t i) const {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : i == 1 ? y : z;
+
         return values[i];
     }
 
-    Vector3 Vector3::operator-() const {
+    constexpr Vector3 Vector3::operator-() const {
         return {-x, -y, -z};
     }
 
-    void Vector3::operator+=(const Vector3 &v) {
+    constexpr void Vector3::operator+=(const Vector3 &v) {
         *this = *this + v;
     }
 
-    void Vector3::operator-=(const Vector3 &v) {
+    constexpr void Vector3::operator-=(const Vector3 &v) {
         *this = *this - v;
     }
 
-    void Vector3::operator*=(float s) {
+    constexpr void Vector3::operator*=(float s) {
         *this = *this * s;
     }
 
-    void Vector3::operator*=(const Vector3 &v) {
+    constexpr void Vector3::operator*=(const Vector3 &v) {
         *this = *this * v;
     }
 
-    void Vector3::operator/=(float s) {
+    constexpr void Vector3::operator/=(float s) {
         *this = *this / s;
     }
 
-    Vector3 Vector3::operator+(const Vector3 &v) const {
+    constexpr Vector3 Vector3::operator+(const Vector3 &v) const {
         return {x + v.x, y + v.y, z + v.z};
     }
 
-    Vector3 Vector3::operator-(const Vector3 &v) const {
+    constexpr Vector3 Vector3::operator-(const Vector3 &v) const {
         return {x - v.x, y - v.y, z - v.z};
     }
 
-    Vector3 Vector3::operator*(float s) const {
+    constexpr Vector3 Vector3::operator*(float s) const {
         return {x * s, y * s, z * s};
     }
 
-    Vector3 Vector3::operator*(const Vector3 &v) const {
+    constexpr Vector3 Vector3::operator*(const Vector3 &v) const {
         return {x * v.x, y * v.y, z * v.z};
     }
 
-    Vector3 Vector3::operator/(float s) const {
+    constexpr Vector3 Vector3::operator/(float s) const {
         return {x / s, y / s, z / s};
     }
 
-    bool Vector3::operator==(const Vector3 &v) const {
+    constexpr bool Vector3::operator==(const Vector3 &v) const {
         return x == v.x && y == v.y && z == v.z;
     }
 
-    bool Vector3::operator!=(const Vector3 &v) const {
-        return x != v.x && y != v.y && z != v.z;
+    constexpr bool Vector3::operator!=(const Vector3 &v) const {
+        return x != v.x || y != v.y || z != v.z;
     }
 
-    inline Vector3 operator*(float n, const Vector3& v) {
+    constexpr Vector3 operator*(float n, const Vector3& v) {
         return v * n;
     }
 
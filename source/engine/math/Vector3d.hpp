@@ -0,0 +1,126 @@
+#ifndef RAVENENGINE_VECTOR3D_HPP
+#define RAVENENGINE_VECTOR3D_HPP
+
+
+#include "Vector3.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Double precision position for large worlds. Floats have a step of about 1 mm at 10 km from the
+     * origin, doubles keep sub-millimeter steps up to the size of the solar system. Rendering and physics stay in
+     * float, positions are converted after subtracting a nearby origin, usually the camera position.
+     */
+    class Vector3d {
+    public:
+        constexpr Vector3d();
+
+        constexpr Vector3d(double x, double y, double z);
+
+        constexpr Vector3d(const Vector3& v);
+
+        explicit Vector3d(const double* v);
+
+        [[nodiscard]] constexpr Vector3 toVector3() const;
+
+        [[nodiscard]] constexpr double dot(const Vector3d& v) const;
+
+        constexpr double& operator[](size_t i);
+
+        constexpr const double& operator[](size_t i) const;
+
+        constexpr Vector3d operator-() const;
+
+        constexpr void operator+=(const Vector3d& v);
+
+        constexpr void operator-=(const Vector3d& v);
+
+        constexpr Vector3d operator+(const Vector3d& v) const;
+
+        constexpr Vector3d operator-(const Vector3d& v) const;
+
+        constexpr Vector3d operator*(double s) const;
+
+        constexpr bool operator==(const Vector3d& v) const;
+
+        constexpr bool operator!=(const Vector3d& v) const;
+
+    public:
+        double x, y, z;
+    };
+
+    constexpr Vector3d::Vector3d() : x(0.0), y(0.0), z(0.0) {
+
+    }
+
+    constexpr Vector3d::Vector3d(double x, double y, double z) : x(x), y(y), z(z) {
+
+    }
+
+    constexpr Vector3d::Vector3d(const Vector3& v) : x(v.x), y(v.y), z(v.z) {
+
+    }
+
+    inline Vector3d::Vector3d(const double* v) : x(v[0]), y(v[1]), z(v[2]) {
+
+    }
+
+    /**
+     *
+     * @return Vector rounded to float, only precise near the origin. Subtract a nearby origin first.
+     */
+    constexpr Vector3 Vector3d::toVector3() const {
+        return {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+    }
+
+    constexpr double Vector3d::dot(const Vector3d& v) const {
+        return x * v.x + y * v.y + z * v.z;
+    }
+
+    constexpr double& Vector3d::operator[](size_t i) {
+        return i == 0 ? x : i == 1 ? y : z;
+    }
+
+    constexpr const double& Vector3d::operator[](size_t i) const {
+        return i == 0 ? x : i == 1 ? y : z;
+    }
+
+    constexpr Vector3d Vector3d::operator-() const {
+        return {-x, -y, -z};
+    }
+
+    constexpr void Vector3d::operator+=(const Vector3d& v) {
+        *this = *this + v;
+    }
+
+    constexpr void Vector3d::operator-=(const Vector3d& v) {
+        *this = *this - v;
+    }
+
+    constexpr Vector3d Vector3d::operator+(const Vector3d& v) const {
+        return {x + v.x, y + v.y, z + v.z};
+    }
+
+    constexpr Vector3d Vector3d::operator-(const Vector3d& v) const {
+        return {x - v.x, y - v.y, z - v.z};
+    }
+
+    constexpr Vector3d Vector3d::operator*(double s) const {
+        return {x * s, y * s, z * s};
+    }
+
+    constexpr bool Vector3d::operator==(const Vector3d& v) const {
+        return x == v.x && y == v.y && z == v.z;
+    }
+
+    constexpr bool Vector3d::operator!=(const Vector3d& v) const {
+        return x != v.x || y != v.y || z != v.z;
+    }
+
+    using vec3d = Vector3d;
+
+} // namespace re
+
+
+#endif //RAVENENGINE_VECTOR3D_HPP
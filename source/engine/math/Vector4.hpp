@@ -4,25 +4,28 @@
 
 #include <string>
 #include <limits>
+#include <type_traits>
+
+#include "Simd.hpp"
 
 
 namespace re {
 
-    class Vector4 {
+    class alignas(16) Vector4 {
     public:
-        inline Vector4();
+        constexpr Vector4();
 
-        inline explicit Vector4(float n);
+        constexpr explicit Vector4(float n);
 
-        inline Vector4(float x, float y, float z, float w);
+        constexpr Vector4(float x, float y, float z, float w);
 
         explicit Vector4(const float* v);
 
         explicit Vector4(const double* v);
 
-        inline Vector4(const Vector4& v);
+        constexpr Vector4(const Vector4& v);
 
-        [[nodiscard]] inline float lengthSqrt() const;
+        [[nodiscard]] constexpr float lengthSqrt() const;
 
         [[nodiscard]] float length() const;
 
@@ -32,47 +35,47 @@ namespace re {
 
         [[nodiscard]] Vector4 normalized() const;
 
-        [[nodiscard]] inline float dot(const Vector4& v) const;
+        [[nodiscard]] constexpr float dot(const Vector4& v) const;
 
-        inline void inverse();
+        constexpr void inverse();
 
-        [[nodiscard]] inline Vector4 inversed() const;
+        [[nodiscard]] constexpr Vector4 inversed() const;
 
         [[nodiscard]] std::string str() const;
 
-        inline Vector4& operator=(const Vector4&) = default;
+        constexpr Vector4& operator=(const Vector4&) = default;
 
-        inline Vector4& operator=(Vector4&&) = default;
+        constexpr Vector4& operator=(Vector4&&) = default;
 
-        inline float& operator[](size_t i);
+        constexpr float& operator[](size_t i);
 
-        inline const float& operator[](size_t i) const;
+        constexpr const float& operator[](size_t i) const;
 
-        inline Vector4 operator-() const;
+        constexpr Vector4 operator-() const;
 
-        inline void operator+=(const Vector4& v);
+        constexpr void operator+=(const Vector4& v);
 
-        inline void operator-=(const Vector4& v);
+        constexpr void operator-=(const Vector4& v);
 
-        inline void operator*=(float s);
+        constexpr void operator*=(float s);
 
-        inline void operator*=(const Vector4& v);
+        constexpr void operator*=(const Vector4& v);
 
-        inline void operator/=(float s);
+        constexpr void operator/=(float s);
 
-        inline Vector4 operator+(const Vector4& v) const;
+        constexpr Vector4 operator+(const Vector4& v) const;
 
-        inline Vector4 operator-(const Vector4& v) const;
+        constexpr Vector4 operator-(const Vector4& v) const;
 
-        inline Vector4 operator*(float s) const;
+        constexpr Vector4 operator*(float s) const;
 
-        inline Vector4 operator*(const Vector4& v) const;
+        constexpr Vector4 operator*(const Vector4& v) const;
 
-        inline Vector4 operator/(float s) const;
+        constexpr Vector4 operator/(float s) const;
 
-        inline bool operator==(const Vector4& v) const;
+        constexpr bool operator==(const Vector4& v) const;
 
-        inline bool operator!=(const Vector4& v) const;
+        constexpr bool operator!=(const Vector4& v) const;
 
         union {
             struct {
@@ -82,30 +85,27 @@ namespace re {
         };
     };
 
-    Vector4::Vector4() {
+    constexpr Vector4::Vector4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {
 
     }
 
-    Vector4::Vector4(float n) : x(n), y(n), z(n), w(n) {
+    constexpr Vector4::Vector4(float n) : x(n), y(n), z(n), w(n) {
 
     }
 
-    Vector4::Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
+    constexpr Vector4::Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
 
     }
 
-    Vector4::Vector4(const Vector4 &v) {
-        x = v.x;
-        y = v.y;
-        z = v.z;
-        w = v.w;
+    constexpr Vector4::Vector4(const Vector4 &v) : x(v.x), y(v.y), z(v.z), w(v.w) {
+
     }
 
     /**
      *
      * @return Vector length without apply squared root
      */
-    float Vector4::lengthSqrt() const {
+    constexpr float Vector4::lengthSqrt() const {
         return dot(*this);
     }
 
@@ -114,14 +114,19 @@ namespace re {
      * @return Dot product(Scalar product) between this vector and another\n
      * @link https://www.wikiwand.com/en/Dot_product.
      */
-    float Vector4::dot(const Vector4 &v) const {
+    constexpr float Vector4::dot(const Vector4 &v) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            return simd::dot(_mm_load_ps(values), _mm_load_ps(v.values));
+        }
+#endif
         return x * v.x + y * v.y + z * v.z + w * v.w;
     }
 
     /**
      * Turn this vector in its inverse
      */
-    void Vector4::inverse() {
+    constexpr void Vector4::inverse() {
         *this = inversed();
     }
 
@@ -129,71 +134,107 @@ namespace re {
      *
      * @return Inverse of this vector. 1 divided by each component.
      */
-    Vector4 Vector4::inversed() const {
+    constexpr Vector4 Vector4::inversed() const {
         return {-x, -y, -z, -w};
     }
 
-    float &Vector4::operator[](size_t i) {
+    constexpr float &Vector4::operator[](size_t i) {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+
         return values[i];
     }
 
-    const float &Vector4::operator[](size_t i) const {
+    constexpr const float &Vector4::operator[](size_t i) const {
+        // Only the active union member can be read during constant evaluation
+        if (std::is_constant_evaluated())
+            return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+
         return values[i];
     }
 
-    Vector4 Vector4::operator-() const {
+    constexpr Vector4 Vector4::operator-() const {
         return {-x, -y, -z, -w};
     }
 
-    void Vector4::operator+=(const Vector4 &v) {
+    constexpr void Vector4::operator+=(const Vector4 &v) {
         *this = *this + v;
     }
 
-    void Vector4::operator-=(const Vector4 &v) {
+    constexpr void Vector4::operator-=(const Vector4 &v) {
         *this = *this - v;
     }
 
-    void Vector4::operator*=(float s) {
+    constexpr void Vector4::operator*=(float s) {
         *this = *this * s;
     }
 
-    void Vector4::operator*=(const Vector4 &v) {
+    constexpr void Vector4::operator*=(const Vector4 &v) {
         *this = *this * v;
     }
 
-    void Vector4::operator/=(float s) {
+    constexpr void Vector4::operator/=(float s) {
         *this = *this / s;
     }
 
-    Vector4 Vector4::operator+(const Vector4 &v) const {
+    constexpr Vector4 Vector4::operator+(const Vector4 &v) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, _mm_add_ps(_mm_load_ps(values), _mm_load_ps(v.values)));
+            return result;
+        }
+#endif
         return {x + v.x, y + v.y, z + v.z, w + v.w};
     }
 
-    Vector4 Vector4::operator-(const Vector4 &v) const {
+    constexpr Vector4 Vector4::operator-(const Vector4 &v) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, _mm_sub_ps(_mm_load_ps(values), _mm_load_ps(v.values)));
+            return result;
+        }
+#endif
         return {x - v.x, y - v.y, z - v.z, w - v.w};
     }
 
-    Vector4 Vector4::operator*(float s) const {
+    constexpr Vector4 Vector4::operator*(float s) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, _mm_mul_ps(_mm_load_ps(values), _mm_set1_ps(s)));
+            return result;
+        }
+#endif
         return {x * s, y * s, z * s, w * s};
     }
 
-    Vector4 Vector4::operator*(const Vector4 &v) const {
+    constexpr Vector4 Vector4::operator*(const Vector4 &v) const {
+#ifdef RE_SIMD_SSE4
+        if (!std::is_constant_evaluated()) {
+            Vector4 result;
+            _mm_store_ps(result.values, _mm_mul_ps(_mm_load_ps(values), _mm_load_ps(v.values)));
+            return result;
+        }
+#endif
         return {x * v.x, y * v.y, z * v.z, w * v.w};
     }
 
-    Vector4 Vector4::operator/(float s) const {
+    constexpr Vector4 Vector4::operator/(float s) const {
         return {x / s, y / s, z / s, w / s};
     }
 
-    bool Vector4::operator==(const Vector4 &v) const {
+    constexpr bool Vector4::operator==(const Vector4 &v) const {
         return x == v.x && y == v.y && z == v.z && w == v.w;
     }
 
-    bool Vector4::operator!=(const Vector4 &v) const {
-        return x != v.x && y != v.y && z != v.z && w != v.w;
+    constexpr bool Vector4::operator!=(const Vector4 &v) const {
+        return x != v.x || y != v.y || z != v.z || w != v.w;
     }
 
-    inline Vector4 operator*(float s, const Vector4& v) {
+    constexpr Vector4 operator*(float s, const Vector4& v) {
         return v * s;
     }
 
@@ -0,0 +1,130 @@
+#include "CommandRecorder.hpp"
+
+#include "Device.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+#include "engine/core/Utils.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Create one transient command pool per thread and frame in flight
+     * @param device Valid pointer to Device
+     * @param threadCount Threads that record, JobSystem workers plus the main thread
+     * @param framesInFlight Frames in flight, pools of a frame are reused when the frame comes back
+     */
+    CommandRecorder::CommandRecorder(std::shared_ptr<Device> device, uint32_t threadCount, uint32_t framesInFlight)
+            : device(std::move(device)), threadCount(threadCount), pools(threadCount * framesInFlight) {
+        for (auto& threadPool : pools)
+            this->device->createCommandPool(threadPool.pool, this->device->getQueueFamilyIndices().graphics, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    }
+
+    CommandRecorder::~CommandRecorder() {
+        for (auto& threadPool : pools)
+            vkDestroyCommandPool(device->getDevice(), threadPool.pool, nullptr);
+    }
+
+    /**
+     * @brief Reset the pools of frameIndex. The GPU must be done with the frame, Renderer::beginFrame waits its
+     * fence before calling this.
+     * @param frameIndex Current frame in flight index
+     */
+    void CommandRecorder::beginFrame(uint32_t frameIndex_) {
+        frameIndex = frameIndex_;
+
+        for (uint32_t thread = 0; thread < threadCount; ++thread) {
+            ThreadPool& threadPool = pools[frameIndex * threadCount + thread];
+            checkResult(vkResetCommandPool(device->getDevice(), threadPool.pool, 0), "Failed to reset command pool!");
+            threadPool.used = 0;
+        }
+
+        pending.clear();
+    }
+
+    /**
+     * @brief Set the render pass and framebuffer the next command buffers continue
+     * @param renderPass Render pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+     * @param subpass Subpass index
+     * @param framebuffer [Optional] Framebuffer, VK_NULL_HANDLE if unknown
+     * @param extent_ Viewport and scissor size
+     */
+    void CommandRecorder::setTarget(VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer, VkExtent2D extent_) {
+        inheritance.renderPass = renderPass;
+        inheritance.subpass = subpass;
+        inheritance.framebuffer = framebuffer;
+        extent = extent_;
+    }
+
+    /**
+     * @brief Begin a secondary command buffer from the pool of the calling thread. Safe to call from JobSystem
+     * jobs, each thread only touches its own pool. Viewport and scissor aren't inherited from the primary
+     * command buffer, they're set here to the whole target.
+     * @return Command buffer in recording state
+     */
+    VkCommandBuffer CommandRecorder::begin() {
+        uint32_t thread = jobs::getThreadIndex();
+        if (thread >= threadCount)
+            throwEx("CommandRecorder: recording from a thread without command pool");
+
+        ThreadPool& threadPool = pools[frameIndex * threadCount + thread];
+        if (threadPool.used == threadPool.buffers.size()) {
+            VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandPool = threadPool.pool;
+            allocInfo.commandBufferCount = 1;
+
+            VkCommandBuffer commandBuffer;
+            checkResult(vkAllocateCommandBuffers(device->getDevice(), &allocInfo, &commandBuffer),
+                        "Failed to allocate secondary command buffer!");
+            threadPool.buffers.push_back(commandBuffer);
+        }
+
+        VkCommandBuffer commandBuffer = threadPool.buffers[threadPool.used++];
+
+        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritance;
+
+        checkResult(vkBeginCommandBuffer(commandBuffer, &beginInfo), "Failed to begin secondary command buffer!");
+
+        VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+        VkRect2D scissor{{0, 0}, extent};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        return commandBuffer;
+    }
+
+    void CommandRecorder::end(VkCommandBuffer commandBuffer) {
+        checkResult(vkEndCommandBuffer(commandBuffer), "Failed to record secondary command buffer!");
+    }
+
+    /**
+     * @brief Queue a recorded command buffer, they're executed in the order they're submitted. Not thread safe,
+     * call it from the thread that records the primary command buffer once the jobs are done.
+     * @param commandBuffer Command buffer from begin, already ended
+     */
+    void CommandRecorder::submit(VkCommandBuffer commandBuffer) {
+        pending.push_back(commandBuffer);
+    }
+
+    /**
+     * @brief Execute the queued command buffers in primary and clear the queue
+     * @param primary Primary command buffer inside the render pass
+     */
+    void CommandRecorder::execute(VkCommandBuffer primary) {
+        if (!pending.empty())
+            vkCmdExecuteCommands(primary, static_cast<uint32_t>(pending.size()), pending.data());
+
+        pending.clear();
+    }
+
+    /**
+     *
+     * @return Threads with their own command pools, jobs::getThreadIndex() must be below it
+     */
+    uint32_t CommandRecorder::getThreadCount() const {
+        return threadCount;
+    }
+
+} // namespace re
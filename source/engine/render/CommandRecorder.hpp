@@ -0,0 +1,65 @@
+#ifndef RAVENENGINE_COMMANDRECORDER_HPP
+#define RAVENENGINE_COMMANDRECORDER_HPP
+
+
+#include <vector>
+#include <memory>
+
+#include "vulkan/vulkan.h"
+
+#include "engine/core/NonCopyable.hpp"
+
+
+namespace re {
+
+    class Device;
+
+    /**
+     * @brief Secondary command buffers recorded by several threads inside the swap chain render pass. Each
+     * JobSystem thread has its own command pool per frame in flight, so recording needs no locks, and the pools of
+     * a frame are reset at once when the frame begins. Recorded buffers are queued in submit order and executed by
+     * the primary command buffer at the end of the render pass.
+     */
+    class CommandRecorder : NonCopyable {
+    public:
+        CommandRecorder(std::shared_ptr<Device> device, uint32_t threadCount, uint32_t framesInFlight);
+
+        ~CommandRecorder() override;
+
+        void beginFrame(uint32_t frameIndex);
+
+        void setTarget(VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer, VkExtent2D extent);
+
+        VkCommandBuffer begin();
+
+        void end(VkCommandBuffer commandBuffer);
+
+        void submit(VkCommandBuffer commandBuffer);
+
+        void execute(VkCommandBuffer primary);
+
+        [[nodiscard]] uint32_t getThreadCount() const;
+
+    private:
+        // Command pool of one thread in one frame, and the buffers allocated from it, reused every frame
+        struct ThreadPool {
+            VkCommandPool pool{};
+            std::vector<VkCommandBuffer> buffers;
+            uint32_t used{};
+        };
+
+    private:
+        std::shared_ptr<Device> device;
+        uint32_t threadCount;
+        uint32_t frameIndex{};
+        // Frame major, threadCount pools per frame in flight
+        std::vector<ThreadPool> pools;
+        VkCommandBufferInheritanceInfo inheritance{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+        VkExtent2D extent{};
+        std::vector<VkCommandBuffer> pending;
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_COMMANDRECORDER_HPP
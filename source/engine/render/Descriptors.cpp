@@ -1,6 +1,7 @@
 #include "Descriptors.hpp"
 
 #include <cassert>
+#include <algorithm>
 
 #include "engine/core/Utils.hpp"
 
@@ -127,7 +128,13 @@ namespace re::Descriptors {
 
     }
 
-    Manager::~Manager() = default;
+    Manager::~Manager() {
+        for (auto& [key, layout] : pipelineLayouts)
+            vkDestroyPipelineLayout(device, layout, nullptr);
+
+        for (auto& [key, layout] : setLayouts)
+            vkDestroyDescriptorSetLayout(device, layout, nullptr);
+    }
 
     Manager *Manager::instance() {
         return singleton;
@@ -142,4 +149,73 @@ namespace re::Descriptors {
         return *pool;
     }
 
+    /**
+     * @brief Get a descriptor set layout with the given bindings. Layouts are deduplicated, so pipelines with the
+     * same set interface share the same layout.
+     * @param bindings Set bindings. Immutable samplers are not supported.
+     * @return Vulkan descriptor set layout owned by Manager
+     */
+    VkDescriptorSetLayout Manager::getSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings) {
+        std::sort(bindings.begin(), bindings.end(), [](const auto& a, const auto& b){
+            return a.binding < b.binding;
+        });
+
+        std::string key;
+        for (auto& binding : bindings) {
+            binding.pImmutableSamplers = nullptr;
+            key.append(reinterpret_cast<const char*>(&binding.binding), sizeof(binding.binding));
+            key.append(reinterpret_cast<const char*>(&binding.descriptorType), sizeof(binding.descriptorType));
+            key.append(reinterpret_cast<const char*>(&binding.descriptorCount), sizeof(binding.descriptorCount));
+            key.append(reinterpret_cast<const char*>(&binding.stageFlags), sizeof(binding.stageFlags));
+        }
+
+        auto it = setLayouts.find(key);
+        if (it != setLayouts.end()) return it->second;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        VkDescriptorSetLayout layout;
+        checkResult(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout),
+                    "Failed to create descriptor set layout!");
+
+        setLayouts[key] = layout;
+        return layout;
+    }
+
+    /**
+     * @brief Get a pipeline layout with the given set layouts and push constant ranges. Layouts are deduplicated.
+     * @param setLayouts Descriptor set layouts ordered by set index
+     * @param pushConstants Push constant ranges
+     * @return Vulkan pipeline layout owned by Manager
+     */
+    VkPipelineLayout Manager::getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts_, const std::vector<VkPushConstantRange>& pushConstants) {
+        std::string key;
+        for (auto& setLayout : setLayouts_)
+            key.append(reinterpret_cast<const char*>(&setLayout), sizeof(setLayout));
+
+        for (auto& range : pushConstants) {
+            key.append(reinterpret_cast<const char*>(&range.stageFlags), sizeof(range.stageFlags));
+            key.append(reinterpret_cast<const char*>(&range.offset), sizeof(range.offset));
+            key.append(reinterpret_cast<const char*>(&range.size), sizeof(range.size));
+        }
+
+        auto it = pipelineLayouts.find(key);
+        if (it != pipelineLayouts.end()) return it->second;
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts_.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts_.data();
+        pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstants.size());
+        pipelineLayoutInfo.pPushConstantRanges = pushConstants.data();
+
+        VkPipelineLayout layout;
+        checkResult(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout),
+                    "Failed to create pipeline layout!");
+
+        pipelineLayouts[key] = layout;
+        return layout;
+    }
+
 } // namespace re::Descriptors
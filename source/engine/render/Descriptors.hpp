@@ -5,6 +5,7 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <string>
 
 #include "vulkan/vulkan.h"
 
@@ -87,10 +88,16 @@ namespace re {
 
             Pool& getPool();
 
+            VkDescriptorSetLayout getSetLayout(std::vector<VkDescriptorSetLayoutBinding> bindings);
+
+            VkPipelineLayout getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<VkPushConstantRange>& pushConstants);
+
         private:
             static Manager* singleton;
             VkDevice device;
             std::unique_ptr<Pool> pool;
+            std::unordered_map<std::string, VkDescriptorSetLayout> setLayouts;
+            std::unordered_map<std::string, VkPipelineLayout> pipelineLayouts;
         };
 
     } // namespace Descriptors
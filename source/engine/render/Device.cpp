@@ -1,9 +1,15 @@
 #include "Device.hpp"
 
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
 #include "Instance.hpp"
 #include "engine/render/buffers/Buffer.hpp"
 #include "Image.hpp"
 #include "engine/core/Utils.hpp"
+#include "engine/files/FilesManager.hpp"
+#include "engine/logs/Logs.hpp"
 
 
 namespace re {
@@ -18,6 +24,20 @@ namespace re {
     Device::Device(const std::shared_ptr<Instance>& instance, const std::vector<const char*>& extensions, VkPhysicalDeviceFeatures features,
                    VkSurfaceKHR surface) : instance(instance), surface(surface) {
         physicalDevice = instance->pickPhysicalDevice(extensions);
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        // Optional features are dropped if unsupported, users check getEnabledFeatures()
+        VkPhysicalDeviceFeatures supportedFeatures;
+        vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+        if (features.multiDrawIndirect && !supportedFeatures.multiDrawIndirect) {
+            log::warn("multiDrawIndirect is not supported by the device");
+            features.multiDrawIndirect = VK_FALSE;
+        }
+        if (features.drawIndirectFirstInstance && !supportedFeatures.drawIndirectFirstInstance) {
+            log::warn("drawIndirectFirstInstance is not supported by the device");
+            features.drawIndirectFirstInstance = VK_FALSE;
+        }
+        enabledFeatures = features;
 
         createLogicalDevice(extensions, features);
 
@@ -30,7 +50,7 @@ namespace re {
 
         for (auto& index : indices) {
             if (queues.find(index) == queues.end()) {
-                if (index == queueFamilyIndices.graphics) {
+                if (index == queueFamilyIndices.graphics && queueCounts[index] > 1) {
                     vkGetDeviceQueue(device, index, 1, &queues[index]);
                 } else {
                     vkGetDeviceQueue(device, index, 0, &queues[index]);
@@ -42,10 +62,15 @@ namespace re {
         }
 
         createAllocator(instance);
+        createPipelineCache();
     }
 
     Device::~Device() {
-        vkDestroySurfaceKHR(instance->getInstance(), surface, nullptr);
+        savePipelineCache();
+        vkDestroyPipelineCache(device, pipelineCache, nullptr);
+
+        // Headless devices have no surface
+        if (surface) vkDestroySurfaceKHR(instance->getInstance(), surface, nullptr);
         vmaDestroyAllocator(allocator);
 
         for (auto& [index, commandPool] : commandPools) {
@@ -191,16 +216,17 @@ namespace re {
      * @brief Copy buffer data to other buffer
      * @param src Source buffer
      * @param dst Destination buffer
-     * @param size Valid buffer size(both buffers should have same size)
+     * @param size Size of the copied range
+     * @param dstOffset [Optional] Offset of the range in the destination buffer
      */
-    void Device::copyBuffer(Buffer &src, Buffer &dst, VkDeviceSize size) {
+    void Device::copyBuffer(Buffer &src, Buffer &dst, VkDeviceSize size, VkDeviceSize dstOffset) {
         VkQueue queue = getQueue(static_cast<int32_t>(queueFamilyIndices.transfer));
         VkCommandPool commandPool = getCommandPool(static_cast<int32_t>(queueFamilyIndices.transfer));
         VkCommandBuffer commandBuffer = beginSingleTimeCommands(commandPool);
 
         VkBufferCopy copyRegion{};
         copyRegion.srcOffset = 0;
-        copyRegion.dstOffset = 0;
+        copyRegion.dstOffset = dstOffset;
         copyRegion.size = size;
         vkCmdCopyBuffer(commandBuffer, src.getBuffer(), dst.getBuffer(), 1, &copyRegion);
 
@@ -325,6 +351,22 @@ namespace re {
         return surface;
     }
 
+    /**
+     *
+     * @return Properties of the physical device, queried once at creation
+     */
+    const VkPhysicalDeviceProperties& Device::getProperties() const {
+        return properties;
+    }
+
+    /**
+     *
+     * @return Features enabled in the logical device
+     */
+    const VkPhysicalDeviceFeatures& Device::getEnabledFeatures() const {
+        return enabledFeatures;
+    }
+
     /**
      *
      * @param index [Optional] Specific queue family index
@@ -343,53 +385,55 @@ namespace re {
         return commandPools[index > -1 ? index : queueFamilyIndices.graphics];
     }
 
+    /**
+     *
+     * @return Pipeline cache shared by all the pipelines created with this Device
+     */
+    VkPipelineCache Device::getPipelineCache() const {
+        return pipelineCache;
+    }
+
+    /**
+     *
+     * @return True if the pipeline cache was loaded from disk, false if it was created empty
+     */
+    bool Device::isPipelineCacheWarm() const {
+        return pipelineCacheWarm;
+    }
+
     void Device::createLogicalDevice(const std::vector<const char *>& extensions, VkPhysicalDeviceFeatures features) {
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos{};
 
         queueFamilyIndices.graphics = getQueueFamilyIndex(VK_QUEUE_GRAPHICS_BIT);
         queueFamilyIndices.present = getQueueFamilyIndex(VK_QUEUE_GRAPHICS_BIT, surface);
 
-        {
-            if (queueFamilyIndices.graphics == queueFamilyIndices.present) {
-                // TODO: Create 1:1 queue per thread?
-                const float priorityQueues[] = {DEFAULT_QUEUE_PRIORITY, DEFAULT_QUEUE_PRIORITY};
-                VkDeviceQueueCreateInfo createInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-                createInfo.queueFamilyIndex = queueFamilyIndices.graphics;
-                createInfo.queueCount = 2;
-                createInfo.pQueuePriorities = priorityQueues;
-                queueCreateInfos.push_back(createInfo);
-            } else {
-                VkDeviceQueueCreateInfo createInfoGraphics{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-                createInfoGraphics.queueFamilyIndex = queueFamilyIndices.graphics;
-                createInfoGraphics.queueCount = 1;
-                createInfoGraphics.pQueuePriorities = &DEFAULT_QUEUE_PRIORITY;
-                queueCreateInfos.push_back(createInfoGraphics);
-
-                VkDeviceQueueCreateInfo createInfoPresent{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-                createInfoPresent.queueFamilyIndex = queueFamilyIndices.present;
-                createInfoPresent.queueCount = 1;
-                createInfoPresent.pQueuePriorities = &DEFAULT_QUEUE_PRIORITY;
-                queueCreateInfos.push_back(createInfoPresent);
-            }
-        }
-
         // TODO: Is necessary have compute and transfers queues?
-        {
-            queueFamilyIndices.compute = getQueueFamilyIndex(VK_QUEUE_COMPUTE_BIT);
-            VkDeviceQueueCreateInfo computeCreateInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-            computeCreateInfo.queueFamilyIndex = queueFamilyIndices.compute;
-            computeCreateInfo.queueCount = 1;
-            computeCreateInfo.pQueuePriorities = &DEFAULT_QUEUE_PRIORITY;
-            queueCreateInfos.push_back(computeCreateInfo);
-        }
+        queueFamilyIndices.compute = getQueueFamilyIndex(VK_QUEUE_COMPUTE_BIT);
+        queueFamilyIndices.transfer = getQueueFamilyIndex(VK_QUEUE_TRANSFER_BIT);
 
-        {
-            queueFamilyIndices.transfer = getQueueFamilyIndex(VK_QUEUE_TRANSFER_BIT);
-            VkDeviceQueueCreateInfo transferCreateInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
-            transferCreateInfo.queueFamilyIndex = queueFamilyIndices.transfer;
-            transferCreateInfo.queueCount = 1;
-            transferCreateInfo.pQueuePriorities = &DEFAULT_QUEUE_PRIORITY;
-            queueCreateInfos.push_back(transferCreateInfo);
+        // TODO: Create 1:1 queue per thread?
+        queueCounts.clear();
+        for (uint32_t index : {queueFamilyIndices.compute, queueFamilyIndices.transfer, queueFamilyIndices.present, queueFamilyIndices.graphics})
+            queueCounts[index] = 1;
+        if (queueFamilyIndices.graphics == queueFamilyIndices.present)
+            queueCounts[queueFamilyIndices.graphics] = 2;
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> familyProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, familyProperties.data());
+
+        // One create info per family even if it has several roles, with no more queues than the family has.
+        // Software drivers like lavapipe expose a single family with a single queue.
+        const float priorityQueues[] = {DEFAULT_QUEUE_PRIORITY, DEFAULT_QUEUE_PRIORITY};
+        for (auto& [index, count] : queueCounts) {
+            count = std::min(count, familyProperties[index].queueCount);
+
+            VkDeviceQueueCreateInfo createInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+            createInfo.queueFamilyIndex = index;
+            createInfo.queueCount = count;
+            createInfo.pQueuePriorities = priorityQueues;
+            queueCreateInfos.push_back(createInfo);
         }
 
         VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
@@ -414,4 +458,94 @@ namespace re {
                     "Failed to create Vulkan Memory Allocator");
     }
 
-} // namespace re
\ No newline at end of file
+    /**
+     * @brief Create the pipeline cache. If exists a cache file from a previous run and its header match with the
+     * current physical device, the cache is created with that data.
+     */
+    void Device::createPipelineCache() {
+        std::filesystem::path path = files::getPath("cache") / PIPELINE_CACHE_FILE;
+        std::vector<char> data;
+
+        if (std::filesystem::exists(path)) {
+            std::ifstream file{path, std::ios::ate | std::ios::binary};
+
+            if (file.is_open()) {
+                data.resize(static_cast<size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(data.data(), static_cast<std::streamsize>(data.size()));
+            }
+
+            if (!isPipelineCacheCompatible(data)) {
+                log::warn(fmt::format("Pipeline cache {} does not match the current device, it will be rebuilt", path.string()));
+                data.clear();
+            }
+        }
+
+        VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+        checkResult(vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache),
+                    "Failed to create pipeline cache");
+
+        pipelineCacheWarm = !data.empty();
+        log::info(fmt::format("Pipeline cache: {} ({} bytes)", pipelineCacheWarm ? "warm" : "cold", data.size()));
+    }
+
+    /**
+     * @brief Write the pipeline cache data to disk. The data is written to a temporary file and then renamed,
+     * so a crash in the middle of the write never leaves a corrupted cache file.
+     */
+    void Device::savePipelineCache() {
+        size_t size = 0;
+        if (vkGetPipelineCacheData(device, pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+
+        std::vector<char> data(size);
+        if (vkGetPipelineCacheData(device, pipelineCache, &size, data.data()) != VK_SUCCESS) return;
+
+        std::filesystem::path path = files::getPath("cache") / PIPELINE_CACHE_FILE;
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+
+            if (!file.is_open()) {
+                log::warn(fmt::format("Failed to write pipeline cache: {}", tempPath.string()));
+                return;
+            }
+
+            file.write(data.data(), static_cast<std::streamsize>(size));
+            if (!file) {
+                log::warn(fmt::format("Failed to write pipeline cache: {}", tempPath.string()));
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+
+        if (error) {
+            log::warn(fmt::format("Failed to replace pipeline cache {}: {}", path.string(), error.message()));
+            std::filesystem::remove(tempPath, error);
+        }
+    }
+
+    /**
+     * @brief Check if pipeline cache data was created by the same driver and GPU
+     * @param data Raw pipeline cache data
+     */
+    bool Device::isPipelineCacheCompatible(const std::vector<char>& data) const {
+        VkPipelineCacheHeaderVersionOne header{};
+        if (data.size() < sizeof(header)) return false;
+
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        return header.headerSize >= sizeof(header) &&
+               header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendorID == properties.vendorID &&
+               header.deviceID == properties.deviceID &&
+               std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+} // namespace re
@@ -42,7 +42,7 @@ namespace re {
 
         void endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQueue queue = VK_NULL_HANDLE, VkCommandPool commandPool = VK_NULL_HANDLE);
 
-        void copyBuffer(Buffer& src, Buffer& dst, VkDeviceSize size);
+        void copyBuffer(Buffer& src, Buffer& dst, VkDeviceSize size, VkDeviceSize dstOffset = 0);
 
         void copyBufferToImage(Buffer& src, Image& dst);
 
@@ -52,6 +52,10 @@ namespace re {
 
         [[nodiscard]] VkPhysicalDevice getPhysicalDevice() const;
 
+        [[nodiscard]] const VkPhysicalDeviceProperties& getProperties() const;
+
+        [[nodiscard]] const VkPhysicalDeviceFeatures& getEnabledFeatures() const;
+
         [[nodiscard]] QueueFamilyIndices getQueueFamilyIndices() const;
 
         [[nodiscard]] VmaAllocator getAllocator() const;
@@ -64,23 +68,41 @@ namespace re {
 
         VkCommandPool getCommandPool(int32_t index = -1);
 
+        [[nodiscard]] VkPipelineCache getPipelineCache() const;
+
+        [[nodiscard]] bool isPipelineCacheWarm() const;
+
     private:
         void createLogicalDevice(const std::vector<const char*>& extensions, VkPhysicalDeviceFeatures features);
 
         void createAllocator(const std::shared_ptr<Instance>& instance_);
 
+        void createPipelineCache();
+
+        void savePipelineCache();
+
+        [[nodiscard]] bool isPipelineCacheCompatible(const std::vector<char>& data) const;
+
     public:
         const float DEFAULT_QUEUE_PRIORITY = 1.0f;
 
+        static constexpr const char* PIPELINE_CACHE_FILE = "pipeline.cache";
+
     private:
         std::shared_ptr<Instance> instance;
         VkSurfaceKHR surface{};
         QueueFamilyIndices queueFamilyIndices{};
         VkDevice device{};
         VkPhysicalDevice physicalDevice{};
+        VkPhysicalDeviceProperties properties{};
+        VkPhysicalDeviceFeatures enabledFeatures{};
         std::unordered_map<uint32_t, VkQueue> queues;
+        // Queues created in each family
+        std::unordered_map<uint32_t, uint32_t> queueCounts;
         std::unordered_map<uint32_t, VkCommandPool> commandPools;
         VmaAllocator allocator{};
+        VkPipelineCache pipelineCache{};
+        bool pipelineCacheWarm{false};
     };
 
 } // namespace re
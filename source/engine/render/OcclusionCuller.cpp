@@ -0,0 +1,272 @@
+#include "OcclusionCuller.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include "engine/assets/Mesh.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+#include "engine/math/Batch.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define RE_OCCLUSION_SSE
+#endif
+
+
+namespace re {
+
+    namespace {
+
+        // Points closer than this in clip w are treated as crossing the near plane
+        constexpr float MIN_CLIP_W = 1e-5f;
+
+        inline bool crossesNear(const Vector4& clip) {
+            return clip.w <= MIN_CLIP_W || clip.z < 0.0f;
+        }
+
+    } // namespace
+
+    OcclusionCuller::OcclusionCuller() = default;
+
+    OcclusionCuller::~OcclusionCuller() = default;
+
+    /**
+     * @brief Start a new frame. Clears the occluders and the depth buffer.
+     * @param viewProj_ Camera projection * view, depth mapped to [0, 1]
+     */
+    void OcclusionCuller::begin(const Matrix4& viewProj_) {
+        viewProj = viewProj_;
+        triangles.clear();
+        hasOccluders = false;
+    }
+
+    /**
+     * @brief Transform the Mesh triangles to screen space and keep them for rasterize. Triangles crossing the near
+     * plane are dropped, which only makes the result more conservative.
+     * @param mesh Occluder Mesh
+     * @param world Mesh world matrix
+     */
+    void OcclusionCuller::addOccluder(const Mesh& mesh, const Matrix4& world) {
+        const auto& indices = mesh.getIndices();
+        Matrix4 worldViewProj = viewProj * world;
+
+        uint32_t vertexCount = mesh.getVertexCount();
+        clipX.resize(vertexCount);
+        clipY.resize(vertexCount);
+        clipZ.resize(vertexCount);
+        clipW.resize(vertexCount);
+        math::transformPoints(worldViewProj, mesh.getPositions(), vertexCount, {clipX.data(), clipY.data(), clipZ.data(), clipW.data()});
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            Vector4 clip[3];
+            for (int v = 0; v < 3; ++v) {
+                uint32_t index = indices[i + v];
+                clip[v] = {clipX[index], clipY[index], clipZ[index], clipW[index]};
+            }
+
+            if (crossesNear(clip[0]) || crossesNear(clip[1]) || crossesNear(clip[2])) continue;
+
+            Triangle triangle{};
+            for (int v = 0; v < 3; ++v) {
+                float invW = 1.0f / clip[v].w;
+                triangle.x[v] = (clip[v].x * invW * 0.5f + 0.5f) * WIDTH;
+                triangle.y[v] = (clip[v].y * invW * 0.5f + 0.5f) * HEIGHT;
+                triangle.z[v] = clip[v].z * invW;
+            }
+
+            // Occluders are two sided, so back facing triangles are flipped to a positive area
+            float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                         (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+            if (std::fabs(area) < 1e-6f) continue;
+            if (area < 0.0f) {
+                std::swap(triangle.x[1], triangle.x[2]);
+                std::swap(triangle.y[1], triangle.y[2]);
+                std::swap(triangle.z[1], triangle.z[2]);
+            }
+
+            triangle.minX = std::max(0, static_cast<int32_t>(std::floor(std::min({triangle.x[0], triangle.x[1], triangle.x[2]}))));
+            triangle.maxX = std::min(static_cast<int32_t>(WIDTH) - 1, static_cast<int32_t>(std::ceil(std::max({triangle.x[0], triangle.x[1], triangle.x[2]}))));
+            triangle.minY = std::max(0, static_cast<int32_t>(std::floor(std::min({triangle.y[0], triangle.y[1], triangle.y[2]}))));
+            triangle.maxY = std::min(static_cast<int32_t>(HEIGHT) - 1, static_cast<int32_t>(std::ceil(std::max({triangle.y[0], triangle.y[1], triangle.y[2]}))));
+            if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) continue;
+
+            triangles.push_back(triangle);
+        }
+
+        hasOccluders = true;
+    }
+
+    /**
+     * @brief Rasterize the occluders and build the hierarchical-Z buffer. The screen is split in bands of
+     * BAND_HEIGHT rows, one job per band, so jobs never write the same pixels.
+     */
+    void OcclusionCuller::rasterize() {
+        if (!hasOccluders) return;
+
+        constexpr uint32_t bandCount = HEIGHT / BAND_HEIGHT;
+        constexpr uint32_t blockRowsPerBand = BAND_HEIGHT / BLOCK_SIZE;
+
+        jobs::parallelFor(bandCount, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t band = begin; band < end; ++band) {
+                rasterizeBand(band * BAND_HEIGHT, (band + 1) * BAND_HEIGHT);
+                buildHiZ(band * blockRowsPerBand, (band + 1) * blockRowsPerBand);
+            }
+        });
+    }
+
+    /**
+     * @brief Conservative visibility test. Boxes crossing the near plane or without occluders in the frame are
+     * always visible.
+     * @param box World space box
+     * @return False if the box is completely behind the occluders
+     */
+    bool OcclusionCuller::isVisible(const AABB& box) const {
+        if (!hasOccluders || box.empty()) return true;
+
+        float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max(), maxY = -std::numeric_limits<float>::max();
+        float minZ = std::numeric_limits<float>::max();
+
+        for (int i = 0; i < 8; ++i) {
+            Vector3 corner{i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z};
+            Vector4 clip = viewProj.transformPoint(corner);
+            if (crossesNear(clip)) return true;
+
+            float invW = 1.0f / clip.w;
+            float x = (clip.x * invW * 0.5f + 0.5f) * WIDTH;
+            float y = (clip.y * invW * 0.5f + 0.5f) * HEIGHT;
+
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            minZ = std::min(minZ, clip.z * invW);
+        }
+
+        // Outside of the screen is left to frustum culling
+        if (maxX < 0.0f || maxY < 0.0f || minX >= WIDTH || minY >= HEIGHT) return true;
+
+        auto blockX0 = static_cast<uint32_t>(std::max(0.0f, minX)) / BLOCK_SIZE;
+        auto blockY0 = static_cast<uint32_t>(std::max(0.0f, minY)) / BLOCK_SIZE;
+        auto blockX1 = std::min(static_cast<uint32_t>(maxX), WIDTH - 1) / BLOCK_SIZE;
+        auto blockY1 = std::min(static_cast<uint32_t>(maxY), HEIGHT - 1) / BLOCK_SIZE;
+
+        for (uint32_t y = blockY0; y <= blockY1; ++y) {
+            for (uint32_t x = blockX0; x <= blockX1; ++x) {
+                if (minZ <= hiZ[y * HIZ_WIDTH + x]) return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     *
+     * @return Number of occluder triangles rasterized this frame
+     */
+    uint32_t OcclusionCuller::getTriangleCount() const {
+        return static_cast<uint32_t>(triangles.size());
+    }
+
+    /**
+     *
+     * @return Depth buffer, WIDTH * HEIGHT floats in rows
+     */
+    const float* OcclusionCuller::getDepth() const {
+        return depth.data();
+    }
+
+    /**
+     * @brief Rasterize every triangle overlapping rows [firstRow, endRow), keeping the nearest depth. Edge
+     * functions and depth are evaluated at pixel centers, four pixels at a time with SSE.
+     */
+    void OcclusionCuller::rasterizeBand(uint32_t firstRow, uint32_t endRow) {
+        std::fill(depth.begin() + firstRow * WIDTH, depth.begin() + endRow * WIDTH, 1.0f);
+
+        for (auto& triangle : triangles) {
+            int32_t minY = std::max(triangle.minY, static_cast<int32_t>(firstRow));
+            int32_t maxY = std::min(triangle.maxY, static_cast<int32_t>(endRow) - 1);
+            if (minY > maxY) continue;
+
+            // Edge i goes from vertex i to vertex i + 1, e(p) = a * p.x + b * p.y + c is positive inside
+            float a[3], b[3], c[3];
+            for (int i = 0; i < 3; ++i) {
+                int j = (i + 1) % 3;
+                a[i] = triangle.y[i] - triangle.y[j];
+                b[i] = triangle.x[j] - triangle.x[i];
+                c[i] = -a[i] * triangle.x[i] - b[i] * triangle.y[i];
+            }
+
+            // Vertex 1 weight is e2 / area and vertex 2 weight is e0 / area
+            float invArea = 1.0f / (a[0] * triangle.x[2] + b[0] * triangle.y[2] + c[0]);
+            float dz1 = (triangle.z[1] - triangle.z[0]) * invArea;
+            float dz2 = (triangle.z[2] - triangle.z[0]) * invArea;
+            float za = a[2] * dz1 + a[0] * dz2;
+            float zb = b[2] * dz1 + b[0] * dz2;
+            float zc = triangle.z[0] + c[2] * dz1 + c[0] * dz2;
+
+            int32_t minX = triangle.minX & ~3;
+
+            for (int32_t y = minY; y <= maxY; ++y) {
+                float py = static_cast<float>(y) + 0.5f;
+                float* row = depth.data() + y * WIDTH;
+
+#ifdef RE_OCCLUSION_SSE
+                const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+                __m128 rowE0 = _mm_set1_ps(b[0] * py + c[0]);
+                __m128 rowE1 = _mm_set1_ps(b[1] * py + c[1]);
+                __m128 rowE2 = _mm_set1_ps(b[2] * py + c[2]);
+                __m128 rowZ = _mm_set1_ps(zb * py + zc);
+
+                for (int32_t x = minX; x <= triangle.maxX; x += 4) {
+                    __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+                    __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), px), rowE0);
+                    __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[1]), px), rowE1);
+                    __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[2]), px), rowE2);
+
+                    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, _mm_setzero_ps()), _mm_cmpge_ps(e1, _mm_setzero_ps())),
+                                               _mm_cmpge_ps(e2, _mm_setzero_ps()));
+                    if (_mm_movemask_ps(inside) == 0) continue;
+
+                    __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(za), px), rowZ);
+                    __m128 current = _mm_load_ps(row + x);
+                    __m128 mask = _mm_and_ps(inside, _mm_cmplt_ps(z, current));
+
+                    _mm_store_ps(row + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, current)));
+                }
+#else
+                for (int32_t x = minX; x <= triangle.maxX; ++x) {
+                    float px = static_cast<float>(x) + 0.5f;
+                    float e0 = a[0] * px + b[0] * py + c[0];
+                    float e1 = a[1] * px + b[1] * py + c[1];
+                    float e2 = a[2] * px + b[2] * py + c[2];
+                    if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f) continue;
+
+                    float z = za * px + zb * py + zc;
+                    if (z < row[x]) row[x] = z;
+                }
+#endif
+            }
+        }
+    }
+
+    /**
+     * @brief Store the farthest depth of each BLOCK_SIZE x BLOCK_SIZE block in block rows [firstBlockRow, endBlockRow)
+     */
+    void OcclusionCuller::buildHiZ(uint32_t firstBlockRow, uint32_t endBlockRow) {
+        for (uint32_t blockY = firstBlockRow; blockY < endBlockRow; ++blockY) {
+            for (uint32_t blockX = 0; blockX < HIZ_WIDTH; ++blockX) {
+                float farthest = 0.0f;
+
+                for (uint32_t y = 0; y < BLOCK_SIZE; ++y) {
+                    const float* row = depth.data() + (blockY * BLOCK_SIZE + y) * WIDTH + blockX * BLOCK_SIZE;
+                    farthest = std::max(farthest, *std::max_element(row, row + BLOCK_SIZE));
+                }
+
+                hiZ[blockY * HIZ_WIDTH + blockX] = farthest;
+            }
+        }
+    }
+
+} // namespace re
@@ -0,0 +1,77 @@
+#ifndef RAVENENGINE_OCCLUSIONCULLER_HPP
+#define RAVENENGINE_OCCLUSIONCULLER_HPP
+
+
+#include <vector>
+#include <array>
+
+#include "engine/core/NonCopyable.hpp"
+#include "engine/math/Matrix4.hpp"
+#include "engine/math/Bounds.hpp"
+
+
+namespace re {
+
+    class Mesh;
+
+    /**
+     * @brief Software occlusion culling. Occluder triangles are rasterized on the CPU into a low resolution
+     * depth buffer and a hierarchical-Z buffer with the farthest depth of each block is built from it. Boxes
+     * whose nearest depth is behind every block they cover are occluded.
+     */
+    class OcclusionCuller : NonCopyable {
+    public:
+        OcclusionCuller();
+
+        ~OcclusionCuller() override;
+
+        void begin(const Matrix4& viewProj);
+
+        void addOccluder(const Mesh& mesh, const Matrix4& world);
+
+        void rasterize();
+
+        [[nodiscard]] bool isVisible(const AABB& box) const;
+
+        [[nodiscard]] uint32_t getTriangleCount() const;
+
+        [[nodiscard]] const float* getDepth() const;
+
+    public:
+        static constexpr uint32_t WIDTH = 256;
+        static constexpr uint32_t HEIGHT = 128;
+        // Rows rasterized by each job
+        static constexpr uint32_t BAND_HEIGHT = 16;
+        static constexpr uint32_t BLOCK_SIZE = 8;
+        static constexpr uint32_t HIZ_WIDTH = WIDTH / BLOCK_SIZE;
+        static constexpr uint32_t HIZ_HEIGHT = HEIGHT / BLOCK_SIZE;
+
+    private:
+        struct Triangle {
+            float x[3];
+            float y[3];
+            float z[3];
+            int32_t minX, maxX, minY, maxY;
+        };
+
+        void rasterizeBand(uint32_t firstRow, uint32_t endRow);
+
+        void buildHiZ(uint32_t firstBlockRow, uint32_t endBlockRow);
+
+    private:
+        Matrix4 viewProj;
+        std::vector<Triangle> triangles;
+        // Occluder vertices in clip space, as structure of arrays
+        std::vector<float> clipX;
+        std::vector<float> clipY;
+        std::vector<float> clipZ;
+        std::vector<float> clipW;
+        alignas(16) std::array<float, WIDTH * HEIGHT> depth{};
+        std::array<float, HIZ_WIDTH * HIZ_HEIGHT> hiZ{};
+        bool hasOccluders{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_OCCLUSIONCULLER_HPP
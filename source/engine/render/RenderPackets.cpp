@@ -0,0 +1,165 @@
+#include "RenderPackets.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "engine/assets/Model.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+
+
+namespace re {
+
+    RenderPackets::RenderPackets() = default;
+
+    RenderPackets::~RenderPackets() = default;
+
+    /**
+     * @brief Write one packet per draw of every object and sort them. Packet offsets come from a prefix sum of
+     * the draw counts, so each job writes its own range and the result doesn't depend on the job order. The
+     * camera relative matrices are computed once per object and the node matrices once per node.
+     * @param objects Visible entities
+     * @param origin Camera position the matrices are relative to
+     */
+    void RenderPackets::extract(const std::vector<Object>& objects, const Vector3d& origin) {
+        auto count = static_cast<uint32_t>(objects.size());
+
+        offsets.resize(count + 1);
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < count; ++i)
+            offsets[i + 1] = offsets[i] + static_cast<uint32_t>(objects[i].model->getDraws().size());
+
+        // Vectors keep their capacity between frames, extraction doesn't allocate once warm
+        packets.resize(offsets[count]);
+        order.resize(offsets[count]);
+
+        jobs::parallelFor(count, CHUNK_SIZE, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                const Model& model = *objects[i].model;
+                const Matrix4 world = objects[i].transform->getRelativeWorldMatrix(origin);
+                const Matrix4 invWorld = objects[i].transform->getRelativeInverseWorldMatrix(origin);
+
+                uint32_t packet = offsets[i];
+                uint32_t node = UINT32_MAX;
+                Matrix4 nodeWorld;
+                Matrix4 invNodeWorld;
+
+                for (auto& draw : model.getDraws()) {
+                    // Draws are grouped by node, primitives of the same node share the matrices
+                    if (draw.node != node) {
+                        node = draw.node;
+                        nodeWorld = world * model.getNodeMatrix(node);
+                        invNodeWorld = model.getNodeInverseMatrix(node) * invWorld;
+                    }
+
+                    // The world matrices are camera relative, the translation is the offset to the camera
+                    const Vector4& offset = nodeWorld[3];
+                    const uint64_t key = RenderPacket::withDepth(draw.sortKey, offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+
+                    packets[packet] = {nodeWorld, invNodeWorld, draw.mesh, draw.material, draw.firstIndex,
+                                       draw.indexCount, draw.vertexOffset, key};
+                    order[packet] = {key, packet};
+                    packet++;
+                }
+            }
+        });
+
+        // The sort is stable, so equal keys keep the object order
+        sort(order, scratch);
+    }
+
+    /**
+     * @brief Least significant digit radix sort of the keys, one byte per pass. The histograms of every byte
+     * are built in a single read, and the passes where every key has the same byte are skipped, which with the
+     * pipeline and material in the high bits usually leaves four to six of the eight passes. Stable, items with
+     * equal keys keep their order.
+     * @param items Items to sort
+     * @param scratch Buffer of the same size for the passes, kept between calls so warm sorts don't allocate
+     */
+    void RenderPackets::sort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+        constexpr uint32_t PASSES = sizeof(uint64_t);
+        const size_t count = items.size();
+        if (count < 2) return;
+
+        std::array<std::array<uint32_t, 256>, PASSES> histograms{};
+        for (auto& item : items) {
+            for (uint32_t pass = 0; pass < PASSES; ++pass)
+                histograms[pass][(item.key >> (pass * 8)) & 0xFF]++;
+        }
+
+        scratch.resize(count);
+        SortItem* src = items.data();
+        SortItem* dst = scratch.data();
+
+        for (uint32_t pass = 0; pass < PASSES; ++pass) {
+            auto& histogram = histograms[pass];
+            const uint32_t shift = pass * 8;
+            if (histogram[(src[0].key >> shift) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+            std::swap(src, dst);
+        }
+
+        if (src != items.data())
+            std::copy(src, src + count, items.data());
+    }
+
+    /**
+     *
+     * @return Packets in object order
+     */
+    const std::vector<RenderPacket>& RenderPackets::getPackets() const {
+        return packets;
+    }
+
+    /**
+     *
+     * @return Packet indices sorted by key
+     */
+    const std::vector<RenderPackets::SortItem>& RenderPackets::getOrder() const {
+        return order;
+    }
+
+    /**
+     *
+     * @return Packet i in key order
+     */
+    const RenderPacket& RenderPackets::operator[](size_t i) const {
+        return packets[order[i].packet];
+    }
+
+    size_t RenderPackets::size() const {
+        return packets.size();
+    }
+
+    /**
+     *
+     * @param first Index in key order
+     * @return Packets from first in key order that draw the same primitive with the same material, the submit
+     * phase draws them as instances of a single draw
+     */
+    uint32_t RenderPackets::runLength(uint32_t first) const {
+        const RenderPacket& packet = (*this)[first];
+
+        auto last = first + 1;
+        while (last < order.size()) {
+            const RenderPacket& next = (*this)[last];
+            if (next.material != packet.material || next.firstIndex != packet.firstIndex || next.indexCount != packet.indexCount ||
+                next.vertexOffset != packet.vertexOffset) break;
+
+            last++;
+        }
+
+        return last - first;
+    }
+
+} // namespace re
@@ -0,0 +1,111 @@
+#ifndef RAVENENGINE_RENDERPACKETS_HPP
+#define RAVENENGINE_RENDERPACKETS_HPP
+
+
+#include <vector>
+#include <cstdint>
+#include <bit>
+
+#include "engine/core/NonCopyable.hpp"
+#include "engine/math/Matrix4.hpp"
+#include "engine/math/Vector3d.hpp"
+
+
+namespace re {
+
+    class Mesh;
+    class Material;
+    class Model;
+    class Transform;
+
+    /**
+     * @brief One primitive of a visible entity, with everything the submit phase needs to draw it
+     */
+    struct RenderPacket {
+        // Entity world matrix relative to the camera times node matrix, and its inverse
+        Matrix4 model;
+        Matrix4 invModel;
+        const Mesh* mesh;
+        const Material* material;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t vertexOffset;
+        uint64_t sortKey;
+
+        /**
+         * @brief 64 bit key, from the high bits: pipeline (4), material (20), mesh (16), primitive (8) and view
+         * depth (16). Sorting groups the draws by the state they bind, the most expensive first, so each pipeline
+         * and material is bound once, and equal primitives end up next to each other and are merged as instances,
+         * nearest first. Ids are truncated to their bit count, collisions only cost extra binds.
+         */
+        static constexpr uint64_t makeSortKey(uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t primitive) {
+            return static_cast<uint64_t>(pipeline & 0xF) << 60 | static_cast<uint64_t>(material & 0xFFFFF) << 40 |
+                   static_cast<uint64_t>(mesh & 0xFFFF) << 24 | static_cast<uint64_t>(primitive & 0xFF) << 16;
+        }
+
+        /**
+         * @brief Replace the depth bits of key. The depth is the top bits of the float, which sort like the
+         * value for positive floats and keep the same relative precision at any distance.
+         * @param key Key from makeSortKey
+         * @param depth Squared distance to the camera
+         */
+        static constexpr uint64_t withDepth(uint64_t key, float depth) {
+            return (key & ~uint64_t{0xFFFF}) | (std::bit_cast<uint32_t>(depth > 0.0f ? depth : 0.0f) >> 15);
+        }
+
+        // Pipeline bits of the models drawn by RenderSystem
+        static constexpr uint32_t MODEL_PIPELINE = 0;
+    };
+
+    /**
+     * @brief Extract phase of the renderer and its render queue. Builds a flat array of render packets from the
+     * visible entities in parallel, reading the Transforms and Models only here, and radix sorts it by key. The
+     * submit phase records commands from the packets alone, and nothing here needs a GPU.
+     */
+    class RenderPackets : NonCopyable {
+    public:
+        struct Object {
+            const Transform* transform;
+            const Model* model;
+        };
+
+        struct SortItem {
+            uint64_t key;
+            uint32_t packet;
+        };
+
+    public:
+        RenderPackets();
+
+        ~RenderPackets() override;
+
+        void extract(const std::vector<Object>& objects, const Vector3d& origin);
+
+        [[nodiscard]] const std::vector<RenderPacket>& getPackets() const;
+
+        [[nodiscard]] const std::vector<SortItem>& getOrder() const;
+
+        [[nodiscard]] const RenderPacket& operator[](size_t i) const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] uint32_t runLength(uint32_t first) const;
+
+        static void sort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+    public:
+        // Objects per job
+        static constexpr uint32_t CHUNK_SIZE = 64;
+
+    private:
+        // First packet of each object, and the packet count at the end
+        std::vector<uint32_t> offsets;
+        std::vector<RenderPacket> packets;
+        std::vector<SortItem> order;
+        std::vector<SortItem> scratch;
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_RENDERPACKETS_HPP
@@ -1,119 +1,526 @@
 #include "RenderSystem.hpp"
 
 #include <utility>
+#include <array>
+#include <chrono>
+#include <algorithm>
 
 #include "Device.hpp"
+#include "SwapChain.hpp"
+#include "Descriptors.hpp"
+#include "OcclusionCuller.hpp"
+#include "CommandRecorder.hpp"
 #include "engine/render/pipelines/GraphicsPipeline.hpp"
 #include "engine/scene/Scene.hpp"
 #include "engine/scene/Skybox.hpp"
 #include "engine/math/Math.hpp"
 #include "engine/assets/AssetsManager.hpp"
 #include "engine/assets/Material.hpp"
-#include "engine/entity/Entity.hpp"
+#include "engine/entity/EntityHandle.hpp"
 #include "engine/render/buffers/UniformBuffer.hpp"
+#include "engine/render/buffers/Buffer.hpp"
+#include "engine/render/buffers/GeometryPool.hpp"
+#include "engine/math/Frustum.hpp"
+#include "engine/core/Utils.hpp"
+#include "engine/logs/Logs.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
 
 
 namespace re {
 
+    static_assert(Material::PUSH_CONSTANTS_SIZE <= RenderSystem::INSTANCE_BASE_OFFSET,
+                  "The material push constants overlap the instance base");
+
+    namespace {
+
+        constexpr uint32_t DESCRIPTOR_SET_CHANGED = 1 << 0;
+        constexpr uint32_t PUSH_CONSTANTS_CHANGED = 1 << 1;
+
+        /**
+         * @brief Material state last recorded in a command buffer, so binding the same descriptor set or pushing
+         * the same constants again is skipped. Materials loaded from different files often share parameters.
+         */
+        struct MaterialState {
+            VkDescriptorSet descriptorSet{VK_NULL_HANDLE};
+            Material::PushConstantBlock pushConstants{};
+            bool pushed{false};
+
+            /**
+             * @brief Make material the current state
+             * @return DESCRIPTOR_SET_CHANGED and PUSH_CONSTANTS_CHANGED bits of the state that has to be recorded
+             */
+            uint32_t set(const Material& material) {
+                uint32_t changed = 0;
+
+                if (material.descriptorSet != descriptorSet) {
+                    descriptorSet = material.descriptorSet;
+                    changed |= DESCRIPTOR_SET_CHANGED;
+                }
+
+                Material::PushConstantBlock block = material.getPushConstants();
+                if (!pushed || block != pushConstants) {
+                    pushConstants = block;
+                    pushed = true;
+                    changed |= PUSH_CONSTANTS_CHANGED;
+                }
+
+                return changed;
+            }
+        };
+
+    } // namespace
+
     // TODO: Refactored RenderSystem class and add doxygen comments
     RenderSystem::RenderSystem(std::shared_ptr<Device> device, VkRenderPass renderPass, const std::string& shadersName)
             : device(std::move(device)) {
-        VkPushConstantRange materialPushConstant{};
-        materialPushConstant.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-        materialPushConstant.size = sizeof(Material::PushConstantBlock);
-
         Pipeline::ConfigInfo configInfo;
         GraphicsPipeline::defaultConfigInfo(configInfo, renderPass);
 
-        setupBuffer();
-        setupDescriptors();
-
         pipeline = std::make_unique<GraphicsPipeline>(
                 this->device->getDevice(),
+                this->device->getPipelineCache(),
                 shadersName + ".vert", shadersName + ".frag",
                 configInfo,
-                std::vector<VkPushConstantRange>{materialPushConstant}
+                std::vector<std::string>{"UboCamera", "UboLight"}
         );
+
+        setupBuffer();
+        setupDescriptors();
+
+        occlusionCuller = std::make_unique<OcclusionCuller>();
     }
 
     RenderSystem::~RenderSystem() = default;
 
-    void RenderSystem::renderScene(VkCommandBuffer commandBuffer, const std::shared_ptr<Scene>& scene) {
+    /**
+     * @brief Render the scene in two phases. extract reads the scene and builds the sorted render packets,
+     * submit records the draw commands from the packets only, in secondary command buffers.
+     * @param recorder Recorder of the current render pass
+     * @param scene Scene to render
+     * @param frameIndex Current frame in flight index
+     */
+    void RenderSystem::renderScene(CommandRecorder& recorder, const std::shared_ptr<Scene>& scene, uint32_t frameIndex) {
+        stats = {};
+
         if (!camera) camera = scene->getMainCamera();
         if (!light) light = scene->getEntity("Light");
 
-        auto& cameraComponent = camera->getComponent<Camera>();
-        mat4 viewProj = cameraComponent.projection * cameraComponent.view;
-
-        if (scene->skybox)
-            scene->skybox->draw(commandBuffer, cameraComponent.projection, Matrix4{1.0f});
+        extract(scene);
+        submit(recorder, scene, frameIndex);
+    }
 
-        pipeline->bind(commandBuffer);
+    /**
+     * @brief Extract phase: camera and light data, culling, and one render packet per primitive of every visible
+     * entity, built in parallel. No Vulkan call is made here.
+     * Everything sent to the GPU is relative to the camera: the view has no translation and the world matrices and
+     * light position have the camera position subtracted in double, so far from the world origin the float
+     * matrices keep their precision. Culling works on the float world bounds with the absolute view.
+     * @param scene Scene to render
+     */
+    void RenderSystem::extract(const std::shared_ptr<Scene>& scene) {
+        auto& cameraComponent = camera.getComponent<Camera>();
+        const Vector3d& origin = cameraComponent.origin;
+        uboCamera.viewProj = cameraComponent.projection * cameraComponent.relativeView;
 
         if (light) {
-            auto& lightComponent = light->getComponent<Light>();
-            auto& transform = light->getComponent<Transform>();
-            uboLight.position = transform.position;
+            auto& lightComponent = light.getComponent<Light>();
+            auto& transform = light.getComponent<Transform>();
+            uboLight.position = (transform.getWorldPosition() - origin).toVector3();
             uboLight.color = lightComponent.color;
             uboLight.ambient = lightComponent.ambient;
-            uboLight.viewPosition = camera->getComponent<Transform>().position;
-            uboLightBuffer->writeTo(&uboLight);
+            uboLight.viewPosition = vec3(0.0f);
+        }
+
+        cullEntities(scene, cameraComponent.projection * cameraComponent.view);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        objects.clear();
+        for (auto& item : visibleItems)
+            objects.push_back({item.transform, item.meshRender->model});
+
+        packets.extract(objects, origin);
+        stats.packets = static_cast<uint32_t>(packets.size());
+
+        stats.extractTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        countUnsortedStateChanges();
+    }
+
+    /**
+     * @brief Submit phase: runs of sorted packets with the same primitive and material become one instanced
+     * VkDrawIndexedIndirectCommand, their instance data is written to the region of the instance buffer owned by
+     * frameIndex. The commands are then split in slices of at least SLICE_DRAWS, one per recording thread at
+     * most, and each slice is recorded by a job in a secondary command buffer. Slices are submitted to the
+     * recorder in order, so the result doesn't depend on which thread recorded what.
+     * @param recorder Recorder of the current render pass
+     * @param scene Scene to render
+     * @param frameIndex Current frame in flight index
+     */
+    void RenderSystem::submit(CommandRecorder& recorder, const std::shared_ptr<Scene>& scene, uint32_t frameIndex) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        uboCameraBuffer->writeToIndex(&uboCamera, static_cast<int>(frameIndex));
+        uboLightBuffer->writeToIndex(&uboLight, static_cast<int>(frameIndex));
+
+        buildDrawCommands(frameIndex);
+
+        auto* commands = static_cast<VkDrawIndexedIndirectCommand*>(indirectBuffer->getMapped()) + frameIndex * MAX_DRAWS;
+        for (size_t i = 0; i < draws.size(); ++i)
+            commands[i] = draws[i].command;
+
+        // No-op on host coherent memory
+        uboCameraBuffer->flushIndex(static_cast<int>(frameIndex));
+        uboLightBuffer->flushIndex(static_cast<int>(frameIndex));
+        instanceBuffer->flush(stats.instances * sizeof(Instance), frameIndex * MAX_INSTANCES * sizeof(Instance));
+        indirectBuffer->flush(draws.size() * sizeof(VkDrawIndexedIndirectCommand), frameIndex * MAX_DRAWS * sizeof(VkDrawIndexedIndirectCommand));
+
+        auto sliceCount = static_cast<uint32_t>(std::clamp<size_t>((draws.size() + SLICE_DRAWS - 1) / SLICE_DRAWS, 1, recorder.getThreadCount()));
+        slices.assign(sliceCount, {});
+
+        const Matrix4& projection = camera.getComponent<Camera>().projection;
+        jobs::parallelFor(sliceCount, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                Slice& slice = slices[i];
+                slice.commandBuffer = recorder.begin();
+
+                if (i == 0 && scene->skybox)
+                    scene->skybox->draw(slice.commandBuffer, projection, Matrix4{1.0f});
+
+                recordDraws(slice.commandBuffer, frameIndex, draws.size() * i / sliceCount, draws.size() * (i + 1) / sliceCount,
+                            slice.stateChanges, slice.drawCalls);
+                recorder.end(slice.commandBuffer);
+            }
+        });
+
+        for (auto& slice : slices) {
+            recorder.submit(slice.commandBuffer);
+
+            stats.stateChanges.pipelines += slice.stateChanges.pipelines;
+            stats.stateChanges.vertexBuffers += slice.stateChanges.vertexBuffers;
+            stats.stateChanges.descriptorSets += slice.stateChanges.descriptorSets;
+            stats.stateChanges.pushConstants += slice.stateChanges.pushConstants;
+            stats.drawCalls += slice.drawCalls;
+        }
+        stats.commandBuffers = sliceCount;
+
+        stats.recordTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Record the indirect commands [first, last) from the geometry pool buffers. Secondary command buffers
+     * inherit no state, so the pipeline, geometry and set 0 are bound here, then each material run is submitted
+     * with a single vkCmdDrawIndexedIndirect. The material descriptor set and push constants are only recorded
+     * when they differ from the previous run. Called from jobs, only reads the RenderSystem.
+     * @param commandBuffer Secondary command buffer in recording state
+     * @param frameIndex Current frame in flight index
+     * @param first First indirect command
+     * @param last End of the indirect commands
+     * @param changes State changes recorded
+     * @param drawCalls Draw calls recorded
+     */
+    void RenderSystem::recordDraws(VkCommandBuffer commandBuffer, uint32_t frameIndex, size_t first, size_t last,
+                                   StateChanges& changes, uint32_t& drawCalls) const {
+        pipeline->bind(commandBuffer);
+        AssetsManager::getInstance()->getGeometryPool().bind(commandBuffer);
+        changes.pipelines = 1;
+        changes.vertexBuffers = 1;
+
+        // Dynamic offsets are consumed in binding order: UboCamera, UboLight
+        std::array<uint32_t, 2> offsets = {
+                static_cast<uint32_t>(frameIndex * uboCameraBuffer->getAlignmentSize()),
+                static_cast<uint32_t>(frameIndex * uboLightBuffer->getAlignmentSize())
+        };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(),
+                                0, 1, &uboDescriptorSet, static_cast<uint32_t>(offsets.size()), offsets.data());
+
+        // Without drawIndirectFirstInstance firstInstance must be 0, every command is drawn alone after pushing its
+        // instance base. With it the base is in the commands and the pushed base stays 0.
+        bool firstInstance = device->getEnabledFeatures().drawIndirectFirstInstance;
+        if (firstInstance) {
+            uint32_t instanceBase = 0;
+            vkCmdPushConstants(commandBuffer, pipeline->getLayout(), VK_SHADER_STAGE_VERTEX_BIT,
+                               INSTANCE_BASE_OFFSET, sizeof(instanceBase), &instanceBase);
+            changes.pushConstants++;
+        }
+
+        bool multiDraw = device->getEnabledFeatures().multiDrawIndirect && firstInstance;
+        uint32_t maxDrawCount = multiDraw ? device->getProperties().limits.maxDrawIndirectCount : 1;
+        constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+        MaterialState bound;
+
+        while (first < last) {
+            const Material* material = draws[first].material;
+
+            size_t runEnd = first;
+            while (runEnd < last && draws[runEnd].material == material) runEnd++;
+
+            uint32_t changed = bound.set(*material);
+            if (changed & DESCRIPTOR_SET_CHANGED) {
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getLayout(),
+                                        1, 1, &bound.descriptorSet, 0, nullptr);
+                changes.descriptorSets++;
+            }
+            if (changed & PUSH_CONSTANTS_CHANGED) {
+                vkCmdPushConstants(commandBuffer, pipeline->getLayout(), VK_SHADER_STAGE_FRAGMENT_BIT,
+                                   0, Material::PUSH_CONSTANTS_SIZE, &bound.pushConstants);
+                changes.pushConstants++;
+            }
+
+            for (size_t i = first; i < runEnd;) {
+                auto drawCount = static_cast<uint32_t>(std::min<size_t>(runEnd - i, maxDrawCount));
+                VkDeviceSize offset = (frameIndex * MAX_DRAWS + i) * stride;
+
+                if (!firstInstance) {
+                    vkCmdPushConstants(commandBuffer, pipeline->getLayout(), VK_SHADER_STAGE_VERTEX_BIT,
+                                       INSTANCE_BASE_OFFSET, sizeof(uint32_t), &draws[i].instanceBase);
+                    changes.pushConstants++;
+                }
+
+                vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer->getBuffer(), offset, drawCount, stride);
+                drawCalls++;
+                i += drawCount;
+            }
+
+            first = runEnd;
         }
+    }
 
-        std::vector<VkDescriptorSet> sets = {uboDescriptorSet};
-        vkCmdBindDescriptorSets(commandBuffer,
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                pipeline->getLayout(), 0, static_cast<uint32_t>(sets.size()), sets.data(),
-                                0, nullptr);
+    /**
+     * @brief Refresh the scene bounds and collect the visible entities. The scene spatial index returns the
+     * entities whose fat boxes touch the frustum, and their exact world bounds are tested afterwards. Visible
+     * occluders are then rasterized by the occlusion culler and the other entities are tested against it.
+     * @param scene Scene to cull
+     * @param viewProj Camera projection * view
+     */
+    void RenderSystem::cullEntities(const std::shared_ptr<Scene>& scene, const Matrix4& viewProj) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto& registry = scene->getRegistry();
+        Frustum frustum(viewProj);
 
-        for (auto& id : scene->getRegistry().view<Transform, MeshRender>()) {
-            auto entity = scene->getEntity(id);
-            auto& meshRender = entity->getComponent<MeshRender>();
+        scene->updateBounds();
 
-            if (meshRender.enable) {
-                auto& transform = entity->getComponent<Transform>();
+        candidates.clear();
+        scene->getSpatialIndex().query(frustum, [&](id_t id) {
+            candidates.add(id, registry.get<WorldBounds>(id).sphere);
+            return true;
+        });
 
-                mat4 transformMatrix = transform.worldMatrix();
-                uboTransform.mvp = viewProj * transformMatrix;
-                uboTransform.invTransform = transformMatrix.inverted();
+        // Spheres of the candidates are tested together, the boxes only for the spheres that pass
+        auto candidateCount = static_cast<uint32_t>(candidates.ids.size());
+        candidates.visible.resize(candidateCount);
+        uint32_t visibleSpheres = math::cullSpheres(frustum, candidates.spheres(), candidateCount, candidates.visible.data());
 
-                meshRender.model->render(commandBuffer, pipeline->getLayout(), uboNode);
-                updateBuffer();
+        visibleItems.clear();
+        for (uint32_t i = 0; i < visibleSpheres; ++i) {
+            id_t id = candidates.ids[candidates.visible[i]];
+            auto& bounds = registry.get<WorldBounds>(id);
+
+            if (frustum.intersects(bounds.box))
+                visibleItems.push_back({&registry.get<Transform>(id), &registry.get<MeshRender>(id), &bounds});
+        }
+
+        stats.culled = static_cast<uint32_t>(scene->getSpatialIndex().size() - visibleItems.size());
+
+        occlusionCuller->begin(viewProj);
+        for (auto& item : visibleItems) {
+            if (!item.meshRender->occluder) continue;
+
+            const Matrix4& world = item.transform->getWorldMatrix();
+            for (auto& node : item.meshRender->model->getNodes()) {
+                if (node.mesh) occlusionCuller->addOccluder(*node.mesh, world * item.meshRender->model->getNodeMatrix(node.index));
             }
         }
+        occlusionCuller->rasterize();
+
+        auto occluded = std::remove_if(visibleItems.begin(), visibleItems.end(), [this](const VisibleItem& item) {
+            return !item.meshRender->occluder && !occlusionCuller->isVisible(item.bounds->box);
+        });
+
+        stats.occluded = static_cast<uint32_t>(std::distance(occluded, visibleItems.end()));
+        stats.occluderTriangles = occlusionCuller->getTriangleCount();
+        visibleItems.erase(occluded, visibleItems.end());
+        stats.visible = static_cast<uint32_t>(visibleItems.size());
+
+        stats.cullTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
     }
 
-    std::shared_ptr<Entity> RenderSystem::getCamera() {
-        return camera;
+    /**
+     * @brief Merge runs of sorted packets that draw the same primitive with the same material into one indirect
+     * command, and write their instance data contiguously. The instance base goes in firstInstance only when
+     * drawIndirectFirstInstance is enabled, otherwise recordDraws pushes it.
+     * @param frameIndex Current frame in flight index
+     */
+    void RenderSystem::buildDrawCommands(uint32_t frameIndex) {
+        draws.clear();
+
+        bool firstInstance = device->getEnabledFeatures().drawIndirectFirstInstance;
+        auto* instances = static_cast<Instance*>(instanceBuffer->getMapped()) + frameIndex * MAX_INSTANCES;
+        uint32_t instanceCount = 0;
+        auto packetCount = static_cast<uint32_t>(packets.size());
+
+        for (uint32_t first = 0; first < packetCount;) {
+            const RenderPacket& packet = packets[first];
+
+            uint32_t count = packets.runLength(first);
+            if (instanceCount + count > MAX_INSTANCES || draws.size() == MAX_DRAWS) {
+                if (!overflowWarned)
+                    log::warn(fmt::format("RenderSystem: frame exceeds {} instances or {} draws, extra draws are skipped", MAX_INSTANCES, MAX_DRAWS));
+                overflowWarned = true;
+                break;
+            }
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const RenderPacket& instance = packets[first + i];
+                instances[instanceCount + i] = {instance.model, instance.invModel};
+            }
+
+            VkDrawIndexedIndirectCommand command{};
+            command.indexCount = packet.indexCount;
+            command.instanceCount = count;
+            command.firstIndex = packet.firstIndex;
+            command.vertexOffset = packet.vertexOffset;
+            uint32_t instanceBase = frameIndex * MAX_INSTANCES + instanceCount;
+            command.firstInstance = firstInstance ? instanceBase : 0;
+            draws.push_back({packet.material, command, instanceBase});
+
+            instanceCount += count;
+            first += count;
+        }
+
+        stats.instances = instanceCount;
+        stats.indirectCommands = static_cast<uint32_t>(draws.size());
+    }
+
+    /**
+     * @brief State changes the packets would need without the render queue: drawn in extraction order, with the
+     * geometry bound per mesh like Mesh::bind and the redundant material state still skipped. Only reads the
+     * packets, compared against stats.stateChanges to see what the sort saves.
+     */
+    void RenderSystem::countUnsortedStateChanges() {
+        StateChanges& changes = stats.unsortedStateChanges;
+        changes = {};
+        if (packets.size() == 0) return;
+
+        changes.pipelines = 1;
+
+        MaterialState bound;
+        const Mesh* mesh = nullptr;
+        const Material* material = nullptr;
+
+        for (auto& packet : packets.getPackets()) {
+            if (packet.mesh != mesh || changes.vertexBuffers == 0) {
+                mesh = packet.mesh;
+                changes.vertexBuffers++;
+            }
+
+            if (packet.material == material) continue;
+            material = packet.material;
+
+            uint32_t changed = bound.set(*material);
+            if (changed & DESCRIPTOR_SET_CHANGED) changes.descriptorSets++;
+            if (changed & PUSH_CONSTANTS_CHANGED) changes.pushConstants++;
+        }
+    }
+
+    const RenderSystem::Stats& RenderSystem::getStats() const {
+        return stats;
     }
 
     void RenderSystem::update(float aspect) {
         if (camera) {
-            auto& cameraComponent = camera->getComponent<Camera>();
+            auto& cameraComponent = camera.getComponent<Camera>();
             cameraComponent.setPerspective(aspect);
         }
     }
 
-    // TODO: Change how uniform buffer are used by RenderSystem
+    /**
+     * @brief Create the per frame buffers. The indirect buffer has MAX_DRAWS commands and the instance buffer
+     * MAX_INSTANCES instances per frame in flight, camera and light rings one slot per frame in flight.
+     */
     void RenderSystem::setupBuffer() {
-        uboTransformBuffer = std::make_unique<UniformBuffer>(
+        VkDeviceSize alignment = device->getProperties().limits.minUniformBufferOffsetAlignment;
+        uint32_t framesInFlight = SwapChain::MAX_FRAMES_IN_FLIGHT;
+
+        uboCameraBuffer = std::make_unique<UniformBuffer>(
                 device->getAllocator(),
-                sizeof(Transform::Ubo)
+                sizeof(CameraUbo),
+                framesInFlight,
+                alignment
         );
-        uboNodeBuffer = std::make_unique<UniformBuffer>(
+        uboLightBuffer = std::make_unique<UniformBuffer>(
                 device->getAllocator(),
-                sizeof(Model::Ubo)
+                sizeof(Light::Ubo),
+                framesInFlight,
+                alignment
         );
-        uboLightBuffer = std::make_unique<UniformBuffer>(
+
+        instanceBuffer = std::make_unique<Buffer>(
                 device->getAllocator(),
-                sizeof(Light::Ubo)
+                sizeof(Instance) * framesInFlight * MAX_INSTANCES,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VMA_MEMORY_USAGE_CPU_TO_GPU
         );
+        instanceBuffer->map();
+
+        indirectBuffer = std::make_unique<Buffer>(
+                device->getAllocator(),
+                sizeof(VkDrawIndexedIndirectCommand) * framesInFlight * MAX_DRAWS,
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                VMA_MEMORY_USAGE_CPU_TO_GPU
+        );
+        indirectBuffer->map();
+    }
+
+    /**
+     * @brief Allocate set 0, point its dynamic bindings at the first slot of each ring and the instance binding
+     * at the whole instance buffer
+     */
+    void RenderSystem::setupDescriptors() {
+        if (!DescriptorsManager::instance()->getPool().allocateDescriptor(pipeline->getSetLayout(0), uboDescriptorSet))
+            throwEx("Failed to allocate RenderSystem descriptor set");
+
+        std::array<VkDescriptorBufferInfo, 3> bufferInfos = {
+                uboCameraBuffer->descriptorInfoForIndex(0),
+                instanceBuffer->descriptorInfo(),
+                uboLightBuffer->descriptorInfoForIndex(0)
+        };
+
+        std::array<VkWriteDescriptorSet, 3> writes{};
+        for (uint32_t i = 0; i < writes.size(); ++i) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = uboDescriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = i == INSTANCE_BINDING ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+
+        vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    uint32_t RenderSystem::StateChanges::total() const {
+        return pipelines + vertexBuffers + descriptorSets + pushConstants;
+    }
+
+    void RenderSystem::CullCandidates::clear() {
+        ids.clear();
+        centerX.clear();
+        centerY.clear();
+        centerZ.clear();
+        radius.clear();
+    }
+
+    void RenderSystem::CullCandidates::add(id_t id, const Sphere& sphere) {
+        ids.push_back(id);
+        centerX.push_back(sphere.center.x);
+        centerY.push_back(sphere.center.y);
+        centerZ.push_back(sphere.center.z);
+        radius.push_back(sphere.radius);
     }
 
-    // TODO: Remove this
-    void RenderSystem::updateBuffer() {
-        uboTransformBuffer->writeTo(&uboTransform);
-        uboNodeBuffer->writeTo(&uboNode);
+    math::SphereArrays RenderSystem::CullCandidates::spheres() const {
+        return {centerX.data(), centerY.data(), centerZ.data(), radius.data()};
     }
 
 } // namespace re
\ No newline at end of file
@@ -11,7 +11,11 @@
 #include "engine/entity/components/Camera.hpp"
 #include "engine/entity/components/Transform.hpp"
 #include "engine/entity/components/MeshRender.hpp"
+#include "engine/entity/EntityHandle.hpp"
 #include "engine/entity/components/Light.hpp"
+#include "engine/entity/components/WorldBounds.hpp"
+#include "engine/math/Batch.hpp"
+#include "engine/render/RenderPackets.hpp"
 
 
 namespace re {
@@ -19,41 +23,151 @@ namespace re {
     class Device;
     class GraphicsPipeline;
     class Scene;
-    class Entity;
     class AssetsManager;
     class UniformBuffer;
+    class Buffer;
+    class Material;
+    class OcclusionCuller;
+    class CommandRecorder;
 
     class RenderSystem : NonCopyable {
+    public:
+        struct CameraUbo {
+            mat4 viewProj;
+        };
+
+        // Per draw instance data read by model.vert through instanceBase + gl_InstanceIndex
+        struct Instance {
+            mat4 model;
+            mat4 invModel;
+        };
+
+        struct IndirectDraw {
+            const Material* material;
+            VkDrawIndexedIndirectCommand command;
+            // First instance in the instance buffer, in command.firstInstance when drawIndirectFirstInstance is enabled
+            uint32_t instanceBase;
+        };
+
+        struct VisibleItem {
+            const Transform* transform;
+            const MeshRender* meshRender;
+            const WorldBounds* bounds;
+        };
+
+        // Entities returned by the spatial index with their bounding spheres as structure of arrays
+        struct CullCandidates {
+            std::vector<id_t> ids;
+            std::vector<float> centerX;
+            std::vector<float> centerY;
+            std::vector<float> centerZ;
+            std::vector<float> radius;
+            std::vector<uint32_t> visible;
+
+            void clear();
+
+            void add(id_t id, const Sphere& sphere);
+
+            [[nodiscard]] math::SphereArrays spheres() const;
+        };
+
+        // State set in the command buffer by the model draws of a frame
+        struct StateChanges {
+            uint32_t pipelines{};
+            uint32_t vertexBuffers{};
+            uint32_t descriptorSets{};
+            uint32_t pushConstants{};
+
+            [[nodiscard]] uint32_t total() const;
+        };
+
+        struct Stats {
+            uint32_t drawCalls{};
+            uint32_t commandBuffers{};
+            uint32_t indirectCommands{};
+            uint32_t packets{};
+            uint32_t instances{};
+            uint32_t visible{};
+            uint32_t culled{};
+            uint32_t occluded{};
+            uint32_t occluderTriangles{};
+            StateChanges stateChanges;
+            // State changes of the same packets drawn in extraction order, binding the geometry per mesh
+            StateChanges unsortedStateChanges;
+            float cullTime{};
+            float extractTime{};
+            float recordTime{};
+        };
+
     public:
         RenderSystem(std::shared_ptr<Device> device, VkRenderPass renderPass, const std::string& shadersName);
 
         ~RenderSystem() override;
 
-        void renderScene(VkCommandBuffer commandBuffer, const std::shared_ptr<Scene>& scene);
+        void renderScene(CommandRecorder& recorder, const std::shared_ptr<Scene>& scene, uint32_t frameIndex);
 
-        std::shared_ptr<Entity> getCamera();
+        EntityHandle getCamera();
 
         void update(float aspect);
 
+        [[nodiscard]] const Stats& getStats() const;
+
+    public:
+        // Per frame in flight capacity of the indirect and instance buffers
+        static constexpr uint32_t MAX_DRAWS = 4096;
+        static constexpr uint32_t MAX_INSTANCES = 16384;
+        static constexpr uint32_t INSTANCE_BINDING = 1;
+        // Offset of the model.vert instanceBase push constant, after the fragment stage material block
+        static constexpr uint32_t INSTANCE_BASE_OFFSET = 32;
+        // Indirect commands per secondary command buffer at least, smaller slices cost more in jobs than they save
+        static constexpr uint32_t SLICE_DRAWS = 64;
+
     private:
-        // TODO: Remove this. Temporally uboBuffer.
         void setupBuffer();
 
-        void updateBuffer();
+        void setupDescriptors();
+
+        void extract(const std::shared_ptr<Scene>& scene);
+
+        void submit(CommandRecorder& recorder, const std::shared_ptr<Scene>& scene, uint32_t frameIndex);
+
+        void recordDraws(VkCommandBuffer commandBuffer, uint32_t frameIndex, size_t first, size_t last, StateChanges& changes, uint32_t& drawCalls) const;
+
+        void cullEntities(const std::shared_ptr<Scene>& scene, const Matrix4& viewProj);
+
+        void buildDrawCommands(uint32_t frameIndex);
+
+        void countUnsortedStateChanges();
+
+    private:
+        // Secondary command buffer recorded by one job, with its stats summed once the jobs are done
+        struct Slice {
+            VkCommandBuffer commandBuffer;
+            StateChanges stateChanges;
+            uint32_t drawCalls;
+        };
 
     private:
-        std::shared_ptr<Entity> camera;
-        std::shared_ptr<Entity> light;
+        EntityHandle camera;
+        EntityHandle light;
         std::shared_ptr<Device> device;
         std::unique_ptr<GraphicsPipeline> pipeline;
         VkDescriptorSet uboDescriptorSet{};
-        // TODO: Change this
-        std::unique_ptr<UniformBuffer> uboTransformBuffer;
-        std::unique_ptr<UniformBuffer> uboNodeBuffer;
+        std::unique_ptr<UniformBuffer> uboCameraBuffer;
         std::unique_ptr<UniformBuffer> uboLightBuffer;
-        Transform::Ubo uboTransform{};
-        Model::Ubo uboNode{};
+        std::unique_ptr<Buffer> instanceBuffer;
+        std::unique_ptr<Buffer> indirectBuffer;
+        std::vector<IndirectDraw> draws;
+        std::vector<Slice> slices;
+        CullCandidates candidates;
+        std::vector<VisibleItem> visibleItems;
+        std::unique_ptr<OcclusionCuller> occlusionCuller;
+        std::vector<RenderPackets::Object> objects;
+        RenderPackets packets;
+        CameraUbo uboCamera{};
         Light::Ubo uboLight;
+        Stats stats;
+        bool overflowWarned{false};
     };
 
 } // namespace re
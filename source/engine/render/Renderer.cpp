@@ -4,10 +4,12 @@
 #include "Instance.hpp"
 #include "Device.hpp"
 #include "SwapChain.hpp"
+#include "CommandRecorder.hpp"
 #include "ui/ImGuiRender.hpp"
 #include "engine/math/Vector2.hpp"
 #include "engine/core/Utils.hpp"
 #include "engine/config/Config.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
 
 
 namespace re {
@@ -32,6 +34,8 @@ namespace re {
         window->createSurface(instance->getInstance(), &surface);
 
         VkPhysicalDeviceFeatures features{};
+        features.multiDrawIndirect = VK_TRUE;
+        features.drawIndirectFirstInstance = VK_TRUE;
         std::vector<const char*> extensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
         device = std::make_shared<Device>(instance, extensions, features, surface);
         logicalDevice = device->getDevice();
@@ -41,10 +45,15 @@ namespace re {
         swapChain = std::make_unique<SwapChain>(device, window->getExtent());
         createCommandBuffers();
 
+        // Every JobSystem worker and the main thread record secondary command buffers
+        commandRecorder = std::make_unique<CommandRecorder>(device, jobs::JobSystem::getInstance()->getThreadCount() + 1,
+                                                            SwapChain::MAX_FRAMES_IN_FLIGHT);
+
         imgui = std::make_unique<ui::ImGuiRender>(device, *swapChain, window);
     }
 
     Renderer::~Renderer() {
+        commandRecorder.reset();
         freeCommandBuffers();
         vkDestroyCommandPool(logicalDevice, commandPool, nullptr);
     }
@@ -109,6 +118,8 @@ namespace re {
         checkResult(vkBeginCommandBuffer(commandBuffer, &beginInfo),
                     "Failed to begin recording command uboBuffer!");
 
+        commandRecorder->beginFrame(currentFrameIndex);
+
         return commandBuffer;
     }
 
@@ -134,7 +145,8 @@ namespace re {
     }
 
     /**
-     * @brief Begin render pass, set viewport and clear values
+     * @brief Begin render pass and set clear values. The pass contents are secondary command buffers from the
+     * CommandRecorder, which set their own viewport and scissor, and run in endSwapChainRenderPass.
      * @param commandBuffer Current command buffer used to record frame data
      */
     void Renderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
@@ -150,26 +162,17 @@ namespace re {
         renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
         renderPassInfo.pClearValues = clearValues.data();
 
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapChain->getExtent().width);
-        viewport.height = static_cast<float>(swapChain->getExtent().height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        VkRect2D scissor{{0, 0}, swapChain->getExtent()};
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
-        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        commandRecorder->setTarget(renderPassInfo.renderPass, 0, renderPassInfo.framebuffer, swapChain->getExtent());
     }
 
     /**
-     * @brief End render pass
+     * @brief Execute the secondary command buffers submitted to the CommandRecorder and end render pass
      * @param commandBuffer Current command buffer used to record frame data
      */
-    void Renderer::endSwapChainRenderPass(VkCommandBuffer commandBuffer) const {
+    void Renderer::endSwapChainRenderPass(VkCommandBuffer commandBuffer) {
+        commandRecorder->execute(commandBuffer);
         vkCmdEndRenderPass(commandBuffer);
     }
 
@@ -204,11 +207,21 @@ namespace re {
     }
 
     /**
-     *
-     * @param commandBuffer Current command buffer used to record frame data
+     * @brief Record ImGui draw data in a secondary command buffer, executed after the ones submitted before
      */
-    void Renderer::renderImGui(VkCommandBuffer commandBuffer) {
+    void Renderer::renderImGui() {
+        VkCommandBuffer commandBuffer = commandRecorder->begin();
         imgui->render(commandBuffer);
+        commandRecorder->end(commandBuffer);
+        commandRecorder->submit(commandBuffer);
+    }
+
+    /**
+     *
+     * @return Recorder of the secondary command buffers of the swap chain render pass
+     */
+    CommandRecorder& Renderer::getCommandRecorder() const {
+        return *commandRecorder;
     }
 
     /**
@@ -22,6 +22,7 @@ namespace re {
     class Instance;
     class Device;
     class SwapChain;
+    class CommandRecorder;
     class Vector2;
 
     class Renderer : NonCopyable {
@@ -46,7 +47,7 @@ namespace re {
 
         void beginSwapChainRenderPass(VkCommandBuffer commandBuffer);
 
-        void endSwapChainRenderPass(VkCommandBuffer commandBuffer) const;
+        void endSwapChainRenderPass(VkCommandBuffer commandBuffer);
 
         void waitDeviceIde();
 
@@ -56,7 +57,9 @@ namespace re {
 
         void newImGuiFrame();
 
-        void renderImGui(VkCommandBuffer commandBuffer);
+        void renderImGui();
+
+        [[nodiscard]] CommandRecorder& getCommandRecorder() const;
 
         [[nodiscard]] uint32_t getImageCount() const;
 
@@ -80,6 +83,7 @@ namespace re {
 
         VkCommandPool commandPool{};
         std::vector<VkCommandBuffer> commandBuffers;
+        std::unique_ptr<CommandRecorder> commandRecorder;
 
         uint32_t imageIndex{};
         int currentFrameIndex{0};
@@ -56,7 +56,7 @@ namespace re {
         } else {
             char *memOffset = (char *)mapped;
             memOffset += offset;
-            std::memcpy(memOffset, data, size);
+            std::memcpy(memOffset, data, size_);
         }
     }
 
@@ -86,6 +86,14 @@ namespace re {
         return size;
     }
 
+    /**
+     *
+     * @return Pointer to the mapped memory, or nullptr if the buffer isn't mapped
+     */
+    void* Buffer::getMapped() const {
+        return mapped;
+    }
+
     /**
      * @brief Flush a memory range of the buffer to make it visible to the device
      * @note Only required for non-coherent memory
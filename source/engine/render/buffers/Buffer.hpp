@@ -27,6 +27,8 @@ namespace re {
 
         [[nodiscard]] VkDeviceSize getSize() const;
 
+        [[nodiscard]] void* getMapped() const;
+
         void flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 
         void invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
@@ -0,0 +1,90 @@
+#include "GeometryPool.hpp"
+
+#include "Buffer.hpp"
+#include "engine/render/Device.hpp"
+#include "engine/core/Utils.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Allocate pool buffers
+     * @param device Valid pointer to Device
+     * @param vertexStride Size of one vertex
+     * @param maxVertices Vertex capacity
+     * @param maxIndices Index capacity
+     */
+    GeometryPool::GeometryPool(std::shared_ptr<Device> device, VkDeviceSize vertexStride, uint32_t maxVertices, uint32_t maxIndices)
+            : device(std::move(device)), vertexStride(vertexStride), maxVertices(maxVertices), maxIndices(maxIndices) {
+        vertexBuffer = std::make_unique<Buffer>(this->device->getAllocator(), vertexStride * maxVertices,
+                                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+        indexBuffer = std::make_unique<Buffer>(this->device->getAllocator(), sizeof(uint32_t) * maxIndices,
+                                               VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+    }
+
+    GeometryPool::~GeometryPool() = default;
+
+    /**
+     * @brief Suballocate and upload mesh geometry. Uploads are serialized, so meshes can be loaded from jobs.
+     * @param vertices Vertex data, vertexCount * vertexStride bytes
+     * @param vertexCount Number of vertices
+     * @param indices Index data, relative to the first vertex of the mesh
+     * @param indexCount Number of indices
+     * @return Vertex offset and first index of the mesh inside the pool
+     */
+    GeometryPool::Allocation GeometryPool::upload(const void* vertices, uint32_t vertexCount_, const uint32_t* indices, uint32_t indexCount_) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (vertexCount + vertexCount_ > maxVertices || indexCount + indexCount_ > maxIndices)
+            throwEx("GeometryPool is full");
+
+        Allocation allocation{static_cast<int32_t>(vertexCount), indexCount};
+
+        if (vertexCount_ > 0)
+            copy(vertices, vertexStride * vertexCount_, *vertexBuffer, vertexStride * vertexCount, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+
+        if (indexCount_ > 0)
+            copy(indices, sizeof(uint32_t) * indexCount_, *indexBuffer, sizeof(uint32_t) * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+        vertexCount += vertexCount_;
+        indexCount += indexCount_;
+
+        return allocation;
+    }
+
+    /**
+     * @brief Bind pool vertex and index buffers
+     * @param commandBuffer Valid Command buffer in recording state
+     */
+    void GeometryPool::bind(VkCommandBuffer commandBuffer) const {
+        VkBuffer buffers[] = { vertexBuffer->getBuffer() };
+        VkDeviceSize offsets[] = { 0 };
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+        vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    /**
+     *
+     * @return Number of vertices allocated
+     */
+    uint32_t GeometryPool::getVertexCount() const {
+        return vertexCount;
+    }
+
+    /**
+     *
+     * @return Number of indices allocated
+     */
+    uint32_t GeometryPool::getIndexCount() const {
+        return indexCount;
+    }
+
+    void GeometryPool::copy(const void* data, VkDeviceSize size, Buffer& dst, VkDeviceSize dstOffset, VkBufferUsageFlags usage) {
+        Buffer stagingBuffer(device->getAllocator(), size, usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+        stagingBuffer.map();
+        stagingBuffer.writeTo(const_cast<void*>(data));
+
+        device->copyBuffer(stagingBuffer, dst, size, dstOffset);
+    }
+
+} // namespace re
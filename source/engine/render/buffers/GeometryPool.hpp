@@ -0,0 +1,60 @@
+#ifndef RAVENENGINE_GEOMETRYPOOL_HPP
+#define RAVENENGINE_GEOMETRYPOOL_HPP
+
+
+#include <memory>
+#include <mutex>
+
+#include "vulkan/vulkan.h"
+
+#include "engine/core/NonCopyable.hpp"
+
+
+namespace re {
+
+    class Device;
+    class Buffer;
+
+    /**
+     * @brief Device local vertex and index buffers shared by all meshes. Meshes suballocate ranges from them,
+     * so every mesh can be drawn with the same vertex/index buffer binding.
+     */
+    class GeometryPool : NonCopyable {
+    public:
+        struct Allocation {
+            int32_t vertexOffset;
+            uint32_t firstIndex;
+        };
+
+    public:
+        GeometryPool(std::shared_ptr<Device> device, VkDeviceSize vertexStride, uint32_t maxVertices, uint32_t maxIndices);
+
+        ~GeometryPool() override;
+
+        Allocation upload(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+        void bind(VkCommandBuffer commandBuffer) const;
+
+        [[nodiscard]] uint32_t getVertexCount() const;
+
+        [[nodiscard]] uint32_t getIndexCount() const;
+
+    private:
+        void copy(const void* data, VkDeviceSize size, Buffer& dst, VkDeviceSize dstOffset, VkBufferUsageFlags usage);
+
+    private:
+        std::shared_ptr<Device> device;
+        std::unique_ptr<Buffer> vertexBuffer;
+        std::unique_ptr<Buffer> indexBuffer;
+        VkDeviceSize vertexStride;
+        uint32_t maxVertices;
+        uint32_t maxIndices;
+        uint32_t vertexCount{};
+        uint32_t indexCount{};
+        std::mutex mutex;
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_GEOMETRYPOOL_HPP
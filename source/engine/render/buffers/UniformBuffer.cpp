@@ -3,8 +3,19 @@
 
 namespace re {
 
-    UniformBuffer::UniformBuffer(VmaAllocator allocator, VkDeviceSize size, uint32_t instanceCount, VmaMemoryUsage memoryUsage)
-            : Buffer(allocator, size * instanceCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, memoryUsage), instanceCount(instanceCount) {
+    /**
+     * @brief Create a mapped uniform buffer with instanceCount slots. Each slot starts at a multiple of
+     * minOffsetAlignment, so any of them can be bound with a dynamic offset.
+     * @param allocator Vma allocator
+     * @param instanceSize Size of one instance
+     * @param instanceCount Number of instances
+     * @param minOffsetAlignment VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment
+     * @param memoryUsage Vma memory usage
+     */
+    UniformBuffer::UniformBuffer(VmaAllocator allocator, VkDeviceSize instanceSize, uint32_t instanceCount, VkDeviceSize minOffsetAlignment,
+                                 VmaMemoryUsage memoryUsage)
+            : Buffer(allocator, getAlignment(instanceSize, minOffsetAlignment) * instanceCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, memoryUsage),
+              instanceSize(instanceSize), instanceCount(instanceCount), alignmentSize(getAlignment(instanceSize, minOffsetAlignment)) {
         map();
     }
 
@@ -16,7 +27,7 @@ namespace re {
      * @param index Used in offset calculation
      */
     void UniformBuffer::writeToIndex(void *data, int index) {
-        writeTo(data, size, index * alignmentSize);
+        writeTo(data, instanceSize, index * alignmentSize);
     }
 
     /**
@@ -33,7 +44,7 @@ namespace re {
      * @return VkDescriptorBufferInfo for instance at index
      */
     VkDescriptorBufferInfo UniformBuffer::descriptorInfoForIndex(int index) {
-        return descriptorInfo(alignmentSize, index * alignmentSize);
+        return descriptorInfo(instanceSize, index * alignmentSize);
     }
 
     /**
@@ -45,8 +56,29 @@ namespace re {
         invalidate(alignmentSize, index * alignmentSize);
     }
 
-    VkDeviceSize UniformBuffer::getAlignment(VkDeviceSize instanceSize, VkDeviceSize minOffsetAlignment) {
-        return 0;
+    /**
+     *
+     * @return Distance in bytes between two consecutive instances
+     */
+    VkDeviceSize UniformBuffer::getAlignmentSize() const {
+        return alignmentSize;
+    }
+
+    uint32_t UniformBuffer::getInstanceCount() const {
+        return instanceCount;
+    }
+
+    /**
+     * @brief Round instanceSize up to a multiple of minOffsetAlignment
+     * @param instanceSize Size of one instance
+     * @param minOffsetAlignment Required offset alignment. Vulkan guarantees it's a power of two.
+     * @return Aligned instance size
+     */
+    VkDeviceSize UniformBuffer::getAlignment(VkDeviceSize instanceSize_, VkDeviceSize minOffsetAlignment) {
+        if (minOffsetAlignment > 0)
+            return (instanceSize_ + minOffsetAlignment - 1) & ~(minOffsetAlignment - 1);
+
+        return instanceSize_;
     }
 
 } // namespace re
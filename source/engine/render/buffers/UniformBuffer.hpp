@@ -10,7 +10,8 @@ namespace re {
     // TODO: Add Doxygen comments
     class UniformBuffer : public Buffer {
     public:
-        UniformBuffer(VmaAllocator allocator, VkDeviceSize size, uint32_t instanceCount = 1, VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU);
+        UniformBuffer(VmaAllocator allocator, VkDeviceSize instanceSize, uint32_t instanceCount = 1, VkDeviceSize minOffsetAlignment = 1,
+                      VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU);
 
         ~UniformBuffer();
 
@@ -22,9 +23,14 @@ namespace re {
 
         void invalidateIndex(int index);
 
+        [[nodiscard]] VkDeviceSize getAlignmentSize() const;
+
+        [[nodiscard]] uint32_t getInstanceCount() const;
+
     private:
         static VkDeviceSize getAlignment(VkDeviceSize instanceSize, VkDeviceSize minOffsetAlignment);
 
+        VkDeviceSize instanceSize;
         uint32_t instanceCount;
         VkDeviceSize alignmentSize{};
     };
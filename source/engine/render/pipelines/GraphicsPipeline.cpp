@@ -1,7 +1,13 @@
 #include "GraphicsPipeline.hpp"
 
+#include <chrono>
+#include <map>
+#include <algorithm>
+
 #include "engine/assets/Mesh.hpp"
 #include "engine/core/Utils.hpp"
+#include "engine/render/Descriptors.hpp"
+#include "engine/logs/Logs.hpp"
 
 
 // TODO: Refactored Graphics pipeline class and add Doxygen comments
@@ -10,38 +16,137 @@ namespace re  {
     GraphicsPipeline::GraphicsPipeline() = default;
 
     GraphicsPipeline::~GraphicsPipeline() {
-        vkDestroyPipelineLayout(device, layout, nullptr);
+        if (ownsLayout) vkDestroyPipelineLayout(device, layout, nullptr);
         vkDestroyPipeline(device, pipeline, nullptr);
     }
 
-    GraphicsPipeline::GraphicsPipeline(VkDevice device, const std::string& vertName, const std::string& fragName,
+    GraphicsPipeline::GraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache, const std::string& vertName, const std::string& fragName,
                                        const ConfigInfo& configInfo, const std::vector<VkDescriptorSetLayout>& layouts,
-                                       const std::vector<VkPushConstantRange>& constantRanges) : device(device) {
+                                       const std::vector<VkPushConstantRange>& constantRanges) : device(device), setLayouts(layouts) {
         auto vertexShader = std::make_unique<Shader>(device, vertName);
         auto fragmentShader = std::make_unique<Shader>(device, fragName);
 
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+        pipelineLayoutInfo.setLayoutCount = layouts.size();
+        pipelineLayoutInfo.pSetLayouts = layouts.data();
+        pipelineLayoutInfo.pushConstantRangeCount = constantRanges.size();
+        pipelineLayoutInfo.pPushConstantRanges = constantRanges.data();
+
+        checkResult(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout),
+                    "Failed to create pipeline layout!");
+
+        float elapsed = createPipeline(pipelineCache, *vertexShader, *fragmentShader, configInfo);
+        log::info(fmt::format("Pipeline {} - {} created in {:.3f} ms", vertName, fragName, elapsed));
+    }
+
+    /**
+     * @brief Create graphics pipeline with descriptor set layouts and push constant ranges derived from the
+     * shaders reflection data. Layouts are shared through DescriptorsManager, so pipelines with the same
+     * interface share the same layouts.
+     * @param device Vulkan logical device
+     * @param pipelineCache Vulkan pipeline cache
+     * @param vertName Vertex shader file name
+     * @param fragName Fragment shader file name
+     * @param configInfo Fixed function state
+     * @param dynamicBuffers [Optional] Names of the uniform/storage blocks bound with dynamic offsets
+     */
+    GraphicsPipeline::GraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache, const std::string& vertName, const std::string& fragName,
+                                       const ConfigInfo& configInfo, const std::vector<std::string>& dynamicBuffers)
+                                       : device(device), ownsLayout(false) {
+        auto vertexShader = std::make_unique<Shader>(device, vertName);
+        auto fragmentShader = std::make_unique<Shader>(device, fragName);
+
+        // Merge the bindings of both stages, a binding used by both gets both stage flags
+        std::map<uint32_t, std::map<uint32_t, VkDescriptorSetLayoutBinding>> sets;
+        std::vector<VkPushConstantRange> pushConstants;
+
+        for (const Shader* shader : {vertexShader.get(), fragmentShader.get()}) {
+            for (auto& binding : shader->reflection.bindings) {
+                auto& layoutBinding = sets[binding.set][binding.binding];
+                layoutBinding.binding = binding.binding;
+                layoutBinding.descriptorType = binding.type;
+
+                if (std::find(dynamicBuffers.begin(), dynamicBuffers.end(), binding.name) != dynamicBuffers.end()) {
+                    if (binding.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                        layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                    else if (binding.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                        layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                }
+
+                layoutBinding.descriptorCount = binding.count;
+                layoutBinding.stageFlags |= shader->stage;
+            }
+
+            pushConstants.insert(pushConstants.end(), shader->reflection.pushConstants.begin(), shader->reflection.pushConstants.end());
+        }
+
+        // Sets not used by any stage still need a layout, so set indices stay valid
+        uint32_t setCount = sets.empty() ? 0 : sets.rbegin()->first + 1;
+        setLayouts.resize(setCount);
+
+        for (uint32_t set = 0; set < setCount; ++set) {
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            for (auto& [index, binding] : sets[set]) bindings.push_back(binding);
+
+            setLayouts[set] = DescriptorsManager::instance()->getSetLayout(bindings);
+        }
+
+        layout = DescriptorsManager::instance()->getPipelineLayout(setLayouts, pushConstants);
+
+        float elapsed = createPipeline(pipelineCache, *vertexShader, *fragmentShader, configInfo);
+        log::info(fmt::format("Pipeline {} - {} created in {:.3f} ms", vertName, fragName, elapsed));
+    }
+
+    void GraphicsPipeline::bind(VkCommandBuffer const &commandBuffer) const {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    }
+
+    VkPipeline const &GraphicsPipeline::getPipeline() const {
+        return pipeline;
+    }
+
+    VkPipelineLayout const &GraphicsPipeline::getLayout() const {
+        return layout;
+    }
+
+    VkDescriptorSetLayout GraphicsPipeline::getSetLayout(uint32_t set) const {
+        return set < setLayouts.size() ? setLayouts[set] : VK_NULL_HANDLE;
+    }
+
+    /**
+     * @brief Create the Vulkan pipeline. Vertex attributes not consumed by the vertex shader are dropped.
+     * @param pipelineCache Vulkan pipeline cache
+     * @param vertexShader Vertex shader
+     * @param fragmentShader Fragment shader
+     * @param configInfo Fixed function state
+     * @return Time spent in vkCreateGraphicsPipelines in milliseconds
+     */
+    float GraphicsPipeline::createPipeline(VkPipelineCache pipelineCache, const Shader& vertexShader, const Shader& fragmentShader,
+                                          const ConfigInfo& configInfo) {
         VkPipelineShaderStageCreateInfo shaderStages[2] = {
-                vertexShader->getPipelineStageCreateInfo(),
-                fragmentShader->getPipelineStageCreateInfo()
+                vertexShader.getPipelineStageCreateInfo(),
+                fragmentShader.getPipelineStageCreateInfo()
+        };
+
+        const auto& inputs = vertexShader.reflection.inputs;
+        auto hasInput = [&inputs](uint32_t location) {
+            return std::any_of(inputs.begin(), inputs.end(), [location](auto& input){ return input.location == location; });
         };
 
         auto bindingDescriptions = Mesh::Vertex::getBindingDescriptions();
-        auto attributeDescriptions = Mesh::Vertex::getAttributeDescriptions();
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+        for (auto& attribute : Mesh::Vertex::getAttributeDescriptions())
+            if (hasInput(attribute.location)) attributeDescriptions.push_back(attribute);
+
+        if (attributeDescriptions.size() < inputs.size())
+            log::warn("Vertex shader consumes inputs that Mesh::Vertex doesn't provide");
+
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
         vertexInputInfo.vertexAttributeDescriptionCount = attributeDescriptions.size();
         vertexInputInfo.vertexBindingDescriptionCount = bindingDescriptions.size();
         vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
         vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
-        pipelineLayoutInfo.setLayoutCount = layouts.size();
-        pipelineLayoutInfo.pSetLayouts = layouts.data();
-        pipelineLayoutInfo.pushConstantRangeCount = constantRanges.size();
-        pipelineLayoutInfo.pPushConstantRanges = constantRanges.data();
-
-        checkResult(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout),
-                    "Failed to create pipeline layout!");
-
         VkGraphicsPipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
         pipelineInfo.stageCount = 2;
         pipelineInfo.pStages = shaderStages;
@@ -59,20 +164,12 @@ namespace re  {
         pipelineInfo.basePipelineIndex = -1;
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-        checkResult(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline),
-                    "Failed to create graphics pipeline");
-    }
-
-    void GraphicsPipeline::bind(VkCommandBuffer const &commandBuffer) const {
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-    }
+        auto start = std::chrono::high_resolution_clock::now();
 
-    VkPipeline const &GraphicsPipeline::getPipeline() const {
-        return pipeline;
-    }
+        checkResult(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline),
+                    "Failed to create graphics pipeline");
 
-    VkPipelineLayout const &GraphicsPipeline::getLayout() const {
-        return layout;
+        return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
     }
 
     void GraphicsPipeline::defaultConfigInfo(Pipeline::ConfigInfo &configInfo, VkRenderPass renderPass) {
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "Pipeline.hpp"
 #include "Shader.hpp"
@@ -20,10 +21,13 @@ namespace re {
     public:
         GraphicsPipeline();
 
-        GraphicsPipeline(VkDevice device, const std::string& vertName, const std::string& fragName,
+        GraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache, const std::string& vertName, const std::string& fragName,
                          const ConfigInfo& configInfo, const std::vector<VkDescriptorSetLayout>& layouts,
                          const std::vector<VkPushConstantRange>& constantRanges);
 
+        GraphicsPipeline(VkDevice device, VkPipelineCache pipelineCache, const std::string& vertName, const std::string& fragName,
+                         const ConfigInfo& configInfo, const std::vector<std::string>& dynamicBuffers = {});
+
         ~GraphicsPipeline() override;
 
         void bind(VkCommandBuffer const &commandBuffer) const override;
@@ -32,12 +36,20 @@ namespace re {
 
         [[nodiscard]] VkPipelineLayout const &getLayout() const override;
 
+        [[nodiscard]] VkDescriptorSetLayout getSetLayout(uint32_t set) const;
+
         static void defaultConfigInfo(ConfigInfo& configInfo, VkRenderPass renderPass);
 
+    private:
+        float createPipeline(VkPipelineCache pipelineCache, const Shader& vertexShader, const Shader& fragmentShader,
+                             const ConfigInfo& configInfo);
+
     private:
         VkDevice device{};
         VkPipeline pipeline{};
         VkPipelineLayout layout{};
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        bool ownsLayout{true};
     };
 
 } // namespace re
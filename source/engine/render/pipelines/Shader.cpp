@@ -1,5 +1,7 @@
 #include "Shader.hpp"
 
+#include <fstream>
+
 #include "spirv_glsl.hpp"
 
 #include "engine/core/Utils.hpp"
@@ -10,6 +12,53 @@
 
 namespace re {
 
+    namespace {
+
+        // FNV-1a over the SPIR-V bytes. File::readBytes returns one element per byte of the file,
+        // so code.size() is the size in bytes of the binary.
+        uint64_t hashCode(const std::vector<uint32_t>& code) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(code.data());
+            uint64_t hash = 0xcbf29ce484222325;
+
+            for (size_t i = 0; i < code.size(); ++i) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3;
+            }
+
+            return hash;
+        }
+
+        VkFormat getVertexFormat(const spirv_cross::SPIRType& type) {
+            static const VkFormat floatFormats[] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+            static const VkFormat intFormats[] = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+            static const VkFormat uintFormats[] = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+
+            if (type.vecsize < 1 || type.vecsize > 4) return VK_FORMAT_UNDEFINED;
+
+            switch (type.basetype) {
+                case spirv_cross::SPIRType::Float:
+                    return floatFormats[type.vecsize - 1];
+                case spirv_cross::SPIRType::Int:
+                    return intFormats[type.vecsize - 1];
+                case spirv_cross::SPIRType::UInt:
+                    return uintFormats[type.vecsize - 1];
+                default:
+                    return VK_FORMAT_UNDEFINED;
+            }
+        }
+
+        template<typename T>
+        void writeValue(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool readValue(std::ifstream& file, T& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+    } // namespace
+
     Shader::Shader(VkDevice device, const std::string& name) : device(device) {
         auto file = files::getPath("shaders") / name;
         stage = Shader::getStage(file.extension().string());
@@ -51,6 +100,10 @@ namespace re {
         return VK_SHADER_STAGE_ALL;
     }
 
+    /**
+     * @brief Compile GLSL shader to SPIR-V and write its reflection data next to the .spv file
+     * @param file GLSL shader file
+     */
     void Shader::compileShader(const std::filesystem::path &file) {
 #ifdef _WIN64
         std::filesystem::path glslValidator = files::getPath("tools") / "glslangValidator.exe";
@@ -59,26 +112,29 @@ namespace re {
 #endif
 
         std::system((glslValidator.string() + " -V " + file.string() + " -o " + (file.string() + ".spv --auto-map-bindings")).c_str());
+
+        std::filesystem::path spvFile = file.string() + ".spv";
+        if (!std::filesystem::exists(spvFile)) return;
+
+        std::vector<uint32_t> code = File(spvFile).readBytes();
+        saveReflection(std::filesystem::path(spvFile).replace_extension(".refl"), hashCode(code),
+                       reflect(code, getStage(file.extension().string())));
     }
 
     void Shader::createShaderModule(const std::filesystem::path& file) {
         std::vector<uint32_t> code = File(file).readBytes();
 
-        spirv_cross::CompilerGLSL glsl(std::vector<uint32_t>(code.data(), code.data() + code.size() / sizeof(uint32_t)));
-        spirv_cross::ShaderResources shaderResources = glsl.get_shader_resources();
+        std::filesystem::path reflectionFile = std::filesystem::path(file).replace_extension(".refl");
+        uint64_t codeHash = hashCode(code);
 
-        for (auto& resource : shaderResources.uniform_buffers) {
-            uint32_t set = glsl.get_decoration(resource.id, spv::DecorationDescriptorSet);
-            uint32_t binding = glsl.get_decoration(resource.id, spv::DecorationBinding);
-            resources[resource.name] = {set, binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER};
+        if (!loadReflection(reflectionFile, codeHash, reflection)) {
+            log::info(fmt::format("Reflection cache for {} is missing or stale, reflecting SPIR-V", file.string()));
+            reflection = reflect(code, stage);
+            saveReflection(reflectionFile, codeHash, reflection);
         }
 
-        for (auto& resource : shaderResources.sampled_images) {
-            uint32_t set = glsl.get_decoration(resource.id, spv::DecorationDescriptorSet);
-            uint32_t binding = glsl.get_decoration(resource.id, spv::DecorationBinding);
-            log::info(fmt::format("Image {} at set = {}, binging = {}", resource.name, set, binding));
-            resources[resource.name] = {set, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER};
-        }
+        for (auto& binding : reflection.bindings)
+            resources[binding.name] = {binding.set, binding.binding, binding.type};
 
         VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
         createInfo.codeSize = code.size();
@@ -88,4 +144,147 @@ namespace re {
                     "Failed to create shader module");
     }
 
-} // namespace re
\ No newline at end of file
+    /**
+     * @brief Extract descriptor bindings, push constant ranges and vertex inputs from SPIR-V
+     * @param code SPIR-V binary as returned by File::readBytes
+     * @param stage Shader stage of the binary
+     * @return Reflection data
+     */
+    Shader::Reflection Shader::reflect(const std::vector<uint32_t>& code, VkShaderStageFlagBits stage) {
+        spirv_cross::CompilerGLSL glsl(std::vector<uint32_t>(code.data(), code.data() + code.size() / sizeof(uint32_t)));
+        spirv_cross::ShaderResources shaderResources = glsl.get_shader_resources();
+
+        Reflection reflection;
+
+        auto addBindings = [&](const spirv_cross::SmallVector<spirv_cross::Resource>& resources, VkDescriptorType type) {
+            for (auto& resource : resources) {
+                const spirv_cross::SPIRType& resourceType = glsl.get_type(resource.type_id);
+
+                Binding binding{};
+                binding.name = resource.name;
+                binding.set = glsl.get_decoration(resource.id, spv::DecorationDescriptorSet);
+                binding.binding = glsl.get_decoration(resource.id, spv::DecorationBinding);
+                binding.type = type;
+                binding.count = resourceType.array.empty() ? 1 : resourceType.array[0];
+                reflection.bindings.push_back(binding);
+            }
+        };
+
+        addBindings(shaderResources.uniform_buffers, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        addBindings(shaderResources.storage_buffers, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        addBindings(shaderResources.sampled_images, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+        addBindings(shaderResources.separate_images, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+        addBindings(shaderResources.separate_samplers, VK_DESCRIPTOR_TYPE_SAMPLER);
+        addBindings(shaderResources.storage_images, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+
+        for (auto& resource : shaderResources.push_constant_buffers) {
+            const spirv_cross::SPIRType& type = glsl.get_type(resource.base_type_id);
+            uint32_t offset = type.member_types.empty() ? 0 : glsl.type_struct_member_offset(type, 0);
+            uint32_t size = static_cast<uint32_t>(glsl.get_declared_struct_size(type));
+
+            reflection.pushConstants.push_back({static_cast<VkShaderStageFlags>(stage), offset, size - offset});
+        }
+
+        if (stage == VK_SHADER_STAGE_VERTEX_BIT) {
+            for (auto& resource : shaderResources.stage_inputs) {
+                if (!glsl.has_decoration(resource.id, spv::DecorationLocation)) continue;
+
+                VertexInput input{};
+                input.location = glsl.get_decoration(resource.id, spv::DecorationLocation);
+                input.format = getVertexFormat(glsl.get_type(resource.type_id));
+                reflection.inputs.push_back(input);
+            }
+        }
+
+        return reflection;
+    }
+
+    /**
+     * @brief Load reflection data written by saveReflection
+     * @param file Reflection file
+     * @param codeHash Hash of the SPIR-V binary. If it doesn't match the stored one the cache is stale.
+     * @param reflection Output reflection data
+     * @return True if the file exists, is valid and is up to date
+     */
+    bool Shader::loadReflection(const std::filesystem::path& file, uint64_t codeHash, Reflection& reflection) {
+        std::ifstream input(file, std::ios::binary);
+        if (!input.is_open()) return false;
+
+        uint32_t magic{}, version{};
+        uint64_t hash{};
+        if (!readValue(input, magic) || !readValue(input, version) || !readValue(input, hash)) return false;
+        if (magic != REFLECTION_MAGIC || version != REFLECTION_VERSION || hash != codeHash) return false;
+
+        Reflection data;
+        uint32_t count{};
+
+        if (!readValue(input, count)) return false;
+        data.bindings.resize(count);
+        for (auto& binding : data.bindings) {
+            uint32_t nameSize{};
+            if (!readValue(input, binding.set) || !readValue(input, binding.binding) || !readValue(input, binding.type) ||
+                !readValue(input, binding.count) || !readValue(input, nameSize)) return false;
+
+            binding.name.resize(nameSize);
+            if (!input.read(binding.name.data(), nameSize)) return false;
+        }
+
+        if (!readValue(input, count)) return false;
+        data.pushConstants.resize(count);
+        for (auto& range : data.pushConstants) {
+            if (!readValue(input, range.stageFlags) || !readValue(input, range.offset) || !readValue(input, range.size)) return false;
+        }
+
+        if (!readValue(input, count)) return false;
+        data.inputs.resize(count);
+        for (auto& vertexInput : data.inputs) {
+            if (!readValue(input, vertexInput.location) || !readValue(input, vertexInput.format)) return false;
+        }
+
+        reflection = std::move(data);
+        return true;
+    }
+
+    /**
+     * @brief Write reflection data in a compact binary form
+     * @param file Reflection file
+     * @param codeHash Hash of the SPIR-V binary the data was extracted from
+     * @param reflection Reflection data
+     */
+    void Shader::saveReflection(const std::filesystem::path& file, uint64_t codeHash, const Reflection& reflection) {
+        std::ofstream output(file, std::ios::binary | std::ios::trunc);
+
+        if (!output.is_open()) {
+            log::warn(fmt::format("Failed to write shader reflection: {}", file.string()));
+            return;
+        }
+
+        writeValue(output, REFLECTION_MAGIC);
+        writeValue(output, REFLECTION_VERSION);
+        writeValue(output, codeHash);
+
+        writeValue(output, static_cast<uint32_t>(reflection.bindings.size()));
+        for (auto& binding : reflection.bindings) {
+            writeValue(output, binding.set);
+            writeValue(output, binding.binding);
+            writeValue(output, binding.type);
+            writeValue(output, binding.count);
+            writeValue(output, static_cast<uint32_t>(binding.name.size()));
+            output.write(binding.name.data(), static_cast<std::streamsize>(binding.name.size()));
+        }
+
+        writeValue(output, static_cast<uint32_t>(reflection.pushConstants.size()));
+        for (auto& range : reflection.pushConstants) {
+            writeValue(output, range.stageFlags);
+            writeValue(output, range.offset);
+            writeValue(output, range.size);
+        }
+
+        writeValue(output, static_cast<uint32_t>(reflection.inputs.size()));
+        for (auto& input : reflection.inputs) {
+            writeValue(output, input.location);
+            writeValue(output, input.format);
+        }
+    }
+
+} // namespace re
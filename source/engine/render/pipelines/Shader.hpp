@@ -25,6 +25,29 @@ namespace re {
             VkDescriptorType type;
         };
 
+        struct Binding {
+            std::string name;
+            uint32_t set;
+            uint32_t binding;
+            VkDescriptorType type;
+            uint32_t count;
+        };
+
+        struct VertexInput {
+            uint32_t location;
+            VkFormat format;
+        };
+
+        /**
+         * @brief Shader interface data extracted from SPIR-V. It's cached next to the .spv file
+         * in a .refl file, so spirv_cross only runs when the shader is compiled or the cache is stale.
+         */
+        struct Reflection {
+            std::vector<Binding> bindings;
+            std::vector<VkPushConstantRange> pushConstants;
+            std::vector<VertexInput> inputs;
+        };
+
         Shader(VkDevice device, const std::string& name);
 
         ~Shader() override;
@@ -37,9 +60,20 @@ namespace re {
 
         void createShaderModule(const std::filesystem::path& file);
 
+        static Reflection reflect(const std::vector<uint32_t>& code, VkShaderStageFlagBits stage);
+
+        static bool loadReflection(const std::filesystem::path& file, uint64_t codeHash, Reflection& reflection);
+
+        static void saveReflection(const std::filesystem::path& file, uint64_t codeHash, const Reflection& reflection);
+
         VkShaderStageFlagBits stage;
         VkShaderModule module{};
         std::unordered_map<std::string, Resource> resources;
+        Reflection reflection;
+
+    public:
+        static constexpr uint32_t REFLECTION_MAGIC = 0x46455252; // "RREF"
+        static constexpr uint32_t REFLECTION_VERSION = 1;
 
     private:
         VkDevice device;
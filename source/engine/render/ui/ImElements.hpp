@@ -11,6 +11,7 @@
 
 #include "engine/math/Vector2.hpp"
 #include "engine/math/Vector3.hpp"
+#include "engine/math/Vector3d.hpp"
 
 
 namespace re::ui {
@@ -56,7 +57,7 @@ namespace re::ui {
         std::vector<char> buffer(size);
         std::copy(text.begin(), text.end(), buffer.begin());
         ImGui::InputText(label.c_str(), buffer.data(), size);
-        return {buffer.data(), size};
+        return {buffer.data()};
     }
 
     inline void imCollapsingHeader(const std::string& label, const Call& call, ImGuiTreeNodeFlags flags = 0) {
@@ -65,8 +66,13 @@ namespace re::ui {
         }
     }
 
-    inline void imInputVec3(const std::string& label, Vector3& vector, const std::string& format = "%.3f", ImGuiInputTextFlags flags = 0) {
-        ImGui::InputFloat3(label.c_str(), vector.values, format.c_str(), flags);
+    inline bool imInputVec3(const std::string& label, Vector3& vector, const std::string& format = "%.3f", ImGuiInputTextFlags flags = 0) {
+        return ImGui::InputFloat3(label.c_str(), vector.values, format.c_str(), flags);
+    }
+
+    inline bool imInputVec3(const std::string& label, Vector3d& vector, const std::string& format = "%.3f", ImGuiInputTextFlags flags = 0) {
+        static_assert(sizeof(Vector3d) == 3 * sizeof(double));
+        return ImGui::InputScalarN(label.c_str(), ImGuiDataType_Double, &vector.x, 3, nullptr, nullptr, format.c_str(), flags);
     }
 
     inline void imPopupContextWindow(const Call& call) {
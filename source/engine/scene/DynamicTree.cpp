@@ -0,0 +1,358 @@
+#include "DynamicTree.hpp"
+
+#include <algorithm>
+
+#include "engine/core/Utils.hpp"
+
+
+namespace re {
+
+    /**
+     *
+     * @param margin Distance added to each side of the boxes stored in the leaves
+     */
+    DynamicTree::DynamicTree(float margin) : margin(margin) {
+
+    }
+
+    /**
+     * @brief Add a new leaf. If the key is already in the tree its box is updated instead.
+     * @param key Entity id
+     * @param box World space box
+     */
+    void DynamicTree::insert(Key key, const AABB& box) {
+        if (leaves.contains(key)) {
+            update(key, box);
+            return;
+        }
+
+        int32_t leaf = allocateNode();
+        nodes[leaf].box = {box.min - Vector3(margin), box.max + Vector3(margin)};
+        nodes[leaf].key = key;
+        nodes[leaf].height = 0;
+
+        insertLeaf(leaf);
+        leaves[key] = leaf;
+    }
+
+    /**
+     *
+     * @param key Entity id. Unknown keys are ignored.
+     */
+    void DynamicTree::remove(Key key) {
+        auto it = leaves.find(key);
+        if (it == leaves.end()) return;
+
+        removeLeaf(it->second);
+        freeNode(it->second);
+        leaves.erase(it);
+    }
+
+    /**
+     * @brief Move a leaf. The tree is only modified when the box leaves the fat box of the leaf.
+     * @param key Entity id
+     * @param box New world space box
+     * @return True if the leaf was reinserted
+     */
+    bool DynamicTree::update(Key key, const AABB& box) {
+        auto it = leaves.find(key);
+        if (it == leaves.end()) {
+            insert(key, box);
+            return true;
+        }
+
+        int32_t leaf = it->second;
+        if (nodes[leaf].box.contains(box)) return false;
+
+        removeLeaf(leaf);
+        nodes[leaf].box = {box.min - Vector3(margin), box.max + Vector3(margin)};
+        insertLeaf(leaf);
+
+        return true;
+    }
+
+    bool DynamicTree::contains(Key key) const {
+        return leaves.contains(key);
+    }
+
+    void DynamicTree::clear() {
+        nodes.clear();
+        leaves.clear();
+        root = NULL_NODE;
+        freeList = NULL_NODE;
+    }
+
+    /**
+     * @brief Call the callback for every leaf whose fat box is inside or intersects the frustum
+     */
+    void DynamicTree::query(const Frustum& frustum, const QueryCallback& callback) const {
+        traverse([&](const AABB& box) { return frustum.intersects(box); }, callback);
+    }
+
+    /**
+     * @brief Call the callback for every leaf whose fat box intersects the sphere
+     */
+    void DynamicTree::query(const Sphere& sphere, const QueryCallback& callback) const {
+        traverse([&](const AABB& box) { return box.intersects(sphere); }, callback);
+    }
+
+    /**
+     * @brief Call the callback for every leaf whose fat box intersects the box
+     */
+    void DynamicTree::query(const AABB& box, const QueryCallback& callback) const {
+        traverse([&](const AABB& nodeBox) { return nodeBox.intersects(box); }, callback);
+    }
+
+    /**
+     * @brief Call the callback for every leaf whose fat box is hit by the ray. Leaves are not sorted by distance.
+     * @param ray Ray with normalized direction
+     * @param maxDistance Max distance along the ray
+     * @param callback Called per hit leaf
+     */
+    void DynamicTree::query(const Ray& ray, float maxDistance, const QueryCallback& callback) const {
+        float distance;
+        traverse([&](const AABB& box) { return box.intersects(ray, maxDistance, distance); }, callback);
+    }
+
+    /**
+     *
+     * @param key Entity id in the tree
+     * @return Box stored in the leaf, including the margin
+     */
+    const AABB& DynamicTree::getFatBox(Key key) const {
+        auto it = leaves.find(key);
+        if (it == leaves.end()) throwEx("DynamicTree: key is not in the tree");
+
+        return nodes[it->second].box;
+    }
+
+    /**
+     *
+     * @return Number of leaves
+     */
+    size_t DynamicTree::size() const {
+        return leaves.size();
+    }
+
+    /**
+     *
+     * @return Height of the root, 0 for a single leaf and -1 for an empty tree
+     */
+    int32_t DynamicTree::getHeight() const {
+        return root == NULL_NODE ? -1 : nodes[root].height;
+    }
+
+    int32_t DynamicTree::allocateNode() {
+        if (freeList == NULL_NODE) {
+            nodes.emplace_back();
+            return static_cast<int32_t>(nodes.size() - 1);
+        }
+
+        int32_t index = freeList;
+        freeList = nodes[index].parent;
+        nodes[index] = {};
+        return index;
+    }
+
+    void DynamicTree::freeNode(int32_t index) {
+        nodes[index] = {};
+        nodes[index].parent = freeList;
+        freeList = index;
+    }
+
+    /**
+     * @brief Find the best sibling with the surface area heuristic, create a new parent for both and walk back
+     * to the root refitting and balancing
+     */
+    void DynamicTree::insertLeaf(int32_t leaf) {
+        if (root == NULL_NODE) {
+            root = leaf;
+            nodes[root].parent = NULL_NODE;
+            return;
+        }
+
+        AABB leafBox = nodes[leaf].box;
+        int32_t index = root;
+
+        while (!nodes[index].isLeaf()) {
+            const Node& node = nodes[index];
+            float area = node.box.surfaceArea();
+
+            AABB combined = node.box;
+            combined.merge(leafBox);
+            float combinedArea = combined.surfaceArea();
+
+            // Cost of creating a new parent for this node and the leaf
+            float cost = 2.0f * combinedArea;
+            // Minimum cost of pushing the leaf further down the tree
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](int32_t child) {
+                AABB box = nodes[child].box;
+                box.merge(leafBox);
+
+                if (nodes[child].isLeaf()) return box.surfaceArea() + inheritanceCost;
+                return box.surfaceArea() - nodes[child].box.surfaceArea() + inheritanceCost;
+            };
+
+            float cost1 = childCost(node.child1);
+            float cost2 = childCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32_t sibling = index;
+        int32_t oldParent = nodes[sibling].parent;
+        int32_t newParent = allocateNode();
+
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].box = leafBox;
+        nodes[newParent].box.merge(nodes[sibling].box);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].child1 = sibling;
+        nodes[newParent].child2 = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent == NULL_NODE) {
+            root = newParent;
+        } else if (nodes[oldParent].child1 == sibling) {
+            nodes[oldParent].child1 = newParent;
+        } else {
+            nodes[oldParent].child2 = newParent;
+        }
+
+        refit(nodes[leaf].parent);
+    }
+
+    /**
+     * @brief Detach the leaf, replace its parent with the sibling and refit the ancestors. The leaf node is
+     * kept allocated.
+     */
+    void DynamicTree::removeLeaf(int32_t leaf) {
+        if (leaf == root) {
+            root = NULL_NODE;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grandParent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grandParent == NULL_NODE) {
+            root = sibling;
+            nodes[sibling].parent = NULL_NODE;
+        } else {
+            if (nodes[grandParent].child1 == parent)
+                nodes[grandParent].child1 = sibling;
+            else
+                nodes[grandParent].child2 = sibling;
+
+            nodes[sibling].parent = grandParent;
+            refit(grandParent);
+        }
+
+        freeNode(parent);
+        nodes[leaf].parent = NULL_NODE;
+    }
+
+    /**
+     * @brief Walk from index to the root balancing each node and recomputing its box and height
+     */
+    void DynamicTree::refit(int32_t index) {
+        while (index != NULL_NODE) {
+            index = balance(index);
+
+            Node& node = nodes[index];
+            node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+            node.box = nodes[node.child1].box;
+            node.box.merge(nodes[node.child2].box);
+
+            index = node.parent;
+        }
+    }
+
+    /**
+     * @brief Rotate the taller child of A up if the children heights differ by more than one
+     * @param indexA Internal node index
+     * @return Index of the node now at the position of A
+     */
+    int32_t DynamicTree::balance(int32_t indexA) {
+        Node& a = nodes[indexA];
+        if (a.isLeaf() || a.height < 2) return indexA;
+
+        int32_t indexB = a.child1;
+        int32_t indexC = a.child2;
+        int32_t difference = nodes[indexC].height - nodes[indexB].height;
+
+        if (difference >= -1 && difference <= 1) return indexA;
+
+        // Rotate the taller child (up) with A (down)
+        int32_t indexUp = difference > 1 ? indexC : indexB;
+        int32_t indexOther = difference > 1 ? indexB : indexC;
+        Node& up = nodes[indexUp];
+
+        int32_t indexF = up.child1;
+        int32_t indexG = up.child2;
+
+        up.child1 = indexA;
+        up.parent = a.parent;
+        a.parent = indexUp;
+
+        if (up.parent == NULL_NODE) {
+            root = indexUp;
+        } else if (nodes[up.parent].child1 == indexA) {
+            nodes[up.parent].child1 = indexUp;
+        } else {
+            nodes[up.parent].child2 = indexUp;
+        }
+
+        // The taller grandchild stays under up, the other one replaces up under A
+        int32_t indexKeep = nodes[indexF].height > nodes[indexG].height ? indexF : indexG;
+        int32_t indexMove = indexKeep == indexF ? indexG : indexF;
+
+        up.child2 = indexKeep;
+        if (difference > 1)
+            a.child2 = indexMove;
+        else
+            a.child1 = indexMove;
+        nodes[indexMove].parent = indexA;
+
+        a.box = nodes[indexOther].box;
+        a.box.merge(nodes[indexMove].box);
+        a.height = 1 + std::max(nodes[indexOther].height, nodes[indexMove].height);
+
+        up.box = a.box;
+        up.box.merge(nodes[indexKeep].box);
+        up.height = 1 + std::max(a.height, nodes[indexKeep].height);
+
+        return indexUp;
+    }
+
+    template<typename Overlap>
+    void DynamicTree::traverse(const Overlap& overlap, const QueryCallback& callback) const {
+        if (root == NULL_NODE) return;
+
+        std::vector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            int32_t index = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[index];
+            if (!overlap(node.box)) continue;
+
+            if (node.isLeaf()) {
+                if (!callback(node.key)) return;
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+} // namespace re
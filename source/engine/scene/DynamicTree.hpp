@@ -0,0 +1,96 @@
+#ifndef RAVENENGINE_DYNAMICTREE_HPP
+#define RAVENENGINE_DYNAMICTREE_HPP
+
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include "entt/entt.hpp"
+
+#include "engine/math/Bounds.hpp"
+#include "engine/math/Frustum.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Dynamic AABB tree keyed by entity. Leaves store fat boxes, so small movements don't touch the tree,
+     * and the tree is kept balanced with rotations on insertion and removal.
+     */
+    class DynamicTree {
+    public:
+        using Key = entt::entity;
+
+        // Return false to stop the query
+        using QueryCallback = std::function<bool(Key)>;
+
+        static constexpr int32_t NULL_NODE = -1;
+
+    public:
+        explicit DynamicTree(float margin = 0.1f);
+
+        void insert(Key key, const AABB& box);
+
+        void remove(Key key);
+
+        bool update(Key key, const AABB& box);
+
+        [[nodiscard]] bool contains(Key key) const;
+
+        void clear();
+
+        void query(const Frustum& frustum, const QueryCallback& callback) const;
+
+        void query(const Sphere& sphere, const QueryCallback& callback) const;
+
+        void query(const AABB& box, const QueryCallback& callback) const;
+
+        void query(const Ray& ray, float maxDistance, const QueryCallback& callback) const;
+
+        [[nodiscard]] const AABB& getFatBox(Key key) const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] int32_t getHeight() const;
+
+    private:
+        struct Node {
+            AABB box;
+            Key key{entt::null};
+            // Parent while in the tree, next free node while in the free list
+            int32_t parent{NULL_NODE};
+            int32_t child1{NULL_NODE};
+            int32_t child2{NULL_NODE};
+            int32_t height{-1};
+
+            [[nodiscard]] inline bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        int32_t allocateNode();
+
+        void freeNode(int32_t index);
+
+        void insertLeaf(int32_t leaf);
+
+        void removeLeaf(int32_t leaf);
+
+        int32_t balance(int32_t index);
+
+        void refit(int32_t index);
+
+        template<typename Overlap>
+        void traverse(const Overlap& overlap, const QueryCallback& callback) const;
+
+    private:
+        std::vector<Node> nodes;
+        std::unordered_map<Key, int32_t> leaves;
+        int32_t root{NULL_NODE};
+        int32_t freeList{NULL_NODE};
+        float margin;
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_DYNAMICTREE_HPP
@@ -0,0 +1,181 @@
+#include "EntityCommands.hpp"
+
+#include <atomic>
+#include <utility>
+#include <algorithm>
+
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+
+
+namespace re {
+
+    /**
+     *
+     * @param buffer Buffer of the calling thread
+     * @param key Sort key of the commands recorded in the scope, like the index of the element processed by a
+     * parallel job
+     */
+    EntityCommandBuffer::SortKey::SortKey(EntityCommandBuffer& buffer, uint64_t key)
+            : buffer(buffer), previous(buffer.setSortKey(key)) {
+
+    }
+
+    EntityCommandBuffer::SortKey::~SortKey() {
+        buffer.setSortKey(previous);
+    }
+
+    EntityCommandBuffer::EntityCommandBuffer() = default;
+
+    EntityCommandBuffer::~EntityCommandBuffer() = default;
+
+    /**
+     *
+     * @return Entity that is created on playback. Only valid as target of this buffer.
+     */
+    EntityCommandBuffer::Pending EntityCommandBuffer::create() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        uint32_t index = createdCount++;
+        commands.push_back({sortKey, [index](entt::registry& registry, std::vector<id_t>& created) {
+            created[index] = registry.create();
+        }});
+
+        return {index};
+    }
+
+    /**
+     * @brief Destroy the target with all its descendants
+     */
+    void EntityCommandBuffer::destroy(Target target) {
+        record([target](entt::registry& registry, std::vector<id_t>& created) {
+            id_t id = resolve(target, registry, created);
+            if (id == entt::null) return;
+
+            // Breadth first, so destroying in reverse order removes every child before its parent
+            std::vector<id_t> subtree{id};
+            for (size_t i = 0; i < subtree.size(); ++i) {
+                auto* hierarchy = registry.try_get<Hierarchy>(subtree[i]);
+                if (!hierarchy) continue;
+
+                for (id_t child = hierarchy->firstChild; child != entt::null; child = registry.get<Hierarchy>(child).nextSibling)
+                    subtree.push_back(child);
+            }
+
+            for (auto it = subtree.rbegin(); it != subtree.rend(); ++it)
+                registry.destroy(*it);
+        });
+    }
+
+    /**
+     *
+     * @return Key the buffer had before
+     */
+    uint64_t EntityCommandBuffer::setSortKey(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::exchange(sortKey, key);
+    }
+
+    void EntityCommandBuffer::record(Apply apply) {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back({sortKey, std::move(apply)});
+    }
+
+    /**
+     *
+     * @return Alive id of the target, null if it was destroyed or its creation isn't played yet
+     */
+    id_t EntityCommandBuffer::resolve(const Target& target, entt::registry& registry, const std::vector<id_t>& created) {
+        id_t id = target.id;
+        if (id == entt::null && target.pending < created.size()) id = created[target.pending];
+
+        return registry.valid(id) ? id : entt::null;
+    }
+
+    EntityCommandQueue::EntityCommandQueue() {
+        static std::atomic<uint64_t> nextId{1};
+        queueId = nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    EntityCommandQueue::~EntityCommandQueue() = default;
+
+    /**
+     * @brief Buffer of the calling thread. The queue lock is only taken the first time a thread asks for it.
+     */
+    EntityCommandBuffer& EntityCommandQueue::getBuffer() {
+        thread_local struct {
+            uint64_t queue;
+            EntityCommandBuffer* buffer;
+        } cache{};
+
+        if (cache.queue == queueId) return *cache.buffer;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto& buffer = threadBuffers[std::this_thread::get_id()];
+        if (!buffer) {
+            buffer = buffers.emplace_back(std::make_unique<EntityCommandBuffer>()).get();
+            buffer->thread = jobs::getThreadIndex();
+        }
+
+        cache = {queueId, buffer};
+        return *buffer;
+    }
+
+    /**
+     * @brief Apply and clear the commands recorded by every thread. Commands recorded while playing, for
+     * example from registry listeners, are kept for the next playback.
+     * @param registry Registry the commands are applied to
+     */
+    void EntityCommandQueue::playback(entt::registry& registry) {
+        order.clear();
+
+        {
+            // Commands are applied without the lock, so listeners can ask for their thread buffer
+            std::lock_guard<std::mutex> lock(mutex);
+            playingBuffers.clear();
+
+            for (auto& buffer : buffers)
+                playingBuffers.push_back(buffer.get());
+        }
+
+        for (uint32_t i = 0; i < playingBuffers.size(); ++i) {
+            auto& buffer = *playingBuffers[i];
+            std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+
+            std::swap(buffer.commands, buffer.playing);
+            buffer.created.assign(buffer.createdCount, entt::null);
+            buffer.createdCount = 0;
+            buffer.sortKey = 0;
+
+            for (uint32_t j = 0; j < buffer.playing.size(); ++j)
+                order.push_back({buffer.playing[j].sortKey, buffer.thread, i, j});
+        }
+
+        std::sort(order.begin(), order.end(), [](const CommandRef& a, const CommandRef& b) {
+            if (a.sortKey != b.sortKey) return a.sortKey < b.sortKey;
+            if (a.thread != b.thread) return a.thread < b.thread;
+            if (a.buffer != b.buffer) return a.buffer < b.buffer;
+            return a.command < b.command;
+        });
+
+        for (auto& ref : order) {
+            auto& buffer = *playingBuffers[ref.buffer];
+            buffer.playing[ref.command].apply(registry, buffer.created);
+        }
+
+        for (auto* buffer : playingBuffers)
+            buffer->playing.clear();
+    }
+
+    /**
+     *
+     * @return Queue attached to the registry context by its Scene, nullptr if there is none. Jobs keep the
+     * returned pointer, so the queue lives until their commands are recorded.
+     */
+    std::shared_ptr<EntityCommandQueue> EntityCommandQueue::find(entt::registry& registry) {
+        auto* queue = registry.try_ctx<std::shared_ptr<EntityCommandQueue>>();
+        return queue ? *queue : nullptr;
+    }
+
+} // namespace re
@@ -0,0 +1,172 @@
+#ifndef RAVENENGINE_ENTITYCOMMANDS_HPP
+#define RAVENENGINE_ENTITYCOMMANDS_HPP
+
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+
+#include "entt/entt.hpp"
+
+#include "engine/core/NonCopyable.hpp"
+#include "engine/entity/EntityHandle.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Structural changes recorded by one thread and applied later by EntityCommandQueue::playback. The
+     * owner thread records without contention, the buffer mutex is only shared with the playback.
+     */
+    class EntityCommandBuffer : NonCopyable {
+        friend class EntityCommandQueue;
+
+    public:
+        // Entity created by this buffer. It gets an id when its create command is played back, so commands
+        // targeting it need the same or a higher sort key.
+        struct Pending {
+            uint32_t index;
+        };
+
+        // Existing entity or entity pending creation in this buffer
+        struct Target {
+            Target(id_t id) : id(id) {}
+
+            Target(Pending pending) : pending(pending.index) {}
+
+            id_t id{entt::null};
+            uint32_t pending{};
+        };
+
+        // Sort key of the commands recorded while it lives, the previous key is restored when it ends
+        class SortKey : NonCopyable {
+        public:
+            SortKey(EntityCommandBuffer& buffer, uint64_t key);
+
+            ~SortKey() override;
+
+        private:
+            EntityCommandBuffer& buffer;
+            uint64_t previous;
+        };
+
+    public:
+        EntityCommandBuffer();
+
+        ~EntityCommandBuffer() override;
+
+        Pending create();
+
+        void destroy(Target target);
+
+        template<typename T, typename ...Args>
+        void addComponent(Target target, Args&& ...args);
+
+        template<typename T>
+        void removeComponent(Target target);
+
+        template<typename T, typename Function>
+        void patch(Target target, Function function);
+
+    private:
+        using Apply = std::function<void(entt::registry&, std::vector<id_t>&)>;
+
+        struct Command {
+            uint64_t sortKey;
+            Apply apply;
+        };
+
+        uint64_t setSortKey(uint64_t key);
+
+        void record(Apply apply);
+
+        static id_t resolve(const Target& target, entt::registry& registry, const std::vector<id_t>& created);
+
+    private:
+        std::mutex mutex;
+        std::vector<Command> commands;
+        std::vector<Command> playing;
+        std::vector<id_t> created;
+        uint32_t createdCount{};
+        uint64_t sortKey{};
+        // JobSystem index of the thread that owns the buffer
+        uint32_t thread{};
+    };
+
+    /**
+     * @brief Collection of per thread EntityCommandBuffers of a registry. Commands are applied at a sync point
+     * sorted by sort key, then by the JobSystem index of the recording thread, and by recording order inside
+     * each buffer. Jobs that give their commands distinct keys, like the index of the element they process,
+     * get the same result whichever worker runs them. Keys shared between workers fall back to thread order,
+     * and threads outside the JobSystem share index 0 and fall back to the order their buffers were created.
+     */
+    class EntityCommandQueue : NonCopyable {
+    public:
+        EntityCommandQueue();
+
+        ~EntityCommandQueue() override;
+
+        EntityCommandBuffer& getBuffer();
+
+        void playback(entt::registry& registry);
+
+        static std::shared_ptr<EntityCommandQueue> find(entt::registry& registry);
+
+    private:
+        struct CommandRef {
+            uint64_t sortKey;
+            uint32_t thread;
+            uint32_t buffer;
+            uint32_t command;
+        };
+
+    private:
+        uint64_t queueId;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<EntityCommandBuffer>> buffers;
+        std::unordered_map<std::thread::id, EntityCommandBuffer*> threadBuffers;
+        std::vector<EntityCommandBuffer*> playingBuffers;
+        std::vector<CommandRef> order;
+    };
+
+    /**
+     * @brief Add T to the target, or replace it if the entity already has one. Arguments are copied and
+     * passed to the constructor with the owner handle last, like EntityHandle::addComponent.
+     */
+    template<typename T, typename ...Args>
+    void EntityCommandBuffer::addComponent(Target target, Args&& ...args) {
+        record([target, ...args = std::forward<Args>(args)](entt::registry& registry, std::vector<id_t>& created) mutable {
+            id_t id = resolve(target, registry, created);
+            if (id == entt::null) return;
+
+            registry.emplace_or_replace<T>(id, args..., EntityHandle(&registry, id));
+        });
+    }
+
+    template<typename T>
+    void EntityCommandBuffer::removeComponent(Target target) {
+        record([target](entt::registry& registry, std::vector<id_t>& created) {
+            id_t id = resolve(target, registry, created);
+            if (id != entt::null) registry.remove<T>(id);
+        });
+    }
+
+    /**
+     * @brief Modify the T of the target through registry::patch, so update listeners are notified. Skipped if
+     * the entity no longer has T.
+     */
+    template<typename T, typename Function>
+    void EntityCommandBuffer::patch(Target target, Function function) {
+        record([target, function](entt::registry& registry, std::vector<id_t>& created) {
+            id_t id = resolve(target, registry, created);
+            if (id != entt::null && registry.all_of<T>(id)) registry.patch<T>(id, function);
+        });
+    }
+
+} // namespace re
+
+
+#endif //RAVENENGINE_ENTITYCOMMANDS_HPP
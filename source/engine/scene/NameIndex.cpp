@@ -0,0 +1,123 @@
+#include "NameIndex.hpp"
+
+#include "engine/entity/components/Name.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+
+
+namespace re {
+
+    NameIndex::NameIndex() = default;
+
+    NameIndex::~NameIndex() = default;
+
+    /**
+     * @brief Index the named entities already in the registry and listen to the Name signals
+     */
+    void NameIndex::connect(entt::registry& registry) {
+        entities.clear();
+
+        for (auto id : registry.view<Name>())
+            onConstruct(registry, id);
+
+        registry.on_construct<Name>().connect<&NameIndex::onConstruct>(this);
+        registry.on_update<Name>().connect<&NameIndex::onUpdate>(this);
+        registry.on_destroy<Name>().connect<&NameIndex::onDestroy>(this);
+    }
+
+    /**
+     *
+     * @param registry Registry connected to the index
+     * @param name Entity name
+     * @return Any entity with that name, null if there is none
+     */
+    entt::entity NameIndex::find(const entt::registry& registry, std::string_view name) const {
+        auto [begin, end] = entities.equal_range(Name::hash(name));
+
+        for (auto it = begin; it != end; ++it) {
+            if (registry.get<Name>(it->second).name == name) return it->second;
+        }
+
+        return entt::null;
+    }
+
+    /**
+     *
+     * @param registry Registry connected to the index
+     * @param parent Parent entity, null to look for a root entity
+     * @param name Child name
+     * @return Direct child of parent with that name, null if there is none
+     */
+    entt::entity NameIndex::findChild(const entt::registry& registry, entt::entity parent, std::string_view name) const {
+        auto [begin, end] = entities.equal_range(Name::hash(name));
+
+        for (auto it = begin; it != end; ++it) {
+            if (registry.get<Name>(it->second).name != name) continue;
+
+            auto* hierarchy = registry.try_get<Hierarchy>(it->second);
+            entt::entity entityParent = hierarchy ? hierarchy->parent : entt::null;
+            if (entityParent == parent) return it->second;
+        }
+
+        return entt::null;
+    }
+
+    /**
+     * @brief Resolve a path like "Root/Arm/Hand". Each step is a hash lookup, so the cost doesn't depend on the
+     * number of entities in the scene nor on the number of children.
+     * @param registry Registry connected to the index
+     * @param path Names from a root entity separated by PATH_SEPARATOR
+     * @return Entity at the end of the path, null if any step is missing
+     */
+    entt::entity NameIndex::findPath(const entt::registry& registry, std::string_view path) const {
+        entt::entity current = entt::null;
+        size_t begin = 0;
+
+        while (true) {
+            size_t end = path.find(PATH_SEPARATOR, begin);
+            std::string_view name = path.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+
+            current = findChild(registry, current, name);
+            if (current == entt::null || end == std::string_view::npos) return current;
+
+            begin = end + 1;
+        }
+    }
+
+    /**
+     *
+     * @return Number of indexed entities
+     */
+    size_t NameIndex::size() const {
+        return entities.size();
+    }
+
+    void NameIndex::onConstruct(entt::registry& registry, entt::entity id) {
+        auto& name = registry.get<Name>(id);
+        name.indexedHash = Name::hash(name.name);
+        entities.emplace(name.indexedHash, id);
+    }
+
+    void NameIndex::onUpdate(entt::registry& registry, entt::entity id) {
+        auto& name = registry.get<Name>(id);
+        erase(name.indexedHash, id);
+
+        name.indexedHash = Name::hash(name.name);
+        entities.emplace(name.indexedHash, id);
+    }
+
+    void NameIndex::onDestroy(entt::registry& registry, entt::entity id) {
+        erase(registry.get<Name>(id).indexedHash, id);
+    }
+
+    void NameIndex::erase(size_t hash, entt::entity id) {
+        auto [begin, end] = entities.equal_range(hash);
+
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == id) {
+                entities.erase(it);
+                return;
+            }
+        }
+    }
+
+} // namespace re
@@ -0,0 +1,57 @@
+#ifndef RAVENENGINE_NAMEINDEX_HPP
+#define RAVENENGINE_NAMEINDEX_HPP
+
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "entt/entt.hpp"
+
+#include "engine/core/NonCopyable.hpp"
+
+
+namespace re {
+
+    class Name;
+
+    /**
+     * @brief Hash index from entity name to entity. It's kept in sync through the registry signals of the Name
+     * component, so adding, renaming with EntityHandle::setName and destroying entities update it.
+     */
+    class NameIndex : NonCopyable {
+    public:
+        NameIndex();
+
+        ~NameIndex() override;
+
+        void connect(entt::registry& registry);
+
+        [[nodiscard]] entt::entity find(const entt::registry& registry, std::string_view name) const;
+
+        [[nodiscard]] entt::entity findChild(const entt::registry& registry, entt::entity parent, std::string_view name) const;
+
+        [[nodiscard]] entt::entity findPath(const entt::registry& registry, std::string_view path) const;
+
+        [[nodiscard]] size_t size() const;
+
+    public:
+        static constexpr char PATH_SEPARATOR = '/';
+
+    private:
+        void onConstruct(entt::registry& registry, entt::entity id);
+
+        void onUpdate(entt::registry& registry, entt::entity id);
+
+        void onDestroy(entt::registry& registry, entt::entity id);
+
+        void erase(size_t hash, entt::entity id);
+
+    private:
+        std::unordered_multimap<size_t, entt::entity> entities;
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_NAMEINDEX_HPP
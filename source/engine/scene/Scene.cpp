@@ -1,23 +1,49 @@
 #include "Scene.hpp"
 
+#include <unordered_map>
+#include <algorithm>
+
 #include "engine/external/Json.hpp"
 #include "nameof.hpp"
 
 #include "Skybox.hpp"
-#include "engine/entity/Entity.hpp"
+#include "SceneFormat.hpp"
+#include "engine/entity/components/Name.hpp"
 #include "engine/files/File.hpp"
 #include "engine/files/FilesManager.hpp"
 #include "engine/assets/AssetsManager.hpp"
 #include "engine/entity/components/MeshRender.hpp"
 #include "engine/entity/components/Camera.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/components/WorldBounds.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
 
 
 namespace re {
 
-    Scene::Scene() = default;
+    namespace {
 
-    Scene::Scene(std::string fileName) : fileName(std::move(fileName)) {
+        enum BoundsState : uint8_t {
+            BOUNDS_UNCHANGED,
+            BOUNDS_CHANGED,
+            BOUNDS_DISABLED
+        };
+
+    } // namespace
+
+    Scene::Scene() {
+        registry.on_destroy<WorldBounds>().connect<&Scene::onBoundsDestroyed>(this);
+        registry.on_destroy<Hierarchy>().connect<&Scene::onHierarchyDestroyed>(this);
+        registry.set<std::shared_ptr<EntityCommandQueue>>(commandQueue);
+        nameIndex.connect(registry);
+    }
 
+    Scene::Scene(std::string fileName) : fileName(std::move(fileName)) {
+        registry.on_destroy<WorldBounds>().connect<&Scene::onBoundsDestroyed>(this);
+        registry.on_destroy<Hierarchy>().connect<&Scene::onHierarchyDestroyed>(this);
+        registry.set<std::shared_ptr<EntityCommandQueue>>(commandQueue);
+        nameIndex.connect(registry);
     }
 
     Scene::~Scene() = default;
@@ -25,54 +51,79 @@ namespace re {
     /**
      * Create a entity just with the name
      */
-    std::shared_ptr<Entity> Scene::addEntity(const std::string &name) {
-        std::shared_ptr<Entity> entity = std::make_shared<Entity>(name, registry.create(), this);
-        entities.push_back(entity);
+    EntityHandle Scene::addEntity(const std::string &name) {
+        EntityHandle entity(&registry, registry.create());
+        entity.setName(name);
         return entity;
     }
 
     /**
      * Create a entity and its components from JSON
      */
-    std::shared_ptr<Entity> Scene::addEntity(json &jsonEntity) {
-        std::shared_ptr<Entity> entity = std::make_shared<Entity>(jsonEntity, registry.create(), this);
-        entities.push_back(entity);
+    EntityHandle Scene::addEntity(json &jsonEntity) {
+        EntityHandle entity(&registry, registry.create());
+        entity.serialize(jsonEntity);
         return entity;
     }
 
     /**
      *
-     * @param name [Optional] If is no empty clean the current scene, set the new file and load it.
+     * @param name [Optional] If is no empty clean the current scene, set the new file and load it. Files with
+     * the SceneFormat extension are loaded as binary scenes, the others as JSON.
      */
     void Scene::load(const std::string& name) {
         if (!name.empty()) fileName = name;
 
         File file = files::getFile(fileName);
 
-        json scene;
-        file.read(scene);
+        if (SceneFormat::isBinary(fileName)) {
+            SceneFormat::read(registry, file.getPath());
+        } else {
+            json scene;
+            file.read(scene);
 
-        for (auto& entityJson : scene["entities"]) {
-            auto entity = addEntity(entityJson);
-        }
+            std::vector<EntityHandle> loaded;
+            for (auto& entityJson : scene["entities"]) {
+                loaded.push_back(addEntity(entityJson));
+            }
 
-        // TODO: Temporally solution. Need to find a better approach
-        while (true) {
-            auto view = registry.view<MeshRender>();
-            bool modelsLoaded = std::all_of(view.begin(), view.end(), [=, this](id_t id){
-                auto& meshRender = view.get<MeshRender>(id);
-                return meshRender.enable;
-            });
-            if (modelsLoaded) break;
+            // Parents are stored as the index of the parent entity in the file
+            for (size_t i = 0; i < loaded.size(); ++i) {
+                auto& entityJson = scene["entities"][i];
+                if (entityJson.contains("parent"))
+                    loaded[i].setParent(loaded[entityJson["parent"].get<uint32_t>()]);
+            }
         }
+
+        // Models are loaded in jobs and set through the command buffers. A model that fails to load leaves its
+        // MeshRender disabled.
+        jobs::wait();
+        playbackCommands();
     }
 
     void Scene::save() {
+        std::vector<EntityHandle> entities = getEntities();
+
+        if (SceneFormat::isBinary(fileName)) {
+            SceneFormat::write(registry, entities, files::getPath("data") / fileName);
+            return;
+        }
+
         json scene;
 
+        std::unordered_map<id_t, uint32_t> indices;
+        for (uint32_t i = 0; i < entities.size(); ++i)
+            indices[entities[i].getId()] = i;
+
         auto& sceneEntities = scene[std::string(NAMEOF(entities))] = {};
-        for (auto& entity : entities)
-            sceneEntities.push_back(entity->serialize());
+        for (auto& entity : entities) {
+            json entityJson = entity.serialize();
+
+            if (auto parent = entity.getParent(); parent && indices.contains(parent.getId()))
+                entityJson["parent"] = indices[parent.getId()];
+
+            sceneEntities.push_back(entityJson);
+        }
 
         File file(files::getPath("data") / fileName);
         file.write(scene);
@@ -82,20 +133,43 @@ namespace re {
         return registry;
     }
 
-    std::shared_ptr<Entity> Scene::getEntity(id_t id) {
-        return entities[static_cast<uint32_t>(id)];
+    /**
+     *
+     * @param id EnTT id
+     * @return Handle to the entity, null if the id is not alive
+     */
+    EntityHandle Scene::getEntity(id_t id) {
+        if (!registry.valid(id)) return {};
+
+        return {&registry, id};
+    }
+
+    /**
+     *
+     * @param name Entity name
+     * @return An entity with that name or a null handle. If the name isn't unique use getEntityByPath.
+     */
+    EntityHandle Scene::getEntity(const std::string &name) {
+        id_t id = nameIndex.find(registry, name);
+        if (id == entt::null) return {};
+
+        return {&registry, id};
     }
 
-    std::shared_ptr<Entity> Scene::getEntity(const std::string &name) {
-        for (auto& entity : entities) {
-            if (name == entity->getName()) return entity;
-        }
+    /**
+     *
+     * @param path Names from a root entity separated by '/', like "Root/Arm/Hand"
+     * @return Entity at the end of the path or a null handle
+     */
+    EntityHandle Scene::getEntityByPath(const std::string &path) {
+        id_t id = nameIndex.findPath(registry, path);
+        if (id == entt::null) return {};
 
-        return nullptr;
+        return {&registry, id};
     }
 
     void Scene::update() {
-        mainCamera->getComponent<Camera>().update();
+        mainCamera.getComponent<Camera>().update();
     }
 
     bool Scene::loaded() const {
@@ -110,11 +184,11 @@ namespace re {
         skybox = AssetsManager::getInstance()->loadSkybox(name, renderPass);
     }
 
-    void Scene::setMainCamera(std::shared_ptr<Entity> newCamera) {
-        mainCamera = std::move(newCamera);
+    void Scene::setMainCamera(EntityHandle newCamera) {
+        mainCamera = newCamera;
     }
 
-    std::shared_ptr<Entity> Scene::getMainCamera() const {
+    EntityHandle Scene::getMainCamera() const {
         return mainCamera;
     }
 
@@ -122,8 +196,117 @@ namespace re {
         fileName = name;
     }
 
-    std::vector<std::shared_ptr<Entity>> &Scene::getEntities() {
+    /**
+     *
+     * @return Named entities sorted by id. Entities without Name, like the editor camera, are not part of the
+     * saved scene.
+     */
+    std::vector<EntityHandle> Scene::getEntities() {
+        std::vector<EntityHandle> entities;
+
+        auto view = registry.view<Name>();
+        entities.reserve(view.size());
+        for (auto id : view)
+            entities.emplace_back(&registry, id);
+
+        std::sort(entities.begin(), entities.end(), [](const EntityHandle& a, const EntityHandle& b) {
+            return a.getId() < b.getId();
+        });
+
         return entities;
     }
 
+    /**
+     * @brief Recalculate the world matrices of the Transforms changed since the last call
+     */
+    void Scene::updateTransforms() {
+        transformSystem.update(registry);
+    }
+
+    /**
+     * @brief Refresh the WorldBounds of every entity with Transform and MeshRender and keep the spatial index
+     * in sync. Bounds are recalculated in parallel, the index is only touched for entities that moved out of
+     * their fat box, were enabled or were disabled.
+     */
+    void Scene::updateBounds() {
+        // Adding components isn't thread safe, so missing bounds are added before the parallel pass. Ids are
+        // collected first, the view can't be modified while iterating it.
+        auto missing = registry.view<Transform, MeshRender>(entt::exclude<WorldBounds>);
+        boundsEntities.assign(missing.begin(), missing.end());
+        for (auto id : boundsEntities)
+            EntityHandle(&registry, id).addComponent<WorldBounds>();
+
+        auto view = registry.view<Transform, MeshRender, WorldBounds>();
+
+        boundsEntities.assign(view.begin(), view.end());
+        boundsStates.resize(boundsEntities.size());
+
+        jobs::parallelFor(static_cast<uint32_t>(boundsEntities.size()), BOUNDS_CHUNK_SIZE, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                auto [transform, meshRender, bounds] = view.get<Transform, MeshRender, WorldBounds>(boundsEntities[i]);
+
+                if (!meshRender.enable || !meshRender.model)
+                    boundsStates[i] = BOUNDS_DISABLED;
+                else
+                    boundsStates[i] = bounds.update(transform, *meshRender.model) ? BOUNDS_CHANGED : BOUNDS_UNCHANGED;
+            }
+        });
+
+        for (size_t i = 0; i < boundsEntities.size(); ++i) {
+            id_t id = boundsEntities[i];
+
+            if (boundsStates[i] == BOUNDS_DISABLED) {
+                spatialIndex.remove(id);
+            } else if (boundsStates[i] == BOUNDS_CHANGED || !spatialIndex.contains(id)) {
+                auto& box = view.get<WorldBounds>(id).box;
+
+                if (box.empty())
+                    spatialIndex.remove(id);
+                else
+                    spatialIndex.update(id, box);
+            }
+        }
+    }
+
+    /**
+     *
+     * @return Dynamic AABB tree with the world bounds of the visible entities. Updated by updateBounds.
+     */
+    const DynamicTree& Scene::getSpatialIndex() const {
+        return spatialIndex;
+    }
+
+    /**
+     *
+     * @return Command buffer of the calling thread. Use it for structural changes from jobs and parallel systems.
+     */
+    EntityCommandBuffer& Scene::getCommands() {
+        return commandQueue->getBuffer();
+    }
+
+    /**
+     * @brief Apply the commands recorded by every thread. Must be called from the main thread while no system
+     * is accessing the registry.
+     */
+    void Scene::playbackCommands() {
+        commandQueue->playback(registry);
+    }
+
+    void Scene::onBoundsDestroyed(entt::registry&, id_t id) {
+        spatialIndex.remove(id);
+    }
+
+    /**
+     * @brief Unlink a destroyed entity from its parent and make its children roots, so no Hierarchy keeps its
+     * id. EntityCommandBuffer::destroy destroys the children first, this covers entities destroyed directly.
+     */
+    void Scene::onHierarchyDestroyed(entt::registry&, id_t id) {
+        EntityHandle entity(&registry, id);
+
+        while (auto child = entity.getFirstChild())
+            child.setParent({});
+
+        entity.setParent({});
+    }
+
 } // namespace re
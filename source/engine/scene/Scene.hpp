@@ -11,18 +11,19 @@
 #include "vulkan/vulkan.h"
 
 #include "engine/core/NonCopyable.hpp"
+#include "engine/entity/EntityHandle.hpp"
+#include "DynamicTree.hpp"
+#include "NameIndex.hpp"
+#include "EntityCommands.hpp"
+#include "TransformSystem.hpp"
 
 
 namespace re {
 
-    using id_t = entt::entity;
-
-    class Entity;
     class AssetsManager;
     class Skybox;
 
     class Scene : NonCopyable {
-        friend Entity;
         friend class RenderSystem;
 
     public:
@@ -32,9 +33,9 @@ namespace re {
 
         ~Scene() override;
 
-        std::shared_ptr<Entity> addEntity(const std::string& name);
+        EntityHandle addEntity(const std::string& name);
 
-        std::shared_ptr<Entity> addEntity(json& entity);
+        EntityHandle addEntity(json& entity);
 
         void load(const std::string& name = "");
 
@@ -44,9 +45,11 @@ namespace re {
 
         entt::registry& getRegistry();
 
-        std::shared_ptr<Entity> getEntity(id_t id);
+        EntityHandle getEntity(id_t id);
+
+        EntityHandle getEntity(const std::string& name);
 
-        std::shared_ptr<Entity> getEntity(const std::string& name);
+        EntityHandle getEntityByPath(const std::string& path);
 
         bool loaded() const;
 
@@ -54,21 +57,46 @@ namespace re {
 
         void loadSkybox(const std::string& name, VkRenderPass renderPass);
 
-        void setMainCamera(std::shared_ptr<Entity> newCamera);
+        void setMainCamera(EntityHandle newCamera);
 
-        std::shared_ptr<Entity> getMainCamera() const;
+        [[nodiscard]] EntityHandle getMainCamera() const;
 
         void setSceneFileName(const std::string& name);
 
-        std::vector<std::shared_ptr<Entity>>& getEntities();
+        std::vector<EntityHandle> getEntities();
+
+        void updateTransforms();
+
+        void updateBounds();
+
+        [[nodiscard]] const DynamicTree& getSpatialIndex() const;
+
+        EntityCommandBuffer& getCommands();
+
+        void playbackCommands();
+
+    public:
+        // Entities per bounds update job
+        static constexpr uint32_t BOUNDS_CHUNK_SIZE = 256;
+
+    private:
+        void onBoundsDestroyed(entt::registry& registry, id_t id);
+
+        void onHierarchyDestroyed(entt::registry& registry, id_t id);
 
     private:
         std::string fileName;
         entt::registry registry;
-        std::vector<std::shared_ptr<Entity>> entities;
         std::unique_ptr<Skybox> skybox;
-        std::shared_ptr<Entity> mainCamera;
+        EntityHandle mainCamera;
         bool wasLoaded{};
+        DynamicTree spatialIndex;
+        NameIndex nameIndex;
+        // Shared with the registry context, so jobs that outlive the Scene still record into a valid queue
+        std::shared_ptr<EntityCommandQueue> commandQueue{std::make_shared<EntityCommandQueue>()};
+        TransformSystem transformSystem;
+        std::vector<id_t> boundsEntities;
+        std::vector<uint8_t> boundsStates;
     };
 
 } // namespace re
@@ -0,0 +1,590 @@
+#include "SceneFormat.hpp"
+
+#include "nameof.hpp"
+
+#include "engine/core/Utils.hpp"
+#include "engine/files/File.hpp"
+#include "engine/entity/components/Name.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/components/MeshRender.hpp"
+#include "engine/entity/components/Camera.hpp"
+#include "engine/entity/components/Light.hpp"
+#include "engine/math/Vector3d.hpp"
+
+
+namespace re {
+
+    namespace {
+
+        struct BlockSchema {
+            uint32_t uintColumns;
+            uint32_t floatColumns;
+        };
+
+        // Columns written by this version, indexed by BlockType. Readers accept blocks with extra columns.
+        constexpr BlockSchema schemas[] = {
+            {1, 0},     // Name: string
+            {1, 0},     // Hierarchy: parent index
+            {0, 10},    // Transform: position xyz, rotation wxyz, scale xyz
+            {2, 0},     // MeshRender: model string, occluder
+            {0, 6},     // Camera: fov, zNear, zFar, target xyz
+            {0, 4},     // Light: color rgb, ambient
+            {0, 3},     // Transform precision: position remainder xyz
+            {0, 3}      // Camera precision: target remainder xyz
+        };
+
+        template<typename T>
+        void writeValue(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        void writeColumn(std::ofstream& file, const std::vector<T>& column) {
+            file.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+        }
+
+        template<typename T>
+        bool readValue(std::ifstream& file, T& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        template<typename T>
+        bool readColumn(std::ifstream& file, std::vector<T>& column, uint32_t count) {
+            column.resize(count);
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(count * sizeof(T))));
+        }
+
+        template<size_t N>
+        std::array<float, N> getFloats(const std::vector<std::vector<float>>& columns, uint32_t first, uint32_t row) {
+            std::array<float, N> values{};
+            for (uint32_t i = 0; i < N; ++i)
+                values[i] = columns[first + i][row];
+
+            return values;
+        }
+
+        /**
+         * @brief Split a double position into its float rounding and the float remainder, together they keep
+         * about 48 bits of the mantissa
+         * @return True if the remainder isn't zero
+         */
+        bool splitPosition(const Vector3d& position, std::array<float, 3>& rounded, std::array<float, 3>& remainder) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                rounded[i] = static_cast<float>(position[i]);
+                remainder[i] = static_cast<float>(position[i] - rounded[i]);
+            }
+
+            return remainder[0] != 0.0f || remainder[1] != 0.0f || remainder[2] != 0.0f;
+        }
+
+        template<typename Block>
+        void addRemainder(Block& block, uint32_t entity, const std::array<float, 3>& remainder) {
+            block.add(entity);
+            for (uint32_t column = 0; column < 3; ++column)
+                block.floats[column].push_back(remainder[column]);
+        }
+
+        template<typename T>
+        std::string componentName() {
+            return std::string(NAMEOF_SHORT_TYPE(T));
+        }
+
+    } // namespace
+
+    /**
+     *
+     * @param registry Registry that owns the entities
+     * @param entities Entities to save. Parents are stored as indices in this list.
+     * @param file Output file
+     */
+    void SceneFormat::write(entt::registry& registry, const std::vector<EntityHandle>& entities, const std::filesystem::path& file) {
+        Writer writer(static_cast<uint32_t>(entities.size()));
+
+        std::unordered_map<id_t, uint32_t> indices;
+        indices.reserve(entities.size());
+        for (uint32_t i = 0; i < entities.size(); ++i)
+            indices[entities[i].getId()] = i;
+
+        for (uint32_t i = 0; i < entities.size(); ++i) {
+            id_t id = entities[i].getId();
+
+            // Written for every entity, so the reader can bound the entity count with the file size
+            auto* name = registry.try_get<Name>(id);
+            auto& nameBlock = writer.getBlock(BLOCK_NAME);
+            nameBlock.add(i);
+            nameBlock.uints[0].push_back(writer.addString(name ? name->name : std::string()));
+
+            if (auto* hierarchy = registry.try_get<Hierarchy>(id); hierarchy && indices.contains(hierarchy->parent)) {
+                auto& block = writer.getBlock(BLOCK_HIERARCHY);
+                block.add(i);
+                block.uints[0].push_back(indices[hierarchy->parent]);
+            }
+
+            if (auto* transform = registry.try_get<Transform>(id)) {
+                auto& block = writer.getBlock(BLOCK_TRANSFORM);
+                block.add(i);
+
+                std::array<float, 3> position{}, remainder{};
+                if (splitPosition(transform->getPosition(), position, remainder))
+                    addRemainder(writer.getBlock(BLOCK_TRANSFORM_PRECISION), i, remainder);
+
+                const float values[] = {
+                    position[0], position[1], position[2],
+                    transform->getRotation().w, transform->getRotation().x, transform->getRotation().y, transform->getRotation().z,
+                    transform->getScale().x, transform->getScale().y, transform->getScale().z
+                };
+                for (uint32_t column = 0; column < 10; ++column)
+                    block.floats[column].push_back(values[column]);
+            }
+
+            if (auto* meshRender = registry.try_get<MeshRender>(id); meshRender && meshRender->model) {
+                auto& block = writer.getBlock(BLOCK_MESH_RENDER);
+                block.add(i);
+                block.uints[0].push_back(writer.addString(meshRender->model->getName()));
+                block.uints[1].push_back(meshRender->occluder);
+            }
+
+            if (auto* camera = registry.try_get<Camera>(id)) {
+                auto& block = writer.getBlock(BLOCK_CAMERA);
+                block.add(i);
+
+                std::array<float, 3> target{}, remainder{};
+                if (splitPosition(camera->target, target, remainder))
+                    addRemainder(writer.getBlock(BLOCK_CAMERA_PRECISION), i, remainder);
+
+                const float values[] = {camera->fov, camera->zNear, camera->zFar, target[0], target[1], target[2]};
+                for (uint32_t column = 0; column < 6; ++column)
+                    block.floats[column].push_back(values[column]);
+            }
+
+            if (auto* light = registry.try_get<Light>(id)) {
+                auto& block = writer.getBlock(BLOCK_LIGHT);
+                block.add(i);
+
+                const float values[] = {light->color.x, light->color.y, light->color.z, light->ambient};
+                for (uint32_t column = 0; column < 4; ++column)
+                    block.floats[column].push_back(values[column]);
+            }
+        }
+
+        writer.save(file);
+    }
+
+    /**
+     * @brief Create the entities of the file and emplace their components block by block. Only one block is
+     * kept in memory at a time.
+     * @param registry Registry where the entities are created
+     * @param file Binary scene file
+     * @return Created entities, in file order
+     */
+    std::vector<EntityHandle> SceneFormat::read(entt::registry& registry, const std::filesystem::path& file) {
+        Reader reader(file);
+
+        std::vector<id_t> ids(reader.getEntityCount());
+        registry.create(ids.begin(), ids.end());
+
+        std::vector<EntityHandle> entities;
+        entities.reserve(ids.size());
+        for (auto id : ids)
+            entities.emplace_back(&registry, id);
+
+        Block block;
+        while (reader.nextBlock(block))
+            applyBlock(reader, block, registry, entities);
+
+        return entities;
+    }
+
+    /**
+     *
+     * @param jsonFile Scene saved by Scene::save in JSON
+     * @param binaryFile Output binary scene
+     */
+    void SceneFormat::convertToBinary(const std::filesystem::path& jsonFile, const std::filesystem::path& binaryFile) {
+        json scene;
+        File(jsonFile).read(scene);
+
+        auto& entities = scene["entities"];
+        Writer writer(static_cast<uint32_t>(entities.size()));
+
+        for (uint32_t i = 0; i < entities.size(); ++i) {
+            auto& entity = entities[i];
+
+            if (entity.contains("name")) {
+                auto& block = writer.getBlock(BLOCK_NAME);
+                block.add(i);
+                block.uints[0].push_back(writer.addString(entity["name"].get<std::string>()));
+            }
+
+            if (entity.contains("parent")) {
+                auto& block = writer.getBlock(BLOCK_HIERARCHY);
+                block.add(i);
+                block.uints[0].push_back(entity["parent"].get<uint32_t>());
+            }
+
+            if (auto& transform = entity[componentName<Transform>()]; !transform.empty()) {
+                auto& block = writer.getBlock(BLOCK_TRANSFORM);
+                block.add(i);
+
+                std::array<float, 3> position{}, remainder{};
+                if (splitPosition(Vector3d(transform["position"].get<std::array<double, 3>>().data()), position, remainder))
+                    addRemainder(writer.getBlock(BLOCK_TRANSFORM_PRECISION), i, remainder);
+
+                auto rotation = transform["rotation"].get<std::array<float, 4>>();
+                auto scale = transform["scale"].get<std::array<float, 3>>();
+                for (uint32_t column = 0; column < 3; ++column) block.floats[column].push_back(position[column]);
+                for (uint32_t column = 0; column < 4; ++column) block.floats[3 + column].push_back(rotation[column]);
+                for (uint32_t column = 0; column < 3; ++column) block.floats[7 + column].push_back(scale[column]);
+            }
+
+            if (auto& meshRender = entity[componentName<MeshRender>()]; !meshRender.empty()) {
+                auto& block = writer.getBlock(BLOCK_MESH_RENDER);
+                block.add(i);
+                block.uints[0].push_back(writer.addString(meshRender["name"].get<std::string>()));
+                block.uints[1].push_back(meshRender.value("occluder", false));
+            }
+
+            if (auto& camera = entity[componentName<Camera>()]; !camera.empty()) {
+                auto& block = writer.getBlock(BLOCK_CAMERA);
+                block.add(i);
+
+                std::array<float, 3> target{}, remainder{};
+                if (splitPosition(Vector3d(camera["target"].get<std::array<double, 3>>().data()), target, remainder))
+                    addRemainder(writer.getBlock(BLOCK_CAMERA_PRECISION), i, remainder);
+
+                const float values[] = {camera["fov"].get<float>(), camera["zNear"].get<float>(), camera["zFar"].get<float>(), target[0], target[1], target[2]};
+                for (uint32_t column = 0; column < 6; ++column)
+                    block.floats[column].push_back(values[column]);
+            }
+
+            if (auto& light = entity[componentName<Light>()]; !light.empty()) {
+                auto& block = writer.getBlock(BLOCK_LIGHT);
+                block.add(i);
+
+                auto color = light["color"].get<std::array<float, 3>>();
+                const float values[] = {color[0], color[1], color[2], light["ambient"].get<float>()};
+                for (uint32_t column = 0; column < 4; ++column)
+                    block.floats[column].push_back(values[column]);
+            }
+        }
+
+        writer.save(binaryFile);
+    }
+
+    /**
+     *
+     * @param binaryFile Binary scene
+     * @param jsonFile Output scene in the format of Scene::save
+     */
+    void SceneFormat::convertToJson(const std::filesystem::path& binaryFile, const std::filesystem::path& jsonFile) {
+        Reader reader(binaryFile);
+
+        json scene;
+        auto& entities = scene["entities"] = json::array();
+        for (uint32_t i = 0; i < reader.getEntityCount(); ++i)
+            entities.push_back(json::object());
+
+        Block block;
+        while (reader.nextBlock(block))
+            applyBlock(reader, block, entities);
+
+        File(jsonFile).write(scene);
+    }
+
+    /**
+     *
+     * @return True if the file has the binary scene extension
+     */
+    bool SceneFormat::isBinary(const std::filesystem::path& file) {
+        return file.extension() == EXTENSION;
+    }
+
+    void SceneFormat::Block::reset(BlockType blockType) {
+        type = blockType;
+        entities.clear();
+        uints.resize(schemas[type].uintColumns);
+        floats.resize(schemas[type].floatColumns);
+
+        for (auto& column : uints) column.clear();
+        for (auto& column : floats) column.clear();
+    }
+
+    void SceneFormat::Block::add(uint32_t entity) {
+        entities.push_back(entity);
+    }
+
+    SceneFormat::Writer::Writer(uint32_t entityCount) : entityCount(entityCount), blocks(BLOCK_COUNT) {
+        for (uint32_t type = 0; type < BLOCK_COUNT; ++type)
+            blocks[type].reset(static_cast<BlockType>(type));
+    }
+
+    /**
+     *
+     * @return Index of the string in the string table, equal strings are stored once
+     */
+    uint32_t SceneFormat::Writer::addString(const std::string& string) {
+        auto [it, inserted] = stringIndices.try_emplace(string, static_cast<uint32_t>(strings.size()));
+        if (inserted) strings.push_back(string);
+
+        return it->second;
+    }
+
+    SceneFormat::Block& SceneFormat::Writer::getBlock(BlockType type) {
+        return blocks[type];
+    }
+
+    void SceneFormat::Writer::save(const std::filesystem::path& file) {
+        std::ofstream output(file, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) throwEx("Failed to open file: " + file.string());
+
+        uint32_t blockCount = 0;
+        for (auto& block : blocks) {
+            if (!block.entities.empty()) blockCount++;
+        }
+
+        writeValue(output, Header{MAGIC, VERSION, entityCount, static_cast<uint32_t>(strings.size()), blockCount});
+
+        for (auto& string : strings)
+            writeValue(output, static_cast<uint32_t>(string.size()));
+        for (auto& string : strings)
+            output.write(string.data(), static_cast<std::streamsize>(string.size()));
+
+        for (auto& block : blocks) {
+            if (block.entities.empty()) continue;
+
+            auto count = static_cast<uint32_t>(block.entities.size());
+            auto uintColumns = static_cast<uint32_t>(block.uints.size());
+            auto floatColumns = static_cast<uint32_t>(block.floats.size());
+            uint64_t size = sizeof(uint32_t) * static_cast<uint64_t>(count) * (1 + uintColumns + floatColumns);
+
+            writeValue(output, BlockHeader{block.type, count, uintColumns, floatColumns, size});
+            writeColumn(output, block.entities);
+            for (auto& column : block.uints) writeColumn(output, column);
+            for (auto& column : block.floats) writeColumn(output, column);
+        }
+
+        if (!output) throwEx("Failed to write scene: " + file.string());
+    }
+
+    /**
+     * @brief Open the file and read the header and the string table. Blocks are read on demand. Counts and
+     * lengths read from the file are checked against its size before allocating for them.
+     */
+    SceneFormat::Reader::Reader(const std::filesystem::path& file) : path(file), input(file, std::ios::binary) {
+        if (!input.is_open()) throwEx("Failed to open file: " + file.string());
+        fileSize = std::filesystem::file_size(file);
+
+        if (!readValue(input, header) || header.magic != MAGIC)
+            throwEx(fmt::format("{} is not a binary scene", file.string()));
+
+        if (header.version > VERSION)
+            throwEx(fmt::format("{} has scene version {}, the newest supported is {}", file.string(), header.version, VERSION));
+
+        // Each entity takes at least its 4 byte index in the Name block
+        if (header.entityCount > MAX_ENTITIES || uint64_t{header.entityCount} * sizeof(uint32_t) > remaining())
+            throwEx(fmt::format("{} has {} entities, more than the file can hold", file.string(), header.entityCount));
+
+        std::vector<uint32_t> lengths;
+        if (uint64_t{header.stringCount} * sizeof(uint32_t) > remaining() || !readColumn(input, lengths, header.stringCount))
+            throwEx("Truncated scene string table: " + file.string());
+
+        strings.resize(header.stringCount);
+        for (uint32_t i = 0; i < header.stringCount; ++i) {
+            if (lengths[i] > remaining()) throwEx("Truncated scene string table: " + file.string());
+
+            strings[i].resize(lengths[i]);
+            if (!input.read(strings[i].data(), lengths[i])) throwEx("Truncated scene string table: " + file.string());
+        }
+    }
+
+    /**
+     * @brief Read the next known block. Unknown blocks, written by newer versions, are skipped.
+     * @return False when there are no more blocks
+     */
+    bool SceneFormat::Reader::nextBlock(Block& block) {
+        while (blocksRead < header.blockCount) {
+            blocksRead++;
+
+            BlockHeader blockHeader{};
+            if (!readValue(input, blockHeader)) throwEx("Truncated scene block: " + path.string());
+
+            if (blockHeader.type >= BLOCK_COUNT) {
+                input.seekg(static_cast<std::streamoff>(blockHeader.size), std::ios::cur);
+                continue;
+            }
+
+            auto type = static_cast<BlockType>(blockHeader.type);
+            if (blockHeader.uintColumns < schemas[type].uintColumns || blockHeader.floatColumns < schemas[type].floatColumns)
+                throwEx(fmt::format("Scene block {} has missing columns: {}", blockHeader.type, path.string()));
+
+            // Entities and every column are 4 byte values
+            uint64_t columns = 1 + uint64_t{blockHeader.uintColumns} + blockHeader.floatColumns;
+            if (uint64_t{blockHeader.count} * columns * sizeof(uint32_t) > remaining())
+                throwEx("Truncated scene block: " + path.string());
+
+            block.reset(type);
+            bool valid = readColumn(input, block.entities, blockHeader.count);
+
+            std::vector<uint32_t> ignored;
+            for (uint32_t i = 0; i < blockHeader.uintColumns; ++i)
+                valid = valid && readColumn(input, i < block.uints.size() ? block.uints[i] : ignored, blockHeader.count);
+
+            std::vector<float> ignoredFloats;
+            for (uint32_t i = 0; i < blockHeader.floatColumns; ++i)
+                valid = valid && readColumn(input, i < block.floats.size() ? block.floats[i] : ignoredFloats, blockHeader.count);
+
+            if (!valid) throwEx("Truncated scene block: " + path.string());
+
+            for (auto entity : block.entities) {
+                if (entity >= header.entityCount) throwEx("Scene block entity out of range: " + path.string());
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     *
+     * @return Bytes of the file after the read position
+     */
+    uint64_t SceneFormat::Reader::remaining() {
+        auto position = static_cast<uint64_t>(input.tellg());
+        return position < fileSize ? fileSize - position : 0;
+    }
+
+    uint32_t SceneFormat::Reader::getEntityCount() const {
+        return header.entityCount;
+    }
+
+    const std::string& SceneFormat::Reader::getString(uint32_t index) const {
+        if (index >= strings.size()) throwEx("Scene string index out of range: " + path.string());
+
+        return strings[index];
+    }
+
+    void SceneFormat::applyBlock(const Reader& reader, const Block& block, entt::registry& registry, const std::vector<EntityHandle>& entities) {
+        auto count = static_cast<uint32_t>(block.entities.size());
+
+        switch (block.type) {
+            case BLOCK_NAME:
+                registry.reserve<Name>(count);
+                for (uint32_t i = 0; i < count; ++i)
+                    entities[block.entities[i]].addComponent<Name>(reader.getString(block.uints[0][i]));
+                break;
+            case BLOCK_HIERARCHY:
+                for (uint32_t i = 0; i < count; ++i) {
+                    uint32_t parent = block.uints[0][i];
+                    if (parent < entities.size()) entities[block.entities[i]].setParent(entities[parent]);
+                }
+                break;
+            case BLOCK_TRANSFORM:
+                registry.reserve<Transform>(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    auto position = getFloats<3>(block.floats, 0, i);
+                    auto rotation = getFloats<4>(block.floats, 3, i);
+                    auto scale = getFloats<3>(block.floats, 7, i);
+                    entities[block.entities[i]].addComponent<Transform>(vec3(position.data()), vec3(scale.data()), quat(rotation.data()));
+                }
+                break;
+            case BLOCK_MESH_RENDER:
+                registry.reserve<MeshRender>(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    auto& meshRender = entities[block.entities[i]].addComponent<MeshRender>(reader.getString(block.uints[0][i]));
+                    meshRender.occluder = block.uints[1][i] != 0;
+                }
+                break;
+            case BLOCK_CAMERA:
+                for (uint32_t i = 0; i < count; ++i) {
+                    auto values = getFloats<6>(block.floats, 0, i);
+                    entities[block.entities[i]].addComponent<Camera>(values[0], values[1], values[2], Vector3(values.data() + 3));
+                }
+                break;
+            case BLOCK_LIGHT:
+                for (uint32_t i = 0; i < count; ++i) {
+                    auto values = getFloats<4>(block.floats, 0, i);
+                    entities[block.entities[i]].addComponent<Light>(vec3(values.data()), values[3]);
+                }
+                break;
+            // Rows of entities without the component only come from malformed files, they're skipped
+            case BLOCK_TRANSFORM_PRECISION:
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (auto* transform = entities[block.entities[i]].tryGetComponent<Transform>())
+                        transform->setPosition(transform->getPosition() + Vector3(getFloats<3>(block.floats, 0, i).data()));
+                }
+                break;
+            case BLOCK_CAMERA_PRECISION:
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (auto* camera = entities[block.entities[i]].tryGetComponent<Camera>())
+                        camera->target += Vector3(getFloats<3>(block.floats, 0, i).data());
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    void SceneFormat::applyBlock(const Reader& reader, const Block& block, json& entities) {
+        auto count = static_cast<uint32_t>(block.entities.size());
+
+        for (uint32_t i = 0; i < count; ++i) {
+            auto& entity = entities[block.entities[i]];
+
+            switch (block.type) {
+                case BLOCK_NAME:
+                    entity["name"] = reader.getString(block.uints[0][i]);
+                    break;
+                case BLOCK_HIERARCHY:
+                    entity["parent"] = block.uints[0][i];
+                    break;
+                case BLOCK_TRANSFORM:
+                    entity[componentName<Transform>()] = {
+                        {"position", getFloats<3>(block.floats, 0, i)},
+                        {"rotation", getFloats<4>(block.floats, 3, i)},
+                        {"scale", getFloats<3>(block.floats, 7, i)}
+                    };
+                    break;
+                case BLOCK_MESH_RENDER:
+                    entity[componentName<MeshRender>()] = {
+                        {"name", reader.getString(block.uints[0][i])},
+                        {"occluder", block.uints[1][i] != 0}
+                    };
+                    break;
+                case BLOCK_CAMERA: {
+                    auto values = getFloats<6>(block.floats, 0, i);
+                    entity[componentName<Camera>()] = {
+                        {"fov", values[0]},
+                        {"zNear", values[1]},
+                        {"zFar", values[2]},
+                        {"target", {values[3], values[4], values[5]}}
+                    };
+                    break;
+                }
+                case BLOCK_LIGHT: {
+                    auto values = getFloats<4>(block.floats, 0, i);
+                    entity[componentName<Light>()] = {
+                        {"color", {values[0], values[1], values[2]}},
+                        {"ambient", values[3]}
+                    };
+                    break;
+                }
+                case BLOCK_TRANSFORM_PRECISION:
+                case BLOCK_CAMERA_PRECISION: {
+                    const std::string component = block.type == BLOCK_TRANSFORM_PRECISION ? componentName<Transform>() : componentName<Camera>();
+                    if (!entity.contains(component)) break;
+
+                    auto remainder = getFloats<3>(block.floats, 0, i);
+                    auto& position = entity[component][block.type == BLOCK_TRANSFORM_PRECISION ? "position" : "target"];
+                    for (uint32_t k = 0; k < 3; ++k)
+                        position[k] = position[k].get<double>() + remainder[k];
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+} // namespace re
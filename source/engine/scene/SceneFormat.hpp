@@ -0,0 +1,141 @@
+#ifndef RAVENENGINE_SCENEFORMAT_HPP
+#define RAVENENGINE_SCENEFORMAT_HPP
+
+
+#include <vector>
+#include <array>
+#include <string>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#include "entt/entt.hpp"
+
+#include "engine/external/Json.hpp"
+#include "engine/entity/EntityHandle.hpp"
+
+
+namespace re {
+
+    /**
+     * @brief Binary scene file. It starts with a header and a string table, followed by one block per
+     * component type. A block stores the index of its entities and then one column per field, so loading a
+     * block is a sequence of contiguous reads and every component of a type is emplaced in one pass.
+     *
+     * Layout: Header | string lengths | string bytes | (BlockHeader | entities | uint columns | float columns)*
+     *
+     * Every entity has a row in the Name block, unnamed entities are stored with an empty name.
+     *
+     * Double positions are stored as their float rounding in the component block, plus the remainder in a
+     * precision block written only for the entities that need it. Precision blocks come after the component
+     * blocks, and readers that don't know them skip them and load the rounded positions.
+     */
+    class SceneFormat {
+    public:
+        static constexpr uint32_t MAGIC = 0x43534552; // "RESC"
+        static constexpr uint32_t VERSION = 1;
+        static constexpr const char* EXTENSION = ".rscene";
+        // Files with more entities are rejected before the registry allocates them
+        static constexpr uint32_t MAX_ENTITIES = 1u << 24;
+
+        enum BlockType : uint32_t {
+            BLOCK_NAME,
+            BLOCK_HIERARCHY,
+            BLOCK_TRANSFORM,
+            BLOCK_MESH_RENDER,
+            BLOCK_CAMERA,
+            BLOCK_LIGHT,
+            BLOCK_TRANSFORM_PRECISION,
+            BLOCK_CAMERA_PRECISION,
+            BLOCK_COUNT
+        };
+
+    public:
+        static void write(entt::registry& registry, const std::vector<EntityHandle>& entities, const std::filesystem::path& file);
+
+        static std::vector<EntityHandle> read(entt::registry& registry, const std::filesystem::path& file);
+
+        static void convertToBinary(const std::filesystem::path& jsonFile, const std::filesystem::path& binaryFile);
+
+        static void convertToJson(const std::filesystem::path& binaryFile, const std::filesystem::path& jsonFile);
+
+        static bool isBinary(const std::filesystem::path& file);
+
+    private:
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entityCount;
+            uint32_t stringCount;
+            uint32_t blockCount;
+        };
+
+        struct BlockHeader {
+            uint32_t type;
+            uint32_t count;
+            uint32_t uintColumns;
+            uint32_t floatColumns;
+            // Bytes after the header, used to skip unknown blocks
+            uint64_t size;
+        };
+
+        // Decoded block, columns have one value per entity
+        struct Block {
+            BlockType type{};
+            std::vector<uint32_t> entities;
+            std::vector<std::vector<uint32_t>> uints;
+            std::vector<std::vector<float>> floats;
+
+            void reset(BlockType blockType);
+
+            void add(uint32_t entity);
+        };
+
+        class Writer {
+        public:
+            explicit Writer(uint32_t entityCount);
+
+            uint32_t addString(const std::string& string);
+
+            Block& getBlock(BlockType type);
+
+            void save(const std::filesystem::path& file);
+
+        private:
+            uint32_t entityCount;
+            std::vector<std::string> strings;
+            std::unordered_map<std::string, uint32_t> stringIndices;
+            std::vector<Block> blocks;
+        };
+
+        class Reader {
+        public:
+            explicit Reader(const std::filesystem::path& file);
+
+            bool nextBlock(Block& block);
+
+            [[nodiscard]] uint32_t getEntityCount() const;
+
+            [[nodiscard]] const std::string& getString(uint32_t index) const;
+
+        private:
+            uint64_t remaining();
+
+        private:
+            std::filesystem::path path;
+            std::ifstream input;
+            uint64_t fileSize{};
+            Header header{};
+            uint32_t blocksRead{};
+            std::vector<std::string> strings;
+        };
+
+        static void applyBlock(const Reader& reader, const Block& block, entt::registry& registry, const std::vector<EntityHandle>& entities);
+
+        static void applyBlock(const Reader& reader, const Block& block, json& entities);
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_SCENEFORMAT_HPP
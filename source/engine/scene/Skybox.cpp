@@ -22,10 +22,9 @@ namespace re {
         GraphicsPipeline::defaultConfigInfo(configInfo, renderPass);
         pipeline = std::make_unique<GraphicsPipeline>(
                 this->device->getDevice(),
+                this->device->getPipelineCache(),
                 "skybox.vert", "skybox.frag",
-                configInfo,
-                std::vector<VkDescriptorSetLayout>{AssetsManager::getInstance()->getDescriptorSetLayout(UBO), AssetsManager::getInstance()->getDescriptorSetLayout(TEXTURE)},
-                std::vector<VkPushConstantRange>{}
+                configInfo
         );
     }
 
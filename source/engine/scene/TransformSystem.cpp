@@ -0,0 +1,160 @@
+#include "TransformSystem.hpp"
+
+#include "engine/entity/components/Transform.hpp"
+#include "engine/entity/components/Hierarchy.hpp"
+#include "engine/jobSystem/JobSystem.hpp"
+#include "engine/math/Batch.hpp"
+
+
+namespace re {
+
+    namespace {
+
+        /**
+         * @brief Local values of the dirty Transforms of one chunk, gathered for the batch kernels
+         */
+        struct ChunkLocals {
+            float positionX[TransformSystem::CHUNK_SIZE];
+            float positionY[TransformSystem::CHUNK_SIZE];
+            float positionZ[TransformSystem::CHUNK_SIZE];
+            float rotationW[TransformSystem::CHUNK_SIZE];
+            float rotationX[TransformSystem::CHUNK_SIZE];
+            float rotationY[TransformSystem::CHUNK_SIZE];
+            float rotationZ[TransformSystem::CHUNK_SIZE];
+            float scaleX[TransformSystem::CHUNK_SIZE];
+            float scaleY[TransformSystem::CHUNK_SIZE];
+            float scaleZ[TransformSystem::CHUNK_SIZE];
+            Matrix4 matrices[TransformSystem::CHUNK_SIZE];
+            Matrix4 inverses[TransformSystem::CHUNK_SIZE];
+
+            [[nodiscard]] math::TransformArrays arrays() const {
+                return {positionX, positionY, positionZ, rotationW, rotationX, rotationY, rotationZ, scaleX, scaleY, scaleZ};
+            }
+        };
+
+    } // namespace
+
+    TransformSystem::TransformSystem() = default;
+
+    TransformSystem::~TransformSystem() = default;
+
+    /**
+     * @brief Collect the subtrees of the dirty Transforms by depth and recalculate their world matrices. Clean
+     * subtrees are not visited.
+     * @param registry Registry with Transform and Hierarchy components
+     */
+    void TransformSystem::update(entt::registry& registry) {
+        // Levels keep their capacity between frames
+        for (auto& level : levels) level.clear();
+        updatedCount = 0;
+
+        auto view = registry.view<Transform>();
+        for (auto id : view) {
+            auto& transform = view.get<Transform>(id);
+            if (transform.dirty && !transform.queued) enqueue(registry, id);
+        }
+
+        for (auto& level : levels) {
+            if (level.empty()) continue;
+
+            jobs::parallelFor(static_cast<uint32_t>(level.size()), CHUNK_SIZE, [&](uint32_t begin, uint32_t end) {
+                updateLocals(registry, level.data() + begin, end - begin);
+
+                for (uint32_t i = begin; i < end; ++i) {
+                    auto& transform = view.get<Transform>(level[i]);
+                    const Transform* parent = nullptr;
+
+                    if (auto* hierarchy = registry.try_get<Hierarchy>(level[i]); hierarchy && hierarchy->parent != entt::null)
+                        parent = registry.try_get<Transform>(hierarchy->parent);
+
+                    transform.updateWorld(parent);
+                    transform.queued = false;
+                }
+            });
+
+            updatedCount += static_cast<uint32_t>(level.size());
+        }
+    }
+
+    /**
+     *
+     * @return Number of world matrices recalculated in the last update
+     */
+    uint32_t TransformSystem::getUpdatedCount() const {
+        return updatedCount;
+    }
+
+    /**
+     * @brief Rebuild the local matrices of the dirty Transforms of a chunk with the batch kernels, so
+     * Transform::updateWorld only multiplies by the parent matrices. The float translations of far roots are
+     * rounded here, updateWorld keeps their exact world position.
+     * @param ids Chunk entities, at most CHUNK_SIZE
+     */
+    void TransformSystem::updateLocals(entt::registry& registry, const entt::entity* ids, uint32_t count) {
+        ChunkLocals locals;
+        Transform* dirty[CHUNK_SIZE];
+        uint32_t dirtyCount = 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            auto& transform = registry.get<Transform>(ids[i]);
+            if (!transform.dirty) continue;
+
+            uint32_t n = dirtyCount++;
+            dirty[n] = &transform;
+            locals.positionX[n] = static_cast<float>(transform.position.x);
+            locals.positionY[n] = static_cast<float>(transform.position.y);
+            locals.positionZ[n] = static_cast<float>(transform.position.z);
+            locals.rotationW[n] = transform.rotation.w;
+            locals.rotationX[n] = transform.rotation.x;
+            locals.rotationY[n] = transform.rotation.y;
+            locals.rotationZ[n] = transform.rotation.z;
+            locals.scaleX[n] = transform.scale.x;
+            locals.scaleY[n] = transform.scale.y;
+            locals.scaleZ[n] = transform.scale.z;
+        }
+
+        if (dirtyCount == 0) return;
+
+        math::compose(locals.arrays(), dirtyCount, locals.matrices);
+        math::composeInverse(locals.arrays(), dirtyCount, locals.inverses);
+
+        for (uint32_t n = 0; n < dirtyCount; ++n) {
+            dirty[n]->localMatrix = locals.matrices[n];
+            dirty[n]->invLocalMatrix = locals.inverses[n];
+            dirty[n]->dirty = false;
+        }
+    }
+
+    /**
+     * @brief Add root and all its descendants to the level of their depth. Subtrees already queued by a dirty
+     * ancestor are skipped.
+     */
+    void TransformSystem::enqueue(entt::registry& registry, entt::entity root) {
+        stack.clear();
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            entt::entity id = stack.back();
+            stack.pop_back();
+
+            auto* transform = registry.try_get<Transform>(id);
+            if (transform && transform->queued) continue;
+
+            auto* hierarchy = registry.try_get<Hierarchy>(id);
+
+            if (transform) {
+                uint32_t depth = hierarchy ? hierarchy->depth : 0;
+                if (levels.size() <= depth) levels.resize(depth + 1);
+
+                levels[depth].push_back(id);
+                transform->queued = true;
+            }
+
+            if (!hierarchy) continue;
+
+            for (auto child = hierarchy->firstChild; child != entt::null; child = registry.get<Hierarchy>(child).nextSibling)
+                stack.push_back(child);
+        }
+    }
+
+} // namespace re
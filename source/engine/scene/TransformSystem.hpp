@@ -0,0 +1,49 @@
+#ifndef RAVENENGINE_TRANSFORMSYSTEM_HPP
+#define RAVENENGINE_TRANSFORMSYSTEM_HPP
+
+
+#include <vector>
+
+#include "entt/entt.hpp"
+
+#include "engine/core/NonCopyable.hpp"
+
+
+namespace re {
+
+    class Transform;
+
+    /**
+     * @brief Update the cached world matrices of the dirty Transforms and their descendants. Entities are
+     * grouped by hierarchy depth and each depth is updated in parallel, after its parents depth is done.
+     * Local matrices of each chunk are rebuilt together with the math batch kernels.
+     */
+    class TransformSystem : NonCopyable {
+    public:
+        TransformSystem();
+
+        ~TransformSystem() override;
+
+        void update(entt::registry& registry);
+
+        [[nodiscard]] uint32_t getUpdatedCount() const;
+
+    public:
+        // Transforms per job
+        static constexpr uint32_t CHUNK_SIZE = 128;
+
+    private:
+        void updateLocals(entt::registry& registry, const entt::entity* ids, uint32_t count);
+
+        void enqueue(entt::registry& registry, entt::entity root);
+
+    private:
+        std::vector<std::vector<entt::entity>> levels;
+        std::vector<entt::entity> stack;
+        uint32_t updatedCount{};
+    };
+
+} // namespace re
+
+
+#endif //RAVENENGINE_TRANSFORMSYSTEM_HPP